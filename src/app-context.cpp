@@ -2,19 +2,50 @@
 
 #include <glibmm/i18n.h>
 #include <spdlog/spdlog.h>
+#include <utils.h>
 #include <window.h>
 
+#include <algorithm>
 #include <numeric>
 
 #include "core/board.h"
 #include "core/colorable.h"
 #include "glibmm/main.h"
+#include "widgets/card-filter-popover.h"
 #include "widgets/card-widget.h"
 #include "widgets/cardlist-widget.h"
 #include "widgets/task-widget.h"
 
+namespace {
+size_t count_widgets(const Gtk::Widget& widget) {
+    size_t n_widgets = 1;
+    for (const Gtk::Widget* child = widget.get_first_child(); child;
+         child = child->get_next_sibling()) {
+        n_widgets += count_widgets(*child);
+    }
+    return n_widgets;
+}
+
+// Seconds left until the local midnight starting the given day, rounded up
+gint64 seconds_until(const Date& day) {
+    const Glib::DateTime midnight = Glib::DateTime::create_local(
+        int(day.year()), unsigned(day.month()), unsigned(day.day()), 0, 0, 0);
+    return midnight.difference(Glib::DateTime::create_now_local()) /
+               G_TIME_SPAN_SECOND +
+           1;
+}
+}  // namespace
+
 ui::CardWidget* AppContext::builder_card_widget(
     const std::shared_ptr<Card>& card) {
+    ui::CardWidget* card_widget = Gtk::make_managed<ui::CardWidget>("");
+    refresh_card_widget(card, card_widget);
+
+    return card_widget;
+}
+
+void AppContext::refresh_card_widget(const std::shared_ptr<Card>& card,
+                                     ui::CardWidget* card_w) {
     Gdk::RGBA card_color =
         Gdk::RGBA{static_cast<float>(std::get<0>(card->get_color()) / 255.0),
                   static_cast<float>(std::get<1>(card->get_color()) / 255.0),
@@ -34,18 +65,21 @@ ui::CardWidget* AppContext::builder_card_widget(
                             return task->get_done() ? ++acc : acc;
                         });
 
-    ui::CardWidget* card_widget = Gtk::make_managed<ui::CardWidget>(
-        card->get_name(), card_color, card_deadline, card->get_complete(),
-        !card->get_notes().empty(), card->container().size(), n_complete_tasks);
-
-    return card_widget;
+    card_w->reset(card->get_name(), card_color, card_deadline,
+                  card->get_complete(), !card->get_notes().empty(),
+                  card->container().size(), n_complete_tasks);
 }
 
 AppContext::AppContext(ui::ProgressWindow& app_window,
                        ui::BoardWidget& board_widget, BoardManager& manager)
     : m_app_window(app_window),
       m_board_widget(board_widget),
-      m_manager(manager) {
+      m_manager(manager),
+      m_card_pool{[]() { return new ui::CardWidget(""); }, POOLED_CARDS},
+      m_cardlist_pool{[&board_widget]() {
+                          return new ui::CardlistWidget(board_widget, "");
+                      },
+                      POOLED_CARDLISTS} {
     m_app_window.signal_close_request().connect(
         sigc::mem_fun(*this, &AppContext::on_window_closed), true);
     m_load_board_dispatcher.connect(
@@ -54,7 +88,7 @@ AppContext::AppContext(ui::ProgressWindow& app_window,
         sigc::mem_fun(*this, &AppContext::on_session_saved));
 
     m_manager.signal_add_board().connect([this](const LocalBoard& local_board) {
-        spdlog::get("app")->info("User has created board \"{}\"",
+        spdlog::get("app")->info("Board \"{}\" has been added",
                                  local_board.board->get_name());
     });
     m_manager.signal_remove_board().connect(
@@ -62,23 +96,149 @@ AppContext::AppContext(ui::ProgressWindow& app_window,
             spdlog::get("app")->info("User has deleted board \"{}\"",
                                      local_board.board->get_name());
         });
+
+    m_app_window.card_filter_popover().signal_changed().connect(
+        [this](CardFilter filter) {
+            const auto start = std::chrono::steady_clock::now();
+            m_card_filter.set_today(local_today());
+            m_card_filter.set_filter(filter);
+            spdlog::get("app")->debug(
+                "[AppContext.card_filter] {} of {} cards shown ({}us)",
+                m_card_filter.n_visible(), m_card_filter.n_cards(),
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - start)
+                    .count());
+        });
+    m_card_filter.signal_visibility().connect(
+        [this](std::shared_ptr<Card> card, bool visible) {
+            // Cards in virtualized cardlists may have no widget right now.
+            // Their visibility is set when they are bound
+            auto it = m_card_widgets.find(card.get());
+            if (it != m_card_widgets.end()) {
+                it->second->set_visible(visible);
+            }
+        });
+    m_board_stats.signal_changed().connect(
+        sigc::mem_fun(*this, &AppContext::show_board_stats));
+}
+
+AppContext::~AppContext() {
+    cancel_pending_load();
+
+    // Superseded workers stop early, so waiting for them is short
+    for (auto& [worker, finished] : m_superseded_loads) {
+        worker.join();
+    }
 }
 
 void AppContext::open_session(const std::string& filename) {
+    cancel_pending_load();
+    m_switch_start = std::chrono::steady_clock::now();
+
     spdlog::get("app")->debug(
         "[AppContext.open_session] Dispatch board session starter thread");
-    m_board_load_thread = std::thread{[this, filename]() {
+    // Boards opened before their page is enumerated are announced to the
+    // overview, which has to happen on this thread
+    m_manager.local_enumerate(filename);
+
+    const std::stop_token token = m_load_stop_source.get_token();
+    const unsigned long generation = ++m_load_generation;
+    auto finished = std::make_shared<std::atomic_bool>(false);
+    m_load_finished = finished;
+    m_board_load_thread = std::thread{[this, filename, token, generation,
+                                       finished]() {
+        std::shared_ptr<Board> board;
         try {
-            this->m_current_board = this->m_manager.local_open(filename);
+            board = m_manager.local_open(filename, token);
+
+            // Warm up the background cache while we are still off the GTK
+            // thread, so the board widget does not have to decode the image.
+            // Every level of the background pyramid is built at once
+            if (board && Board::get_background_type(board->get_background()) ==
+                             BackgroundType::IMAGE) {
+                compressed_bg_filename(board->get_background(),
+                                       ImageQuality::MEDIUM, token);
+            }
         } catch (std::invalid_argument& err) {
-            this->m_current_board = nullptr;
+            board = nullptr;
+        } catch (Glib::Error& err) {
+            // The background could not be decoded. The board itself is fine
+        }
+
+        {
+            std::lock_guard<std::mutex> lg{m_load_mutex};
+            if (token.stop_requested()) {
+                // Nobody is waiting for this board anymore. The GTK thread
+                // closes it, as the manager is not meant to be shared
+                if (board) {
+                    m_superseded_boards.push_back(board);
+                }
+            } else {
+                m_loaded_board = board;
+                m_loaded_generation = generation;
+                m_load_ready = true;
+            }
         }
 
+        *finished = true;
         m_load_board_dispatcher.emit();
     }};
 }
 
+void AppContext::cancel_pending_load() {
+    m_load_stop_source.request_stop();
+    if (m_board_load_thread.joinable()) {
+        // The worker notices the stop request on its own, there is no need to
+        // wait for it here
+        spdlog::get("app")->debug(
+            "[AppContext.cancel_pending_load] Cancelling board loader worker "
+            "thread");
+        m_superseded_loads.emplace_back(std::move(m_board_load_thread),
+                                        std::move(m_load_finished));
+    }
+    m_load_stop_source = std::stop_source{};
+
+    std::lock_guard<std::mutex> lg{m_load_mutex};
+    if (m_load_ready && m_loaded_board) {
+        spdlog::get("app")->debug(
+            "[AppContext.cancel_pending_load] Releasing superseded board "
+            "(\"{}\")",
+            m_loaded_board->get_name());
+        m_manager.local_close(m_loaded_board);
+    }
+    m_loaded_board = nullptr;
+    m_load_ready = false;
+}
+
+void AppContext::reap_superseded_loads() {
+    std::vector<std::shared_ptr<Board>> boards;
+    {
+        std::lock_guard<std::mutex> lg{m_load_mutex};
+        boards.swap(m_superseded_boards);
+    }
+    for (const auto& board : boards) {
+        spdlog::get("app")->debug(
+            "[AppContext.reap_superseded_loads] Releasing superseded board "
+            "(\"{}\")",
+            board->get_name());
+        m_manager.local_close(board);
+    }
+
+    // Finished workers are only left with notifying this thread, so joining
+    // them does not block
+    std::erase_if(m_superseded_loads, [](auto& load) {
+        auto& [worker, finished] = load;
+        if (!*finished) {
+            return false;
+        }
+        worker.join();
+        return true;
+    });
+}
+
 void AppContext::close_session() {
+    cancel_pending_load();
+
     if (m_current_board) {
         if (m_board_save_thread.joinable()) {
             spdlog::get("app")->debug(
@@ -108,14 +268,24 @@ void AppContext::close_session() {
 
 void AppContext::reset_session_state() {
     // Reset card updating system state
-    m_next_card_i = 0;
     m_cardlist_i = 0;
-    m_cards.clear();
+    m_deadlines.clear();
 
-    // Reset idle, suspend, timeout event handlers
-    m_idle_load_session_cnn.disconnect();
+    // Reset session loader state
+    if (m_load_tick_id) {
+        m_board_widget.remove_tick_callback(m_load_tick_id);
+        m_load_tick_id = 0;
+    }
+    for (ui::CardlistWidget* cardlist_w : m_loaded_cardlists) {
+        if (cardlist_w) m_cardlist_pool.release(cardlist_w);
+    }
+    m_loaded_cardlists.clear();
+    m_loaded_cards.clear();
+
+    // Reset suspend, timeout event handlers
     m_timeout_save_cnn.disconnect();
     m_timeout_cards_update_cnn.disconnect();
+    m_timeout_midnight_cnn.disconnect();
 #if GTKMM_CHECK_VERSION(4, 12, 0)
     m_suspended_tracker_cnn.disconnect();
 #else
@@ -123,12 +293,45 @@ void AppContext::reset_session_state() {
                                 m_suspended_tracker_handler_id);
 #endif
 
+    // Cards created by the user or by virtualized cardlists are managed, the
+    // pool just ignores them
+    for (const auto& [card_w, binding] : m_card_bindings) {
+        m_card_pool.release(card_w);
+    }
+
+    spdlog::get("app")->debug(
+        "[AppContext.reset_session_state] Dropping bindings: {} cardlists, {} "
+        "cards, {} tasks ({} live connections)",
+        m_cardlist_bindings.size(), m_card_bindings.size(),
+        m_task_bindings.size(),
+        m_cardlist_bindings.n_connections() + m_card_bindings.n_connections() +
+            m_task_bindings.n_connections());
     clear_binds();
+    m_card_filter.clear();
+    m_board_stats.clear();
 
     m_current_board = nullptr;
 }
 
 void AppContext::on_session_loaded() {
+    reap_superseded_loads();
+
+    {
+        std::lock_guard<std::mutex> lg{m_load_mutex};
+        if (!m_load_ready || m_loaded_generation != m_load_generation) {
+            // Notification from a superseded request, or its result has
+            // already been consumed
+            spdlog::get("app")->debug(
+                "[AppContext.on_session_loaded] Ignoring stale board load "
+                "notification");
+            return;
+        }
+        m_current_board = m_loaded_board;
+        m_loaded_board = nullptr;
+        m_load_ready = false;
+    }
+    m_session_token = m_load_stop_source.get_token();
+
     if (m_board_load_thread.joinable()) {
         m_board_load_thread.join();
     }
@@ -139,6 +342,9 @@ void AppContext::on_session_loaded() {
         m_session_flags[Status::LOADING] = true;
 
         m_app_window.set_title(m_current_board->get_name());
+        m_card_filter.track(m_current_board, local_today());
+        m_app_window.card_filter_popover().reset();
+        m_board_stats.track(m_current_board, local_today());
         ui::CardDialog& card_dialog = m_app_window.card_dialog();
 
         // TODO: Extract this into a AppContext::bind overload
@@ -148,7 +354,7 @@ void AppContext::on_session_loaded() {
                                          m_current_board->get_name(),
                                          card->get_title());
 
-                auto db_card = m_bound_cards[card];
+                auto db_card = m_card_bindings.model(card);
 
                 card_dialog.set_title(db_card->get_name());
 
@@ -163,64 +369,52 @@ void AppContext::on_session_loaded() {
                     card_dialog.set_complete(db_card->get_complete());
                 }
 
-                for (auto& task : db_card->container()) {
-                    ui::TaskWidget* task_widget =
-                        Gtk::make_managed<ui::TaskWidget>(
-                            card_dialog, task->get_name(), task->get_done());
-                    bind(task, task_widget);
-                    card_dialog.append(*task_widget);
-                }
-
                 card_dialog.set_notes(db_card->get_notes());
 
+                // Task widgets are only bound to the visible rows of the
+                // dialog's list view
                 m_card_dialog_cnns.push_back(
-                    card_dialog.signal_task_added().connect(
-                        [this, &card_dialog](ui::TaskWidget* task_w,
-                                             int index) {
-                            auto db_card =
-                                m_bound_cards[card_dialog.card_widget()];
+                    card_dialog.signal_task_bound().connect(
+                        [this](ui::TaskWidget* task_w,
+                               std::shared_ptr<Task> db_task) {
+                            bind(db_task, task_w);
+                        }));
+
+                m_card_dialog_cnns.push_back(
+                    card_dialog.signal_task_unbound().connect(
+                        [this](ui::TaskWidget* task_w) {
+                            m_task_bindings.unbind(task_w);
+                        }));
 
+                m_card_dialog_cnns.push_back(
+                    card_dialog.signal_task_requested().connect(
+                        [this, db_card](const std::string& title, int index) {
+                            auto new_db_task = Task::create(title);
                             if (index == -1) {
-                                auto new_db_task =
-                                    Task::create(task_w->get_title());
                                 db_card->container().append(new_db_task);
-                                bind(new_db_task, task_w);
-
-                                spdlog::get("app")->info(
-                                    "(\"{}\") → New task \"{}\" has been "
-                                    "appended to card \"{}\"",
-                                    m_current_board->get_name(),
-                                    new_db_task->get_name(),
-                                    db_card->get_name());
                             } else {
-                                auto& data = db_card->container().get_data();
-                                auto new_db_task =
-                                    Task::create(task_w->get_title());
-                                data.insert(std::next(data.begin(), index + 1),
-                                            new_db_task);
-                                db_card->container().modify(true);
-
-                                bind(new_db_task, task_w);
-
-                                spdlog::get("app")->info(
-                                    "(\"{}\") → New task \"{}\" has been "
-                                    "inserted into card \"{}\"",
-                                    m_current_board->get_name(),
-                                    new_db_task->get_name(),
-                                    db_card->get_name());
+                                db_card->container().insert(new_db_task,
+                                                            index + 1);
                             }
+
+                            spdlog::get("app")->info(
+                                "(\"{}\") → New task \"{}\" has been added "
+                                "to card \"{}\"",
+                                m_current_board->get_name(),
+                                new_db_task->get_name(), db_card->get_name());
                         }));
 
+                card_dialog.set_model(ui::TaskListModel::create(db_card));
+
                 m_card_dialog_cnns.push_back(
                     card_dialog.signal_task_removed().connect(
                         [this, &card_dialog](ui::TaskWidget* task_w) {
-                            auto db_card =
-                                m_bound_cards[card_dialog.card_widget()];
+                            auto db_card = m_card_bindings.model(
+                                card_dialog.card_widget());
 
                             std::shared_ptr<Task> to_remove =
-                                m_bound_tasks[task_w];
+                                m_task_bindings.model(task_w);
                             db_card->container().remove(to_remove);
-                            m_bound_tasks.erase(task_w);
 
                             spdlog::get("app")->info(
                                 "(\"{}\") → Task \"{}\" has been removed from "
@@ -233,28 +427,32 @@ void AppContext::on_session_loaded() {
                     card_dialog.signal_task_reordered().connect(
                         [this, &card_dialog](ui::TaskWidget* next,
                                              ui::TaskWidget* sibling, bool up) {
-                            auto db_card =
-                                m_bound_cards[card_dialog.card_widget()];
-
-                            if (up) {
-                                db_card->container().reorder_before(
-                                    m_bound_tasks[next],
-                                    m_bound_tasks[sibling]);
-                            } else {
-                                db_card->container().reorder_after(
-                                    m_bound_tasks[next],
-                                    m_bound_tasks[sibling]);
-                            }
+                            auto db_card = m_card_bindings.model(
+                                card_dialog.card_widget());
+
+                            // Both widgets may be rebound while the tasks
+                            // are reordered
+                            std::shared_ptr<Task> db_next =
+                                m_task_bindings.model(next);
+                            std::shared_ptr<Task> db_sibling =
+                                m_task_bindings.model(sibling);
+
+                            // Whether it goes up or down, the task takes its
+                            // sibling's place
+                            ItemContainer<Task>::move(
+                                db_next, db_card->container(),
+                                db_card->container(), db_sibling,
+                                up ? ReorderingType::BEFORE
+                                   : ReorderingType::AFTER);
 
                             spdlog::get("app")->info(
                                 "(\"{}\") → In card \"{}\", Task \"{}\" has "
                                 "been reordered {} "
                                 "Task \"{}\"",
                                 m_current_board->get_name(),
-                                db_card->get_name(),
-                                m_bound_tasks[next]->get_name(),
+                                db_card->get_name(), db_next->get_name(),
                                 (up ? "before" : "after"),
-                                m_bound_tasks[sibling]->get_name());
+                                db_sibling->get_name());
                         }));
             }));
 
@@ -267,7 +465,7 @@ void AppContext::on_session_loaded() {
                     m_card_dialog_cnns.end());
 
                 ui::CardWidget* card_w = card_dialog.card_widget();
-                auto db_card = m_bound_cards[card_w];
+                auto db_card = m_card_bindings.model(card_w);
 
                 const std::string old_name = db_card->get_name();
                 if (old_name != card_dialog.get_title()) {
@@ -286,12 +484,7 @@ void AppContext::on_session_loaded() {
                     db_card->set_due_date(date);
 
                     if (date.ok()) {
-                        // It means the cards hasn't a deadline set until now,
-                        // which means it should be added to the card updating
-                        // queue too
                         if (!old_date.ok()) {
-                            card_update_queue_push(card_w);
-
                             spdlog::get("app")->info(
                                 "(\"{}\") → Card \"{}\"'s deadline has been "
                                 "set",
@@ -305,10 +498,6 @@ void AppContext::on_session_loaded() {
                                 db_card->get_name());
                         }
                     } else {
-                        // Date has been unset. We don't need to update this
-                        // card's deadline label anymore
-                        std::erase(m_cards, card_w);
-
                         spdlog::get("app")->info(
                             "(\"{}\") → Card \"{}\"'s deadline has been "
                             "unset",
@@ -329,6 +518,10 @@ void AppContext::on_session_loaded() {
                                                  : "not complete"));
                 }
 
+                // Either the deadline or the completion may have moved the
+                // day the card's deadline label changes
+                schedule_deadline_update(card_w, db_card);
+
                 const std::pair<int, int> completion_ratio =
                     card_dialog.get_completion_ratio();
                 card_w->set_completion_label(completion_ratio.second,
@@ -345,6 +538,10 @@ void AppContext::on_session_loaded() {
                         !db_card->get_notes().empty());
                 }
 
+                // The dialog keeps its task widgets, and drops its model
+                // once it clears itself
+                m_task_bindings.clear();
+
                 spdlog::get("app")->info("(\"{}\") → Card Dialog closed for {}",
                                          m_current_board->get_name(),
                                          db_card->get_name());
@@ -355,9 +552,34 @@ void AppContext::on_session_loaded() {
         // TODO: Remove this method. There's no need for it
         setup_board_widget();
 
-        m_idle_load_session_cnn = Glib::signal_idle().connect(
-            sigc::mem_fun(*this, &AppContext::idle_load_session),
-            Glib::PRIORITY_LOW);
+        // The initial viewport is estimated from the window, as the board
+        // widget might not have been allocated yet
+        const auto& data = m_current_board->container().get_data();
+        const int viewport_width = m_board_widget.get_width() > 0
+                                       ? m_board_widget.get_width()
+                                       : m_app_window.get_width();
+        const int viewport_height = m_board_widget.get_height() > 0
+                                        ? m_board_widget.get_height()
+                                        : m_app_window.get_height();
+        m_load_phase = LoadPhase::VIEWPORT;
+        m_cardlist_i = 0;
+        m_viewport_cardlists =
+            viewport_width / ui::CardlistWidget::CARDLIST_MAX_WIDTH + 1;
+        m_viewport_cards = viewport_height / LOAD_CARD_HEIGHT_HINT + 1;
+        m_loaded_cardlists.assign(data.size(), nullptr);
+        m_loaded_cards.assign(data.size(), 0);
+        m_load_units = data.size();
+        for (const auto& cardlist : data) {
+            m_load_units += cardlist->container().size();
+        }
+        m_loaded_units = 0;
+        m_load_start = std::chrono::steady_clock::now();
+        m_load_interactive = {};
+        m_last_frame_time = 0;
+        m_worst_frame_time = 0;
+
+        m_load_tick_id = m_board_widget.add_tick_callback(
+            sigc::mem_fun(*this, &AppContext::tick_load_session));
         m_timeout_save_cnn = Glib::signal_timeout().connect(
             sigc::mem_fun(*this, &AppContext::timeout_save_session),
             AppContext::SAVE_INTERVAL);
@@ -405,20 +627,20 @@ void AppContext::on_session_saved() {
 void AppContext::toggle_timeout_update_cards() {
     if (m_app_window.is_suspended()) {
         m_timeout_cards_update_cnn.disconnect();
+        m_timeout_midnight_cnn.disconnect();
     } else {
-        m_timeout_cards_update_cnn = Glib::signal_timeout().connect(
-            sigc::mem_fun(*this, &AppContext::timeout_update_cards),
-            AppContext::UPDATE_INTERVAL);
+        timeout_update_cards();
+        timeout_midnight();
     }
 }
 #else
 void AppContext::toggle_timeout_update_cards() {
     if (gtk_window_is_suspended(GTK_WINDOW(m_app_window.gobj()))) {
         m_timeout_cards_update_cnn.disconnect();
+        m_timeout_midnight_cnn.disconnect();
     } else {
-        m_timeout_cards_update_cnn = Glib::signal_timeout().connect(
-            sigc::mem_fun(*this, &AppContext::timeout_update_cards),
-            AppContext::UPDATE_INTERVAL);
+        timeout_update_cards();
+        timeout_midnight();
     }
 }
 #endif
@@ -486,14 +708,9 @@ void AppContext::bind(const std::shared_ptr<Board>& db_board,
                     "(\"{}\") → Cardlist \"{}\" has been appended to Board",
                     m_current_board->get_name(), new_cardlist->get_name());
             } else {
-                auto& inner_data = db_board->container().get_data();
-
-                // TODO: Implement proper insert_index
                 std::shared_ptr<CardList> new_cardlist =
                     CardList::create(cardlist_w->get_name());
-                inner_data.insert(std::next(inner_data.begin(), index + 1),
-                                  new_cardlist);
-                db_board->container().modify(true);
+                db_board->container().insert(new_cardlist, index + 1);
 
                 bind(new_cardlist, cardlist_w);
 
@@ -505,10 +722,11 @@ void AppContext::bind(const std::shared_ptr<Board>& db_board,
 
     m_board_widget_cnns.push_back(board_w->signal_remove_cardlist().connect(
         [this, db_board](ui::CardlistWidget* cardlist_w) {
-            std::shared_ptr<CardList> to_remove = m_bound_cardlists[cardlist_w];
+            std::shared_ptr<CardList> to_remove =
+                m_cardlist_bindings.model(cardlist_w);
             db_board->container().remove(to_remove);
 
-            m_bound_cardlists.erase(cardlist_w);
+            unbind(cardlist_w);
 
             spdlog::get("app")->info(
                 "(\"{}\") → Cardlist \"{}\" has been removed from Board",
@@ -520,26 +738,30 @@ void AppContext::bind(const std::shared_ptr<Board>& db_board,
                          bool up) {
             if (up) {
                 db_board->container().reorder_before(
-                    m_bound_cardlists[next], m_bound_cardlists[sibling]);
+                    m_cardlist_bindings.model(next),
+                    m_cardlist_bindings.model(sibling));
             } else {
-                db_board->container().reorder_after(m_bound_cardlists[next],
-                                                    m_bound_cardlists[sibling]);
+                db_board->container().reorder_after(
+                    m_cardlist_bindings.model(next),
+                    m_cardlist_bindings.model(sibling));
             }
 
             spdlog::get("app")->info(
                 "(\"{}\") → Cardlist \"{}\" has been reordered {} Cardlist "
                 "\"{}\"",
                 m_current_board->get_name(),
-                m_bound_cardlists[next]->get_name(), (up ? "before" : "after"),
-                m_bound_cardlists[sibling]->get_name());
+                m_cardlist_bindings.model(next)->get_name(),
+                (up ? "before" : "after"),
+                m_cardlist_bindings.model(sibling)->get_name());
         }));
 }
 
 void AppContext::bind(const std::shared_ptr<CardList>& db_cardlist,
                       ui::CardlistWidget* cardlist_w) {
-    m_bound_cardlists[cardlist_w] = db_cardlist;
+    m_cardlist_bindings.bind(cardlist_w, db_cardlist);
+    auto& cardlist_cnns = m_cardlist_bindings.connections(cardlist_w);
 
-    m_cardlists_cnns.push_back(cardlist_w->signal_name_changed().connect(
+    cardlist_cnns.push_back(cardlist_w->signal_name_changed().connect(
         [this, db_cardlist](std::string old_name, std::string new_name) {
             if (old_name != new_name) {
                 db_cardlist->set_name(new_name);
@@ -550,8 +772,8 @@ void AppContext::bind(const std::shared_ptr<CardList>& db_cardlist,
             }
         }));
 
-    m_cardlists_cnns.push_back(cardlist_w->signal_card_added().connect(
-        [this, db_cardlist](ui::CardWidget* card_w, int index) {
+    cardlist_cnns.push_back(cardlist_w->signal_card_added().connect(
+        [this, db_cardlist, cardlist_w](ui::CardWidget* card_w, int index) {
             if (index == -1) {
                 auto new_db_card = Card::create(card_w->get_title());
                 db_cardlist->container().append(new_db_card);
@@ -563,10 +785,8 @@ void AppContext::bind(const std::shared_ptr<CardList>& db_cardlist,
                     m_current_board->get_name(), new_db_card->get_name(),
                     db_cardlist->get_name());
             } else {
-                auto& data = db_cardlist->container().get_data();
                 auto new_db_card = Card::create(card_w->get_title());
-                data.insert(std::next(data.begin(), index + 1), new_db_card);
-                db_cardlist->container().modify(true);
+                db_cardlist->container().insert(new_db_card, index + 1);
 
                 bind(new_db_card, card_w);
 
@@ -576,13 +796,77 @@ void AppContext::bind(const std::shared_ptr<CardList>& db_cardlist,
                     m_current_board->get_name(), new_db_card->get_name(),
                     db_cardlist->get_name());
             }
+
+            // Switch to virtualized rendering once the cardlist grows past the
+            // threshold. This is deferred as the caller may still be using
+            // the card widget
+            if (!cardlist_w->is_virtualized() &&
+                db_cardlist->container().size() >
+                    ui::CardlistWidget::VIRTUALIZATION_THRESHOLD) {
+                Glib::signal_idle().connect_once(
+                    [this, db_cardlist, cardlist_w]() {
+                        if (m_cardlist_bindings.model(cardlist_w) ==
+                            db_cardlist) {
+                            cardlist_w->set_model(
+                                ui::CardListModel::create(db_cardlist));
+                        }
+                    });
+            }
+        }));
+
+    cardlist_cnns.push_back(cardlist_w->signal_card_requested().connect(
+        [this, db_cardlist](const std::string& title, int index) {
+            auto new_db_card = Card::create(title);
+            if (index == -1) {
+                db_cardlist->container().append(new_db_card);
+            } else {
+                db_cardlist->container().insert(new_db_card, index + 1);
+            }
+
+            spdlog::get("app")->info(
+                "(\"{}\") → New card \"{}\" has been added onto cardlist "
+                "\"{}\"",
+                m_current_board->get_name(), new_db_card->get_name(),
+                db_cardlist->get_name());
+        }));
+
+    cardlist_cnns.push_back(cardlist_w->signal_card_bound().connect(
+        [this](ui::CardWidget* card_w, std::shared_ptr<Card> db_card) {
+            unbind(card_w);
+            refresh_card_widget(db_card, card_w);
+            bind(db_card, card_w);
+            schedule_deadline_update(card_w, db_card);
+        }));
+
+    // Cards moved into a virtualized cardlist, or left behind when a cardlist
+    // becomes virtualized, are handed back to the pool. The rows of
+    // virtualized cardlists are not the pool's, it ignores them
+    cardlist_cnns.push_back(cardlist_w->signal_card_unbound().connect(
+        [this](ui::CardWidget* card_w) {
+            unbind(card_w);
+            m_card_pool.release(card_w);
+        }));
+
+    // Virtualized cardlists unbind their rows themselves when they fall asleep
+    cardlist_cnns.push_back(cardlist_w->signal_dormant().connect(
+        [this, db_cardlist, cardlist_w](bool dormant) {
+            if (cardlist_w->is_virtualized()) {
+                return;
+            }
+
+            if (dormant) {
+                release_cards(cardlist_w);
+            } else {
+                restore_cards(db_cardlist, cardlist_w);
+            }
         }));
 
-    m_cardlists_cnns.push_back(cardlist_w->signal_card_removed().connect(
+    cardlist_cnns.push_back(cardlist_w->signal_card_removed().connect(
         [this, db_cardlist](ui::CardWidget* card_w) {
-            std::shared_ptr<Card> to_remove = m_bound_cards[card_w];
+            std::shared_ptr<Card> to_remove = m_card_bindings.model(card_w);
             db_cardlist->container().remove(to_remove);
-            m_bound_cards.erase(card_w);
+            unbind(card_w);
+            m_card_pool.release(card_w);
 
             spdlog::get("app")->info(
                 "(\"{}\") → Card \"{}\" has been removed from cardlist \"{}\"",
@@ -590,52 +874,70 @@ void AppContext::bind(const std::shared_ptr<CardList>& db_cardlist,
                 db_cardlist->get_name());
         }));
 
-    m_cardlists_cnns.push_back(cardlist_w->signal_card_removed().connect(
-        [this](ui::CardWidget* card_w) { std::erase(m_cards, card_w); }));
+    cardlist_cnns.push_back(cardlist_w->signal_card_removed().connect(
+        [this](ui::CardWidget* card_w) { m_deadlines.unschedule(card_w); }));
 
-    m_cardlists_cnns.push_back(cardlist_w->signal_card_reorder().connect(
+    cardlist_cnns.push_back(cardlist_w->signal_card_reorder().connect(
         [this, db_cardlist](ui::CardWidget* next, ui::CardWidget* sibling,
                             bool up) {
-            if (up) {
-                db_cardlist->container().reorder_before(m_bound_cards[next],
-                                                        m_bound_cards[sibling]);
-            } else {
-                db_cardlist->container().reorder_after(m_bound_cards[next],
-                                                       m_bound_cards[sibling]);
-            }
+            // Virtualized cardlists may rebind both widgets while the cards
+            // are reordered
+            std::shared_ptr<Card> db_next = m_card_bindings.model(next);
+            std::shared_ptr<Card> db_sibling = m_card_bindings.model(sibling);
+
+            // Whether it goes up or down, the card takes its sibling's place
+            ItemContainer<Card>::move(
+                db_next, db_cardlist->container(), db_cardlist->container(),
+                db_sibling,
+                up ? ReorderingType::BEFORE : ReorderingType::AFTER);
 
             spdlog::get("app")->info(
                 "(\"{}\") → Card \"{}\" has been reordered {} Card \"{}\"",
-                m_current_board->get_name(), m_bound_cards[next]->get_name(),
-                (up ? "before" : "after"), m_bound_cards[sibling]->get_name());
+                m_current_board->get_name(), db_next->get_name(),
+                (up ? "before" : "after"), db_sibling->get_name());
         }));
 
-    m_cardlists_cnns.push_back(cardlist_w->signal_card_received().connect(
+    cardlist_cnns.push_back(cardlist_w->signal_card_received().connect(
         [this, db_cardlist](ui::CardWidget* recv_widget,
                             ui::CardlistWidget* from_parent,
                             ui::CardWidget* sibling) {
             std::shared_ptr<CardList> received_from =
-                m_bound_cardlists[from_parent];
-            std::shared_ptr<Card> received_card = m_bound_cards[recv_widget];
-            received_from->container().remove(received_card);
+                m_cardlist_bindings.model(from_parent);
+            std::shared_ptr<Card> received_card =
+                m_card_bindings.model(recv_widget);
+            std::shared_ptr<Card> db_sibling =
+                sibling ? m_card_bindings.model(sibling) : nullptr;
+
+            // The widget is only reparented here if no cardlist is
+            // virtualized. Otherwise its old cardlist unbinds it right after
+            m_cardlist_cards[from_parent].erase(recv_widget);
+            m_cardlist_cards[recv_widget->parent()].insert(recv_widget);
+
+            // The card is spliced into its new cardlist, so it keeps its
+            // bindings, filter state and statistics. Cards whose sibling is
+            // gone are appended, as their widget has been moved already
+            if (!db_sibling ||
+                !ItemContainer<Card>::move(
+                    received_card, received_from->container(),
+                    db_cardlist->container(), db_sibling,
+                    ReorderingType::AFTER)) {
+                ItemContainer<Card>::move(received_card,
+                                          received_from->container(),
+                                          db_cardlist->container(), -1);
+            }
 
             if (!sibling) {
-                db_cardlist->container().append(received_card);
-
                 spdlog::get("app")->info(
                     "(\"{}\") → Card \"{}\" from cardlist \"{}\" has been "
                     "appended to cardlist \"{}\"",
                     m_current_board->get_name(), received_card->get_name(),
                     received_from->get_name(), db_cardlist->get_name());
             } else {
-                db_cardlist->container().insert_after(received_card,
-                                                      m_bound_cards[sibling]);
-
                 spdlog::get("app")->info(
                     "(\"{}\") → Card \"{}\" from cardlist \"{}\" has been "
                     "inserted after card \"{}\" in cardlist \"{}\"",
                     m_current_board->get_name(), received_card->get_name(),
-                    m_bound_cards[sibling]->get_name(),
+                    db_sibling->get_name(),
                     received_from->get_name(), db_cardlist->get_name());
             }
         }));
@@ -643,9 +945,13 @@ void AppContext::bind(const std::shared_ptr<CardList>& db_cardlist,
 
 void AppContext::bind(const std::shared_ptr<Card>& db_card,
                       ui::CardWidget* card_w) {
-    m_bound_cards[card_w] = db_card;
+    m_card_bindings.bind(card_w, db_card);
+    m_card_widgets[db_card.get()] = card_w;
+    m_cardlist_cards[card_w->parent()].insert(card_w);
+    card_w->set_visible(m_card_filter.visible(*db_card));
+    auto& card_cnns = m_card_bindings.connections(card_w);
 
-    m_cards_cnns.push_back(card_w->signal_name_changed().connect(
+    card_cnns.push_back(card_w->signal_name_changed().connect(
         [this, db_card](const std::string& old_name,
                         const std::string& new_name) {
             if (old_name != new_name) {
@@ -657,7 +963,7 @@ void AppContext::bind(const std::shared_ptr<Card>& db_card,
             }
         }));
 
-    m_cards_cnns.push_back(card_w->signal_color_changed().connect(
+    card_cnns.push_back(card_w->signal_color_changed().connect(
         [this, db_card](const Gdk::RGBA old_color, const Gdk::RGBA new_color) {
             if (old_color != new_color) {
                 db_card->set_color(
@@ -673,29 +979,27 @@ void AppContext::bind(const std::shared_ptr<Card>& db_card,
 
     // FIXME: This callback will never be called! Remove the signal and this
     // handler
-    m_cards_cnns.push_back(card_w->signal_card_received().connect(
+    card_cnns.push_back(card_w->signal_card_received().connect(
         [this, db_card, card_w](ui::CardWidget* recv_widget,
                                 ui::CardlistWidget* recv_from) {
-            auto recv_from_cardlist = m_bound_cardlists[recv_from];
-            auto recv_card = m_bound_cards[recv_widget];
-
-            auto db_card_cardlist = m_bound_cardlists[card_w->parent()];
+            auto recv_from_cardlist = m_cardlist_bindings.model(recv_from);
+            auto recv_card = m_card_bindings.model(recv_widget);
 
-            recv_from_cardlist->container().signal_remove().block();
-            recv_from_cardlist->container().remove(recv_card);
-            recv_from_cardlist->container().signal_remove().unblock();
+            auto db_card_cardlist = m_cardlist_bindings.model(card_w->parent());
 
-            // Insert to the new destination
-            db_card_cardlist->container().insert_after(recv_card,
-                                                       m_bound_cards[card_w]);
+            ItemContainer<Card>::move(
+                recv_card, recv_from_cardlist->container(),
+                db_card_cardlist->container(), m_card_bindings.model(card_w),
+                ReorderingType::AFTER);
         }));
 }
 
 void AppContext::bind(const std::shared_ptr<Task>& db_task,
                       ui::TaskWidget* task_w) {
-    m_bound_tasks[task_w] = db_task;
+    m_task_bindings.bind(task_w, db_task);
+    auto& task_cnns = m_task_bindings.connections(task_w);
 
-    m_tasks_cnns.push_back(task_w->signal_name_changed().connect(
+    task_cnns.push_back(task_w->signal_name_changed().connect(
         [this, db_task](const std::string& old_name,
                         const std::string& new_name) {
             if (old_name != new_name) {
@@ -707,7 +1011,7 @@ void AppContext::bind(const std::shared_ptr<Task>& db_task,
             }
         }));
 
-    m_tasks_cnns.push_back(
+    task_cnns.push_back(
         task_w->signal_complete_changed().connect([this, db_task, task_w]() {
             db_task->set_done(task_w->get_complete());
 
@@ -718,23 +1022,129 @@ void AppContext::bind(const std::shared_ptr<Task>& db_task,
         }));
 }
 
+void AppContext::unbind(ui::CardWidget* card_w) {
+    // A card may already be bound to another widget (e.g. a recycled row)
+    auto db_card = m_card_bindings.model(card_w);
+    auto it = db_card ? m_card_widgets.find(db_card.get())
+                      : m_card_widgets.end();
+    if (it != m_card_widgets.end() && it->second == card_w) {
+        m_card_widgets.erase(it);
+    }
+    m_card_bindings.unbind(card_w);
+    m_deadlines.unschedule(card_w);
+    card_w->release_card_popover();
+
+    auto cards_it = m_cardlist_cards.find(card_w->parent());
+    if (cards_it != m_cardlist_cards.end()) {
+        cards_it->second.erase(card_w);
+    }
+}
+
+void AppContext::unbind(ui::CardlistWidget* cardlist_w) {
+    m_cardlist_bindings.unbind(cardlist_w);
+    m_released_cardlists.erase(cardlist_w);
+
+    auto cards = m_cardlist_cards.extract(cardlist_w);
+    if (cards) {
+        for (ui::CardWidget* card_w : cards.mapped()) {
+            unbind(card_w);
+        }
+    }
+}
+
+void AppContext::release_cards(ui::CardlistWidget* cardlist_w) {
+    // Cards created by the user are managed, the pool just ignores them
+    for (ui::CardWidget* card_w : cardlist_w->cards()) {
+        unbind(card_w);
+        m_card_pool.release(card_w);
+    }
+    cardlist_w->release_cards();
+    m_released_cardlists.insert(cardlist_w);
+}
+
+void AppContext::restore_cards(const std::shared_ptr<CardList>& db_cardlist,
+                               ui::CardlistWidget* cardlist_w) {
+    if (!m_released_cardlists.erase(cardlist_w)) {
+        return;
+    }
+
+    for (const auto& db_card : db_cardlist->container()) {
+        ui::CardWidget* card_w = m_card_pool.acquire();
+        card_w->detach();
+        refresh_card_widget(db_card, card_w);
+        schedule_deadline_update(card_w, db_card);
+        cardlist_w->restore_card(*card_w);
+        bind(db_card, card_w);
+    }
+}
+
 void AppContext::clear_binds() {
     m_board_widget_cnns.clear();
-    m_cardlists_cnns.clear();
-    m_cards_cnns.clear();
     m_card_dialog_cnns.clear();
+
+    m_cardlist_bindings.clear();
+    m_card_bindings.clear();
+    m_card_widgets.clear();
+    m_cardlist_cards.clear();
+    m_released_cardlists.clear();
+    m_task_bindings.clear();
+}
+
+void AppContext::show_board_stats() {
+    if (!m_current_board) {
+        return;
+    }
+
+    std::vector<std::pair<std::string, CardStats>> cardlists;
+    for (const auto& cardlist : m_current_board->container()) {
+        cardlists.emplace_back(cardlist->get_name(),
+                               m_board_stats.cardlist(*cardlist));
+    }
+    m_app_window.set_board_stats(m_board_stats.board(), cardlists);
 }
 
-void AppContext::card_update_queue_push(ui::CardWidget* card_w) {
-    m_cards.push_back(card_w);
+void AppContext::schedule_deadline_update(
+    ui::CardWidget* card_w, const std::shared_ptr<Card>& db_card) {
+    m_deadlines.schedule(card_w, db_card->get_due_date(),
+                         db_card->get_complete(), local_today());
 
-    if (m_timeout_cards_update_cnn.empty()) {
-        m_timeout_cards_update_cnn = Glib::signal_timeout().connect(
-            sigc::mem_fun(*this, &AppContext::timeout_update_cards),
-            UPDATE_INTERVAL);
+    // The loader arms the refresher once every card has been scheduled
+    if (!m_session_flags[Status::LOADING]) {
+        arm_deadline_timer();
     }
 }
 
+void AppContext::arm_deadline_timer() {
+    m_timeout_cards_update_cnn.disconnect();
+
+    const auto next_boundary = m_deadlines.next();
+    if (!next_boundary) {
+        spdlog::get("app")->debug(
+            "[AppContext.arm_deadline_timer] No deadline can change. Deadline "
+            "refresher is sleeping");
+        return;
+    }
+
+    // Boundaries are local midnights
+    const unsigned int interval =
+        std::clamp<gint64>(seconds_until(*next_boundary), 1,
+                           AppContext::DEADLINE_RECHECK_INTERVAL);
+
+    m_timeout_cards_update_cnn = Glib::signal_timeout().connect_seconds(
+        sigc::mem_fun(*this, &AppContext::timeout_update_cards), interval);
+}
+
+void AppContext::arm_midnight_timer() {
+    m_timeout_midnight_cnn.disconnect();
+
+    const Date tomorrow{std::chrono::sys_days{local_today()} +
+                        std::chrono::days{1}};
+    const unsigned int interval = std::clamp<gint64>(
+        seconds_until(tomorrow), 1, AppContext::DEADLINE_RECHECK_INTERVAL);
+    m_timeout_midnight_cnn = Glib::signal_timeout().connect_seconds(
+        sigc::mem_fun(*this, &AppContext::timeout_midnight), interval);
+}
+
 bool AppContext::on_window_closed() {
     if (!(m_session_flags[Status::CLEARING] ||
           m_session_flags[Status::LOADING]) &&
@@ -755,72 +1165,204 @@ bool AppContext::on_window_closed() {
     return false;
 }
 
-// FIXME
-bool AppContext::idle_load_session() {
+bool AppContext::tick_load_session(
+    const Glib::RefPtr<Gdk::FrameClock>& frame_clock) {
     if (!m_current_board) {
         spdlog::get("app")->error(
-            "[AppContext.idle_load_session] Current board is invalid. Stopping "
+            "[AppContext.tick_load_session] Current board is invalid. Stopping "
             "loading task");
         m_session_flags[Status::LOADING] = false;
+        m_load_tick_id = 0;
+        return false;
+    }
+
+    if (m_session_token.stop_requested()) {
+        spdlog::get("app")->debug(
+            "[AppContext.tick_load_session] Session (\"{}\") loading has been "
+            "cancelled",
+            m_current_board->get_name());
+        m_session_flags[Status::LOADING] = false;
+        m_load_tick_id = 0;
         return false;
     }
 
     if (m_session_flags[Status::CLEARING] && m_session_flags[Status::LOADING]) {
         spdlog::get("app")->warn(
-            "[AppContext.idle_load_session] Board view is not clean. Current "
+            "[AppContext.tick_load_session] Board view is not clean. Current "
             "session (\"{}\") is waiting",
             m_current_board->get_name());
         return true;
     }
 
+    const gint64 frame_time = frame_clock->get_frame_time();
+    if (m_last_frame_time) {
+        m_worst_frame_time =
+            std::max(m_worst_frame_time, frame_time - m_last_frame_time);
+    }
+    m_last_frame_time = frame_time;
+
+    const auto deadline = std::chrono::steady_clock::now() +
+                          std::chrono::milliseconds{LOAD_FRAME_BUDGET};
+    bool loading = true;
+    while (loading && std::chrono::steady_clock::now() < deadline) {
+        loading = load_step();
+    }
+
+    m_session_flags[Status::LOADING] = loading;
+    m_session_flags[Status::BUSY] = true;
+
+    if (loading) {
+        m_app_window.set_load_progress(m_load_units ? double(m_loaded_units) /
+                                                          m_load_units
+                                                    : 1);
+        return true;
+    }
+
+    using std::chrono::duration_cast, std::chrono::milliseconds;
+    spdlog::get("app")->debug(
+        "[AppContext.tick_load_session] Session (\"{}\") has been fully loaded "
+        "in {}ms (interactive after {}ms, worst frame {}ms)",
+        m_current_board->get_name(),
+        duration_cast<milliseconds>(std::chrono::steady_clock::now() -
+                                    m_load_start)
+            .count(),
+        duration_cast<milliseconds>(m_load_interactive).count(),
+        m_worst_frame_time / 1000);
+
+    const auto [cardlists_created, cardlists_reused] =
+        m_cardlist_pool.take_counts();
+    const auto [cards_created, cards_reused] = m_card_pool.take_counts();
+    spdlog::get("app")->debug(
+        "[AppContext.tick_load_session] Board switch took {}ms. Widgets "
+        "created/reused: cardlists {}/{}, cards {}/{}",
+        duration_cast<milliseconds>(std::chrono::steady_clock::now() -
+                                    m_switch_start)
+            .count(),
+        cardlists_created, cardlists_reused, cards_created, cards_reused);
+    spdlog::get("app")->debug(
+        "[AppContext.tick_load_session] Board holds {} widgets, cards are "
+        "rendered as {}",
+        count_widgets(m_board_widget),
+        ui::CardWidget::default_render_mode() == ui::CardRenderMode::DRAWN
+            ? "drawn cards"
+            : "widget trees");
+    m_app_window.set_load_progress(1);
+    bind(m_current_board, &m_board_widget);
+
+    arm_deadline_timer();
+    arm_midnight_timer();
+    m_load_tick_id = 0;
+    return false;
+}
+
+bool AppContext::load_step() {
     const auto& data = m_current_board->container().get_data();
-    // FIXME: This is logically confusing. m_cardlist_i gives the idea of an
-    // indexer but it is actually working as a counter
-    if (m_cardlist_i > (data.size() - 1) || data.empty()) {
-        m_session_flags[Status::LOADING] = false;
 
-        spdlog::get("app")->debug(
-            "[AppContext.idle_load_session] Session (\"{}\") has been fully "
-            "loaded",
-            m_current_board->get_name());
-        bind(m_current_board, &m_board_widget);
+    if (m_load_phase == LoadPhase::VIEWPORT) {
+        if (m_cardlist_i < std::min(m_viewport_cardlists, data.size())) {
+            const size_t n_cards = data[m_cardlist_i]->container().size();
+            load_cardlist(m_cardlist_i);
+
+            if (m_loaded_cards[m_cardlist_i] <
+                std::min(m_viewport_cards, n_cards)) {
+                load_card(m_cardlist_i);
+            } else {
+                m_cardlist_i++;
+            }
+            return true;
+        }
 
-        m_timeout_cards_update_cnn = Glib::signal_timeout().connect(
-            sigc::mem_fun(*this, &AppContext::timeout_update_cards),
-            AppContext::UPDATE_INTERVAL);
-        m_idle_load_session_cnn.disconnect();
+        m_load_phase = LoadPhase::REST;
+        m_cardlist_i = 0;
+    }
+
+    if (m_cardlist_i >= data.size()) {
         return false;
     }
 
-    ui::CardlistWidget* cardlist_widget = Gtk::make_managed<ui::CardlistWidget>(
-        m_board_widget, data[m_cardlist_i]->get_name());
-    m_board_widget.append(*cardlist_widget);
+    const size_t n_cards = data[m_cardlist_i]->container().size();
+    ui::CardlistWidget* cardlist_w = load_cardlist(m_cardlist_i);
 
-    for (const auto& card : data[m_cardlist_i]->container()) {
-        ui::CardWidget* card_widget = builder_card_widget(card);
-        if (card_widget->is_deadline_set()) {
-            m_cards.push_back(card_widget);
-        }
-        cardlist_widget->append(*card_widget);
-        bind(card, card_widget);
+    if (m_loaded_cards[m_cardlist_i] < n_cards) {
+        load_card(m_cardlist_i);
+        return true;
     }
 
-    bind(data[m_cardlist_i], cardlist_widget);
+    // Every card has been built. The cardlist can take user input now
+    if (!m_cardlist_bindings.contains(cardlist_w)) {
+        bind(data[m_cardlist_i], cardlist_w);
+
+        // It may have been scrolled away while its cards were being built
+        if (cardlist_w->is_dormant() && !cardlist_w->is_virtualized()) {
+            release_cards(cardlist_w);
+        }
+    }
+    cardlist_w->set_sensitive(true);
     m_cardlist_i++;
 
-    m_session_flags[Status::LOADING] = true;
-    m_session_flags[Status::BUSY] = true;
+    if (m_cardlist_i == std::min(m_viewport_cardlists, data.size())) {
+        m_load_interactive = std::chrono::steady_clock::now() - m_load_start;
+    }
     return true;
 }
 
+ui::CardlistWidget* AppContext::load_cardlist(size_t index) {
+    if (m_loaded_cardlists[index]) {
+        return m_loaded_cardlists[index];
+    }
+
+    const auto& db_cardlist = m_current_board->container().get_data()[index];
+    ui::CardlistWidget* cardlist_w = m_cardlist_pool.acquire();
+    cardlist_w->reset(db_cardlist->get_name());
+    m_board_widget.append(*cardlist_w);
+    m_loaded_cardlists[index] = cardlist_w;
+    m_loaded_units++;
+
+    if (db_cardlist->container().size() >
+        ui::CardlistWidget::VIRTUALIZATION_THRESHOLD) {
+        // Only the visible cards get a widget. They are bound as they show up
+        bind(db_cardlist, cardlist_w);
+        cardlist_w->set_model(ui::CardListModel::create(db_cardlist));
+        m_loaded_cards[index] = db_cardlist->container().size();
+        m_loaded_units += db_cardlist->container().size();
+    } else {
+        cardlist_w->set_sensitive(false);
+    }
+
+    return cardlist_w;
+}
+
+void AppContext::load_card(size_t cardlist_index) {
+    const auto& db_cardlist =
+        m_current_board->container().get_data()[cardlist_index];
+    auto& card =
+        db_cardlist->container().get_data()[m_loaded_cards[cardlist_index]];
+
+    ui::CardWidget* card_widget = m_card_pool.acquire();
+    card_widget->detach();
+    refresh_card_widget(card, card_widget);
+    schedule_deadline_update(card_widget, card);
+    m_loaded_cardlists[cardlist_index]->append(*card_widget);
+    bind(card, card_widget);
+
+    m_loaded_cards[cardlist_index]++;
+    m_loaded_units++;
+}
+
 bool AppContext::idle_clear_session() {
     m_board_widget.pop();
     if (m_board_widget.empty()) {
         m_session_flags[Status::CLEARING] = false;
         m_session_flags[Status::BUSY] = false;
 
+        // Cards go first, cardlists may still hold some of them
+        const size_t cards_destroyed = m_card_pool.trim();
+        const size_t cardlists_destroyed = m_cardlist_pool.trim();
         spdlog::get("app")->debug(
-            "[AppContext.idle_clear_session] Board view is free");
+            "[AppContext.idle_clear_session] Board view is free. Pooled "
+            "widgets destroyed: {} cards, {} cardlists ({}/{} kept)",
+            cards_destroyed, cardlists_destroyed, m_card_pool.size(),
+            m_cardlist_pool.size());
         return false;
     }
 
@@ -863,32 +1405,22 @@ bool AppContext::timeout_save_session() {
 
 bool AppContext::timeout_update_cards() {
     if (m_session_flags[Status::BUSY]) {
-        const size_t size = m_cards.size();
-
-        if (m_cards.empty()) {
-            m_timeout_cards_update_cnn.disconnect();
-            spdlog::get("app")->debug(
-                "[AppContext.timeout_update_cards] Empty card queue. Stopping "
-                "timeout update task.");
-            return false;
+        // Late wake ups (e.g. after a system suspend) refresh everything that
+        // has been crossed in the meantime
+        const auto due_cards = m_deadlines.take_due(local_today());
+        for (ui::CardWidget* card_w : due_cards) {
+            card_w->update_deadline_label();
         }
 
-        if (m_next_card_i > size - 1) {
-            m_next_card_i = 0;
+        if (!due_cards.empty()) {
+            spdlog::get("app")->debug(
+                "[AppContext.timeout_update_cards] {} CardWidget(s) have had "
+                "their deadline label updated",
+                due_cards.size());
         }
 
-        auto card_w = m_cards[m_next_card_i];
-
-        card_w->update_deadline_label();
-
-        spdlog::get("app")->debug(
-            "[AppContext.timeout_update_cards] CardWidget \"{}\"'s UI has "
-            "been updated",
-            card_w->get_title());
-
-        m_next_card_i++;
-
-        return true;
+        arm_deadline_timer();
+        return false;
     }
 
     spdlog::get("app")->debug(
@@ -897,6 +1429,17 @@ bool AppContext::timeout_update_cards() {
     return false;
 }
 
+bool AppContext::timeout_midnight() {
+    if (m_session_flags[Status::BUSY]) {
+        // Waking up early (or late) is harmless: setting the same day again
+        // does nothing
+        m_card_filter.set_today(local_today());
+        m_board_stats.set_today(local_today());
+        arm_midnight_timer();
+    }
+    return false;
+}
+
 void AppContext::setup_board_widget() {
     m_board_widget.set_name(m_current_board->get_name());
     m_board_widget.set_background(m_current_board->get_background());
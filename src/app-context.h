@@ -6,13 +6,23 @@
 #include <widgets/card-widget.h>
 #include <widgets/cardlist-widget.h>
 
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stop_token>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+#include "core/binding-registry.h"
+#include "core/board-stats.h"
+#include "core/card-filter-index.h"
 #include "core/cardlist.h"
+#include "core/deadline-scheduler.h"
 #include "gtkmm/version.h"
 #include "widgets/task-widget.h"
+#include "widgets/widget-pool.h"
 
 namespace ui {
 class ProgressWindow;
@@ -20,6 +30,13 @@ class ProgressWindow;
 
 enum class Status { CLEARING, LOADING, BUSY };
 
+/**
+ * @brief Stages of the incremental session loading. VIEWPORT builds the first
+ * cards of every cardlist in the initial viewport, REST completes the cardlists
+ * in board order
+ */
+enum class LoadPhase { VIEWPORT, REST };
+
 /**
  * @brief Application controller class
  *
@@ -41,17 +58,53 @@ enum class Status { CLEARING, LOADING, BUSY };
 class AppContext {
 public:
     static constexpr int SAVE_INTERVAL = 1000 * 10;
-    static constexpr int UPDATE_INTERVAL = 1000 * 3;
+
+    /**
+     * @brief Longest time, in seconds, the deadline refresher sleeps before
+     * looking at the wall clock again. Timeouts do not advance while the
+     * system is suspended, so this bounds how late a boundary is noticed after
+     * resuming
+     */
+    static constexpr int DEADLINE_RECHECK_INTERVAL = 60 * 15;
+
+    /**
+     * @brief Time, in milliseconds, the session loader may spend building
+     * widgets in a single frame
+     */
+    static constexpr int LOAD_FRAME_BUDGET = 8;
+
+    /**
+     * @brief Lower bound for a card widget's height. Used to estimate how many
+     * cards fit in the initial viewport
+     */
+    static constexpr int LOAD_CARD_HEIGHT_HINT = 50;
+
+    /**
+     * @brief Largest number of card and cardlist widgets kept for the next
+     * session once a session is cleared
+     */
+    static constexpr size_t POOLED_CARDS = 512;
+    static constexpr size_t POOLED_CARDLISTS = 32;
 
     static ui::CardWidget* builder_card_widget(
         const std::shared_ptr<Card>& card);
 
+    /**
+     * @brief Updates a card widget so it displays the given card
+     */
+    static void refresh_card_widget(const std::shared_ptr<Card>& card,
+                                    ui::CardWidget* card_w);
+
     AppContext(ui::ProgressWindow& app_window, ui::BoardWidget& board_widget,
                BoardManager& manager);
+    ~AppContext();
 
     /**
      * @brief Starts a kanban board session
      *
+     * @details Any board load still in flight is cancelled and superseded by
+     * this request
+     *
      * @param filename file path where Progress board is located
      */
     void open_session(const std::string& filename);
@@ -62,6 +115,19 @@ public:
     void close_session();
 
 protected:
+    /**
+     * @brief Requests the loader worker thread to stop and releases whatever
+     * board it has loaded but not yet handed to the UI. The worker is not
+     * waited for: it is kept aside until reap_superseded_loads joins it
+     */
+    void cancel_pending_load();
+
+    /**
+     * @brief Closes the boards opened by superseded loader workers and joins
+     * the workers that have finished
+     */
+    void reap_superseded_loads();
+
     /**
      * @brief Resets to context's variables to an initial state
      */
@@ -85,7 +151,8 @@ protected:
      * @details Whenever the window is suspended, there is no need for further
      * UI updates since they won't be visible to the user. The proper solution
      * is to disconnect the procedure from the timeout signal whenever the
-     * window is minimised, and reconnect it when the window is maximised again
+     * window is minimised, and to catch up with the boundaries crossed in the
+     * meantime when it is shown again
      */
     void toggle_timeout_update_cards();
 
@@ -97,26 +164,95 @@ protected:
     void bind(const std::shared_ptr<Card>& db_card, ui::CardWidget* card_w);
     void bind(const std::shared_ptr<Task>& db_task, ui::TaskWidget* task_w);
 
+    /**
+     * @brief Drops every connection and reference kept for a card widget that
+     * no longer represents a card
+     */
+    void unbind(ui::CardWidget* card_w);
+
+    /**
+     * @brief Drops the bindings of a removed cardlist widget and of its cards
+     */
+    void unbind(ui::CardlistWidget* cardlist_w);
+
+    /**
+     * @brief Unbinds the card widgets of a dormant cardlist and hands them
+     * back to the pool
+     */
+    void release_cards(ui::CardlistWidget* cardlist_w);
+
+    /**
+     * @brief Rebuilds the card widgets of a cardlist released by
+     * release_cards, once it wakes up
+     */
+    void restore_cards(const std::shared_ptr<CardList>& db_cardlist,
+                       ui::CardlistWidget* cardlist_w);
+
     void clear_binds();
 
     /**
-     * @brief Pushs a card widget object pointer to the updating system queue.
-     * Also, the timeout update procedure is scheduled if it has been
-     * deactivated
-     * 
+     * @brief Shows the open board's statistics in the window's header bar
+     */
+    void show_board_stats();
+
+    /**
+     * @brief Schedules a card widget to be refreshed on the next day its
+     * deadline label changes, or drops it from the schedule if the label can
+     * no longer change
+     *
      * @param card_w card widget object pointer
+     * @param db_card card displayed by the widget
+     */
+    void schedule_deadline_update(ui::CardWidget* card_w,
+                                  const std::shared_ptr<Card>& db_card);
+
+    /**
+     * @brief Sets the refresher's timeout to the next deadline boundary, capped
+     * to DEADLINE_RECHECK_INTERVAL. Nothing is armed if no deadline can change
      */
-    void card_update_queue_push(ui::CardWidget* card_w);
+    void arm_deadline_timer();
+
+    /**
+     * @brief Sets a timeout to the next local midnight, capped to
+     * DEADLINE_RECHECK_INTERVAL, at which the card filter and the board
+     * statistics move to the new day. Unlike the deadline refresher, it is
+     * armed for as long as a session is open
+     */
+    void arm_midnight_timer();
 
     /**
      * @brief Save the current session if there is one
      * */
     bool on_window_closed();
 
-    bool idle_load_session();
+    /**
+     * @brief Frame clock callback building the session's widgets within
+     * LOAD_FRAME_BUDGET
+     */
+    bool tick_load_session(const Glib::RefPtr<Gdk::FrameClock>& frame_clock);
+
+    /**
+     * @brief Builds a single cardlist or card widget of the current session
+     *
+     * @return false once the session has been fully built
+     */
+    bool load_step();
+
+    /**
+     * @brief Returns the widget for the cardlist at the given index, creating
+     * it first if needed
+     */
+    ui::CardlistWidget* load_cardlist(size_t index);
+
+    /**
+     * @brief Builds the next card widget of an already created cardlist
+     */
+    void load_card(size_t cardlist_index);
+
     bool idle_clear_session();
     bool timeout_save_session();
     bool timeout_update_cards();
+    bool timeout_midnight();
 
     ui::ProgressWindow& m_app_window;
     ui::BoardWidget& m_board_widget;
@@ -130,9 +266,39 @@ protected:
     };
     BoardManager& m_manager;
     std::thread m_board_save_thread, m_board_load_thread;
+
+    // Loader worker context. The worker publishes its board together with the
+    // generation it was started for, so results of superseded requests are
+    // never turned into a session
+    std::stop_source m_load_stop_source;
+    std::stop_token m_session_token;
+    std::mutex m_load_mutex;
+    std::shared_ptr<Board> m_loaded_board;
+    bool m_load_ready = false;
+    unsigned long m_load_generation = 0, m_loaded_generation = 0;
+
+    // Workers superseded by a newer request, with their "finished" flags.
+    // Boards they opened anyway are handed back through m_superseded_boards
+    std::shared_ptr<std::atomic_bool> m_load_finished;
+    std::vector<std::pair<std::thread, std::shared_ptr<std::atomic_bool>>>
+        m_superseded_loads;
+    std::vector<std::shared_ptr<Board>> m_superseded_boards;
+
     Glib::Dispatcher m_load_board_dispatcher, m_save_board_dispatcher;
     sigc::connection m_timeout_save_cnn, m_timeout_cards_update_cnn,
-        m_idle_load_session_cnn;
+        m_timeout_midnight_cnn;
+
+    // Session loader context. A cardlist is only bound (and made sensitive)
+    // once all of its cards have been built
+    guint m_load_tick_id = 0;
+    LoadPhase m_load_phase = LoadPhase::VIEWPORT;
+    std::vector<ui::CardlistWidget*> m_loaded_cardlists;
+    std::vector<size_t> m_loaded_cards;
+    size_t m_viewport_cardlists = 0, m_viewport_cards = 0;
+    size_t m_load_units = 0, m_loaded_units = 0;
+    std::chrono::steady_clock::time_point m_load_start;
+    std::chrono::steady_clock::duration m_load_interactive{};
+    gint64 m_last_frame_time = 0, m_worst_frame_time = 0;
 
 #if GTKMM_CHECK_VERSION(4, 12, 0)
     sigc::connection m_suspended_tracker_cnn;
@@ -141,16 +307,41 @@ protected:
 #endif
 
     // BoardWidget Context
-    std::vector<sigc::scoped_connection> m_board_widget_cnns, m_cardlists_cnns,
-        m_cards_cnns, m_tasks_cnns, m_card_dialog_cnns;
-
-    std::unordered_map<ui::CardlistWidget*, std::shared_ptr<CardList>>
-        m_bound_cardlists;
-    std::unordered_map<ui::CardWidget*, std::shared_ptr<Card>> m_bound_cards;
-    std::unordered_map<ui::TaskWidget*, std::shared_ptr<Task>> m_bound_tasks;
-    std::vector<ui::CardWidget*> m_cards;
-    ssize_t m_next_card_i = 0;
-    ssize_t m_cardlist_i = 0;
+    std::vector<sigc::scoped_connection> m_board_widget_cnns,
+        m_card_dialog_cnns;
+
+    // Widgets are unbound as soon as they stop representing an item (removal,
+    // virtualized rows being recycled, card dialog closing), which releases
+    // their connections too
+    BindingRegistry<ui::CardlistWidget*, CardList> m_cardlist_bindings;
+    BindingRegistry<ui::CardWidget*, Card> m_card_bindings;
+    BindingRegistry<ui::TaskWidget*, Task> m_task_bindings;
+    DeadlineScheduler<ui::CardWidget*> m_deadlines;
+
+    // Quick filters only toggle the visibility of the widgets bound to the
+    // cards whose visibility changes
+    CardFilterIndex m_card_filter;
+    std::unordered_map<Card*, ui::CardWidget*> m_card_widgets;
+
+    // Card widgets bound to a card, by the cardlist widget holding them, so
+    // removing a cardlist does not walk every binding
+    std::unordered_map<ui::CardlistWidget*,
+                       std::unordered_set<ui::CardWidget*>>
+        m_cardlist_cards;
+    size_t m_cardlist_i = 0;
+
+    // Dormant cardlists whose card widgets went back to the pool
+    std::unordered_set<ui::CardlistWidget*> m_released_cardlists;
+
+    // Statistics follow the board's signals, so showing them never walks the
+    // cards
+    BoardStats m_board_stats;
+
+    // Widgets built by the session loader are recycled across sessions
+    // instead of being rebuilt. The card dialog keeps its own task widgets
+    ui::WidgetPool<ui::CardWidget> m_card_pool;
+    ui::WidgetPool<ui::CardlistWidget> m_cardlist_pool;
+    std::chrono::steady_clock::time_point m_switch_start;
 
 private:
     void setup_board_widget();
@@ -5,6 +5,7 @@
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/spdlog.h>
 #include <utils.h>
+#include <widgets/card-widget.h>
 
 #include <cstdlib>
 
@@ -44,22 +45,49 @@ void ui::Application::on_startup() {
         main_window->set_default_size(window_width, window_height);
     }
 
+    update_card_render_mode();
+    progress_settings->signal_changed("card-render-mode")
+        .connect(sigc::hide(
+            sigc::mem_fun(*this, &Application::update_card_render_mode)));
+
+    // Also loads the caches' indexes before any image is requested
+    update_image_cache_size();
+    progress_settings->signal_changed("image-cache-size")
+        .connect(sigc::hide(
+            sigc::mem_fun(*this, &Application::update_image_cache_size)));
+
     add_window(*main_window);
 }
 
+void ui::Application::update_card_render_mode() {
+    const bool drawn =
+        progress_settings->get_string("card-render-mode") == "drawn";
+    ui::CardWidget::set_default_render_mode(
+        drawn ? ui::CardRenderMode::DRAWN : ui::CardRenderMode::WIDGETS);
+    spdlog::get("app")->info("Cards are rendered as {}",
+                             drawn ? "drawn cards" : "widget trees");
+}
+
+void ui::Application::update_image_cache_size() {
+    const uintmax_t size =
+        uintmax_t(progress_settings->get_int("image-cache-size")) * 1024 * 1024;
+    background_cache().set_max_size(size);
+    thumbnail_cache().set_max_size(size);
+    spdlog::get("app")->info("Image caches are capped to {} MiB each",
+                             size / (1024 * 1024));
+}
+
 void ui::Application::on_activate() {
     Gtk::Application::on_activate();
     main_window->set_visible();
     // FIXME:
-    // Scheduling an idle task that'll check whether all boards were loaded
-    // before actually loading them into the application. This workaround works
+    // Scheduling an idle task that'll check whether all boards were listed
+    // before actually showing them in the application. This workaround works
     // but it can be enhanced by improving the core itself to be thread-safe.
     Glib::signal_idle().connect(
         [this]() {
             if (m_manager.loaded()) {
-                for (const auto& local_entry : m_manager.local_boards()) {
-                    main_window->add_local_board_entry(local_entry);
-                }
+                main_window->load_local_boards();
                 return false;
             } else {
                 return true;
@@ -26,6 +26,18 @@ protected:
     void on_startup() override;
     void on_activate() override;
 
+    /**
+     * @brief Applies the "card-render-mode" setting to the cards built from
+     * now on
+     */
+    void update_card_render_mode();
+
+    /**
+     * @brief Applies the "image-cache-size" setting to the background and
+     * thumbnail caches
+     */
+    void update_image_cache_size();
+
     BoardManager m_manager;
     ProgressWindow* main_window = nullptr;
     Glib::RefPtr<Gio::Settings> progress_settings;
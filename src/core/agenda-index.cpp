@@ -0,0 +1,260 @@
+#include "agenda-index.h"
+
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+#include "field-escape.h"
+#include "file-stamp.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+constexpr const char* AGENDA_FILE_HEADER = "progress-agenda 2";
+
+/**
+ * @brief Parses a YYYY-MM-DD date
+ *
+ * @return an invalid date if text is not a valid date
+ */
+Date parse_date(std::string_view text) {
+    int year = 0;
+    unsigned month = 0, day = 0;
+    if (text.size() != 10 || text[4] != '-' || text[7] != '-' ||
+        std::from_chars(text.data(), text.data() + 4, year).ptr !=
+            text.data() + 4 ||
+        std::from_chars(text.data() + 5, text.data() + 7, month).ptr !=
+            text.data() + 7 ||
+        std::from_chars(text.data() + 8, text.data() + 10, day).ptr !=
+            text.data() + 10) {
+        return Date{};
+    }
+    return Date{std::chrono::year{year}, std::chrono::month{month},
+                std::chrono::day{day}};
+}
+}  // namespace
+
+std::string AgendaIndex::agenda_filename(const std::string& filename) {
+    return fs::path{filename}.replace_extension(".agenda").string();
+}
+
+void AgendaIndex::update(const std::string& filename, Board& board,
+                         const std::string& stamp) {
+    const std::string board_stamp =
+        stamp.empty() ? file_stamp(filename) : stamp;
+    std::vector<AgendaEntry> entries;
+    for (const auto& cardlist : board.container()) {
+        for (const auto& card : cardlist->container()) {
+            if (card->get_due_date().ok()) {
+                entries.push_back(AgendaEntry{
+                    filename, "", card->get_id().str(), card->get_name(),
+                    card->get_due_date(), card->get_complete()});
+            }
+        }
+    }
+
+    std::ostringstream summary;
+    summary << AGENDA_FILE_HEADER << '\t' << board_stamp << '\t'
+            << escape_field(board.get_name()) << '\n';
+    for (const AgendaEntry& entry : entries) {
+        summary << std::format("{}", entry.due) << '\t' << entry.complete
+                << '\t' << entry.card_id << '\t'
+                << escape_field(entry.card_name) << '\n';
+    }
+
+    std::lock_guard<std::mutex> file_lg{m_file_mutex};
+    const std::string stored = agenda_filename(filename);
+    std::ofstream agenda_file{stored, std::ios::binary | std::ios::trunc};
+    agenda_file << summary.str();
+    agenda_file.close();
+    if (agenda_file.fail()) {
+        // A partial summary would be trusted on the next start
+        std::error_code ec;
+        fs::remove(stored, ec);
+    }
+
+    std::lock_guard<std::mutex> lg{m_mutex};
+    index(filename, board.get_name(), board_stamp, std::move(entries));
+}
+
+bool AgendaIndex::load(const std::string& filename) {
+    std::lock_guard<std::mutex> file_lg{m_file_mutex};
+    const std::string stamp = file_stamp(filename);
+    if (stamp.empty()) {
+        return false;
+    }
+
+    // The header holds the stamp of the board file and the board's name
+    std::ifstream agenda_file{agenda_filename(filename), std::ios::binary};
+    std::string line;
+    const std::string header =
+        std::format("{}\t{}\t", AGENDA_FILE_HEADER, stamp);
+    if (!std::getline(agenda_file, line) || !line.starts_with(header)) {
+        return false;
+    }
+    const std::string board_name = unescape_field(line.substr(header.size()));
+
+    std::vector<AgendaEntry> entries;
+    while (std::getline(agenda_file, line)) {
+        // due, complete, card id and card name
+        const size_t complete_start = line.find('\t');
+        const size_t id_start = complete_start == std::string::npos
+                                    ? std::string::npos
+                                    : line.find('\t', complete_start + 1);
+        const size_t name_start = id_start == std::string::npos
+                                      ? std::string::npos
+                                      : line.find('\t', id_start + 1);
+        if (name_start == std::string::npos ||
+            id_start != complete_start + 2) {
+            return false;
+        }
+
+        const Date due =
+            parse_date(std::string_view{line}.substr(0, complete_start));
+        if (!due.ok()) {
+            return false;
+        }
+        entries.push_back(AgendaEntry{
+            filename, "", line.substr(id_start + 1, name_start - id_start - 1),
+            unescape_field(line.substr(name_start + 1)), due,
+            line[complete_start + 1] == '1'});
+    }
+
+    std::lock_guard<std::mutex> lg{m_mutex};
+    index(filename, board_name, stamp, std::move(entries));
+    return true;
+}
+
+void AgendaIndex::remove(const std::string& filename) {
+    std::lock_guard<std::mutex> file_lg{m_file_mutex};
+    {
+        std::lock_guard<std::mutex> lg{m_mutex};
+        drop(filename);
+    }
+
+    std::error_code ec;
+    fs::remove(agenda_filename(filename), ec);
+}
+
+Agenda AgendaIndex::agenda(const Date& today, unsigned days,
+                           bool include_complete) const {
+    const std::chrono::sys_days day{today};
+    const std::chrono::sys_days tomorrow = day + std::chrono::days{1};
+    const std::chrono::sys_days end = tomorrow + std::chrono::days{days};
+
+    std::lock_guard<std::mutex> lg{m_mutex};
+    Agenda agenda;
+    agenda.overdue =
+        between(m_incomplete, std::chrono::sys_days::min(), day);
+
+    const auto due_between = [this, include_complete](
+                                 std::chrono::sys_days from,
+                                 std::chrono::sys_days to) {
+        std::vector<AgendaEntry> incomplete = between(m_incomplete, from, to);
+        if (!include_complete) {
+            return incomplete;
+        }
+
+        const std::vector<AgendaEntry> complete = between(m_complete, from, to);
+        std::vector<AgendaEntry> entries;
+        entries.reserve(incomplete.size() + complete.size());
+        std::merge(incomplete.begin(), incomplete.end(), complete.begin(),
+                   complete.end(), std::back_inserter(entries),
+                   [](const AgendaEntry& a, const AgendaEntry& b) {
+                       return std::chrono::sys_days{a.due} <
+                              std::chrono::sys_days{b.due};
+                   });
+        return entries;
+    };
+    agenda.today = due_between(day, tomorrow);
+    agenda.upcoming = due_between(tomorrow, end);
+    return agenda;
+}
+
+size_t AgendaIndex::n_overdue(const std::string& filename,
+                              const Date& today) const {
+    std::lock_guard<std::mutex> lg{m_mutex};
+    auto board = m_boards.find(filename);
+    if (board == m_boards.end()) {
+        return 0;
+    }
+    return std::count_if(board->second.incomplete.begin(),
+                         board->second.incomplete.end(),
+                         [day = std::chrono::sys_days{today}](
+                             const Dates::iterator& it) {
+                             return it->first < day;
+                         });
+}
+
+bool AgendaIndex::contains(const std::string& filename) const {
+    std::lock_guard<std::mutex> lg{m_mutex};
+    return m_boards.contains(filename);
+}
+
+bool AgendaIndex::up_to_date(const std::string& filename,
+                             const std::string& stamp) const {
+    std::lock_guard<std::mutex> lg{m_mutex};
+    auto it = m_boards.find(filename);
+    return it != m_boards.end() && !stamp.empty() && it->second.stamp == stamp;
+}
+
+size_t AgendaIndex::n_boards() const {
+    std::lock_guard<std::mutex> lg{m_mutex};
+    return m_boards.size();
+}
+
+size_t AgendaIndex::n_cards() const {
+    std::lock_guard<std::mutex> lg{m_mutex};
+    return m_incomplete.size() + m_complete.size();
+}
+
+void AgendaIndex::index(const std::string& filename,
+                        const std::string& board_name,
+                        const std::string& stamp,
+                        std::vector<AgendaEntry> entries) {
+    drop(filename);
+
+    IndexedBoard& board = m_boards[filename];
+    board.name = board_name;
+    board.stamp = stamp;
+    for (AgendaEntry& entry : entries) {
+        const std::chrono::sys_days due{entry.due};
+        if (entry.complete) {
+            board.complete.push_back(m_complete.emplace(due, std::move(entry)));
+        } else {
+            board.incomplete.push_back(
+                m_incomplete.emplace(due, std::move(entry)));
+        }
+    }
+}
+
+void AgendaIndex::drop(const std::string& filename) {
+    auto board = m_boards.find(filename);
+    if (board == m_boards.end()) {
+        return;
+    }
+
+    for (const Dates::iterator it : board->second.incomplete) {
+        m_incomplete.erase(it);
+    }
+    for (const Dates::iterator it : board->second.complete) {
+        m_complete.erase(it);
+    }
+    m_boards.erase(board);
+}
+
+std::vector<AgendaEntry> AgendaIndex::between(
+    const Dates& dates, std::chrono::sys_days from,
+    std::chrono::sys_days to) const {
+    std::vector<AgendaEntry> entries;
+    for (auto it = dates.lower_bound(from), end = dates.lower_bound(to);
+         it != end; it++) {
+        AgendaEntry& entry = entries.emplace_back(it->second);
+        entry.board_name = m_boards.at(entry.filename).name;
+    }
+    return entries;
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "board.h"
+
+/**
+ * @brief Dated card of some board
+ */
+struct AgendaEntry {
+    /**
+     * @brief File of the board the card is part of
+     */
+    std::string filename;
+    std::string board_name;
+    std::string card_id;
+    std::string card_name;
+    Date due;
+    bool complete;
+};
+
+/**
+ * @brief Dated cards of every board, grouped the way the agenda shows them.
+ * Every group is sorted by due date
+ */
+struct Agenda {
+    /**
+     * @brief Incomplete cards due before today
+     */
+    std::vector<AgendaEntry> overdue;
+
+    /**
+     * @brief Cards due today
+     */
+    std::vector<AgendaEntry> today;
+
+    /**
+     * @brief Cards due after today, within the requested number of days
+     */
+    std::vector<AgendaEntry> upcoming;
+};
+
+/**
+ * @brief Due date summary of many boards.
+ *
+ * @details Only dated cards are kept: their due date, completion state, id and
+ * name. Cards are kept sorted by due date, incomplete and complete cards
+ * apart, so an agenda query only walks the cards it returns.
+ *
+ * The summary of each board is stored next to the board file, in a file with
+ * the same name and an ".agenda" extension, along with the file_stamp() of the
+ * board file it was made from. It is trusted as long as the board file keeps
+ * that stamp, so no board has to be loaded to answer a query.
+ *
+ * All methods are thread-safe. Stored summaries are written and read one board
+ * at a time, along with the matching change to the index.
+ */
+class AgendaIndex {
+public:
+    /**
+     * @brief Returns where the summary of a board file is stored
+     */
+    static std::string agenda_filename(const std::string& filename);
+
+    /**
+     * @brief Summarises a fully loaded board, replacing what was kept for its
+     * file, and stores the summary next to the board file
+     *
+     * @param stamp file_stamp() of the board file taken before the board was
+     * read. When empty, the board file's current stamp is used
+     */
+    void update(const std::string& filename, Board& board,
+                const std::string& stamp = "");
+
+    /**
+     * @brief Reads the summary stored next to a board file
+     *
+     * @return false if there is no stored summary or if the board file was
+     * written since. The board has to be updated then
+     */
+    bool load(const std::string& filename);
+
+    /**
+     * @brief Drops a board and deletes its stored summary
+     */
+    void remove(const std::string& filename);
+
+    /**
+     * @brief Returns the overdue cards, the cards due today and the cards due
+     * in the next days
+     *
+     * @param days number of days after today looked at for upcoming cards
+     * @param include_complete whether complete cards due today or later are
+     * returned as well
+     */
+    Agenda agenda(const Date& today, unsigned days = 7,
+                  bool include_complete = true) const;
+
+    /**
+     * @brief Returns the number of incomplete cards of a board due before
+     * today. Only that board's cards are walked
+     */
+    size_t n_overdue(const std::string& filename, const Date& today) const;
+
+    /**
+     * @brief Returns whether a board file is summarised
+     */
+    bool contains(const std::string& filename) const;
+
+    /**
+     * @brief Returns whether a board file is summarised from its contents as
+     * of the given file_stamp()
+     */
+    bool up_to_date(const std::string& filename,
+                    const std::string& stamp) const;
+
+    size_t n_boards() const;
+
+    /**
+     * @brief Number of dated cards, complete or not
+     */
+    size_t n_cards() const;
+
+protected:
+    using Dates = std::multimap<std::chrono::sys_days, AgendaEntry>;
+
+    struct IndexedBoard {
+        std::string name, stamp;
+        std::vector<Dates::iterator> incomplete, complete;
+    };
+
+    /**
+     * @brief Replaces the cards of a board. The mutex must be held
+     */
+    void index(const std::string& filename, const std::string& board_name,
+               const std::string& stamp, std::vector<AgendaEntry> entries);
+
+    /**
+     * @brief Drops the cards of a board. The mutex must be held
+     */
+    void drop(const std::string& filename);
+
+    /**
+     * @brief Returns the cards due in [from, to), with their board's name.
+     * The mutex must be held
+     */
+    std::vector<AgendaEntry> between(const Dates& dates,
+                                     std::chrono::sys_days from,
+                                     std::chrono::sys_days to) const;
+
+    // Held while summaries are written or read, before m_mutex, so they
+    // always match the index
+    std::mutex m_file_mutex;
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, IndexedBoard> m_boards;
+    Dates m_incomplete, m_complete;
+};
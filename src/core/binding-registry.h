@@ -0,0 +1,101 @@
+#pragma once
+
+#include <sigc++/sigc++.h>
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Keeps track of which model object each widget represents, together
+ * with the signal connections made for that pairing.
+ *
+ * @details Connections belong to the binding they were added to: they are
+ * disconnected, and the slots (along with whatever they capture) released, as
+ * soon as the binding is dropped. Binding, looking up and unbinding a widget
+ * are all O(1).
+ */
+template <typename Key, typename Model>
+class BindingRegistry {
+public:
+    struct Binding {
+        std::shared_ptr<Model> model;
+        std::vector<sigc::scoped_connection> connections;
+    };
+
+    /**
+     * @brief Binds a key to a model object. Any previous binding of the key is
+     * dropped first
+     */
+    void bind(Key key, const std::shared_ptr<Model>& model) {
+        Binding& binding = m_bindings[key];
+        binding.connections.clear();
+        binding.model = model;
+    }
+
+    /**
+     * @brief Ties a connection to the key's binding. Connections made for keys
+     * that are not bound are disconnected right away
+     */
+    void add_connection(Key key, sigc::connection connection) {
+        auto it = m_bindings.find(key);
+        if (it == m_bindings.end()) {
+            connection.disconnect();
+            return;
+        }
+        it->second.connections.emplace_back(std::move(connection));
+    }
+
+    /**
+     * @brief Returns the connections tied to the key's binding. The key must be
+     * bound
+     */
+    std::vector<sigc::scoped_connection>& connections(Key key) {
+        return m_bindings.at(key).connections;
+    }
+
+    /**
+     * @brief Drops the key's binding and disconnects its connections
+     *
+     * @return false if the key was not bound
+     */
+    bool unbind(Key key) { return m_bindings.erase(key); }
+
+    /**
+     * @brief Returns the model object bound to the key, or nullptr if the key
+     * is not bound
+     */
+    std::shared_ptr<Model> model(Key key) const {
+        auto it = m_bindings.find(key);
+        return it != m_bindings.end() ? it->second.model : nullptr;
+    }
+
+    bool contains(Key key) const { return m_bindings.contains(key); }
+
+    /**
+     * @brief Number of live bindings
+     */
+    size_t size() const { return m_bindings.size(); }
+
+    /**
+     * @brief Number of connections still connected across every binding. Meant
+     * for diagnostics, as it walks every connection
+     */
+    size_t n_connections() const {
+        size_t n = 0;
+        for (const auto& [key, binding] : m_bindings) {
+            for (const auto& connection : binding.connections) {
+                n += connection.connected() ? 1 : 0;
+            }
+        }
+        return n;
+    }
+
+    void clear() { m_bindings.clear(); }
+
+    auto begin() const { return m_bindings.begin(); }
+    auto end() const { return m_bindings.end(); }
+
+protected:
+    std::unordered_map<Key, Binding> m_bindings;
+};
@@ -2,12 +2,18 @@
 
 #include <app_info.h>
 
+#include <algorithm>
 #include <cstdlib>
 #include <filesystem>
+#include <fstream>
 #include <memory>
 #include <regex>
+#include <sstream>
 #include <thread>
 
+#include "board-stats.h"
+#include "file-stamp.h"
+
 namespace fs = std::filesystem;
 
 #ifdef DEVELOPMENT
@@ -44,20 +50,135 @@ std::string gen_filename(const std::string& boards_dir, const Board& board) {
     std::string filename = "";
 
     if (fs::exists(boards_dir)) {
-        filename = boards_dir + board.get_id().str() + ".xml";
+        const std::string id = board.get_id().str();
+        filename = (fs::path{boards_dir} /
+                    id.substr(0, BoardManager::SHARD_PREFIX_LENGTH) /
+                    (id + ".xml"))
+                       .string();
     }
 
     return filename;
 }
 
+/**
+ * @brief Returns the start tag of the board element, turned into an empty
+ * element so it can be parsed on its own. Only the beginning of the file is
+ * read
+ *
+ * @return an empty string if the file has no board element
+ */
+std::string board_start_tag(const std::string& filename) {
+    std::ifstream file{filename, std::ios::binary};
+    std::string buffer;
+    char chunk[4096];
+
+    size_t tag_start = std::string::npos, scanned = 0;
+    char quote = 0;
+    while (file.read(chunk, sizeof(chunk)) || file.gcount() > 0) {
+        buffer.append(chunk, file.gcount());
+
+        if (tag_start == std::string::npos) {
+            tag_start = buffer.find("<board");
+            if (tag_start == std::string::npos) {
+                continue;
+            }
+            scanned = tag_start;
+        }
+
+        // Attribute values may hold a '>' of their own
+        for (; scanned < buffer.size(); scanned++) {
+            const char c = buffer[scanned];
+            if (quote) {
+                quote = c == quote ? 0 : quote;
+            } else if (c == '"' || c == '\'') {
+                quote = c;
+            } else if (c == '>') {
+                std::string tag = buffer.substr(tag_start, scanned - tag_start);
+                if (!tag.ends_with('/')) {
+                    tag += '/';
+                }
+                return tag + '>';
+            }
+        }
+    }
+    return "";
+}
+
+/**
+ * @brief Stores the board statistics as attributes of the board element
+ */
+void write_stats(tinyxml2::XMLElement* board_element, const CardStats& stats) {
+    board_element->SetAttribute("cards", static_cast<unsigned>(stats.n_cards));
+    board_element->SetAttribute("complete",
+                                static_cast<unsigned>(stats.n_complete));
+    board_element->SetAttribute("tasks", static_cast<unsigned>(stats.n_tasks));
+    board_element->SetAttribute("tasks-done",
+                                static_cast<unsigned>(stats.n_tasks_done));
+
+    // e.g. "rgb(165,29,45)=2 rgba(0,0,0,0.000000)=5"
+    std::string colors;
+    for (const auto& [color, n] : stats.n_colors) {
+        colors += std::format("{}{}={}", colors.empty() ? "" : " ",
+                              color_to_string(color), n);
+    }
+    board_element->SetAttribute("colors", colors.c_str());
+}
+
+/**
+ * @brief Reads the board statistics stored by write_stats
+ *
+ * @return an empty optional if they are missing or malformed
+ */
+std::optional<CardStats> read_stats(const tinyxml2::XMLElement* board_element) {
+    CardStats stats;
+    unsigned n_cards, n_complete, n_tasks, n_tasks_done;
+    const char* colors = board_element->Attribute("colors");
+    if (!colors ||
+        board_element->QueryUnsignedAttribute("cards", &n_cards) !=
+            tinyxml2::XML_SUCCESS ||
+        board_element->QueryUnsignedAttribute("complete", &n_complete) !=
+            tinyxml2::XML_SUCCESS ||
+        board_element->QueryUnsignedAttribute("tasks", &n_tasks) !=
+            tinyxml2::XML_SUCCESS ||
+        board_element->QueryUnsignedAttribute("tasks-done", &n_tasks_done) !=
+            tinyxml2::XML_SUCCESS) {
+        return std::nullopt;
+    }
+    stats.n_cards = n_cards;
+    stats.n_complete = n_complete;
+    stats.n_tasks = n_tasks;
+    stats.n_tasks_done = n_tasks_done;
+
+    std::istringstream color_counts{colors};
+    std::string color_count;
+    try {
+        while (color_counts >> color_count) {
+            const size_t separator = color_count.rfind('=');
+            if (separator == std::string::npos) {
+                return std::nullopt;
+            }
+            stats.n_colors[string_to_color(color_count.substr(0, separator))] +=
+                std::stoull(color_count.substr(separator + 1));
+        }
+    } catch (std::exception& err) {
+        return std::nullopt;
+    }
+    return stats;
+}
+
 std::shared_ptr<Board> unitialized_board(const std::string& filename) {
     if (!fs::exists(filename))
         throw std::invalid_argument{std::format(
             "Progress Board XML file given does not exist: {}", filename)};
 
+    // The board's metadata is all in the board element's attributes. Lists
+    // and cards are left for full_load
+    const std::string start_tag = board_start_tag(filename);
     tinyxml2::XMLDocument doc;
 
-    auto error_code = doc.LoadFile(filename.c_str());
+    auto error_code = start_tag.empty()
+                          ? tinyxml2::XML_ERROR_EMPTY_DOCUMENT
+                          : doc.Parse(start_tag.c_str(), start_tag.size());
     if (error_code != 0) {
         throw std::invalid_argument{
             std::format("Failed to load Progress Board XML file given: {}\n"
@@ -106,12 +227,19 @@ std::shared_ptr<Board> unitialized_board(const std::string& filename) {
         std::filesystem::last_write_time(filename));
     board->m_last_modified =
         std::chrono::floor<std::chrono::seconds>(lm_filepath);
+    board->m_saved_stats = read_stats(board_element);
 
     return board;
 }
 
-void full_load(const std::string& filename,
-               const std::shared_ptr<Board>& board) {
+/**
+ * @brief Loads every list, card and task of a board file into board
+ *
+ * @return false if loading was cancelled through token. In that case, the
+ * board's container is left empty
+ */
+bool full_load(const std::string& filename, const std::shared_ptr<Board>& board,
+               std::stop_token token) {
     tinyxml2::XMLDocument doc;
     tinyxml2::XMLError status = doc.LoadFile(filename.c_str());
     if (status != tinyxml2::XML_SUCCESS) {
@@ -125,6 +253,11 @@ void full_load(const std::string& filename,
         doc.FirstChildElement("board")->FirstChildElement("list");
 
     while (list_element) {
+        if (token.stop_requested()) {
+            board->container().get_data().clear();
+            return false;
+        }
+
         auto cur_cardlist_name = list_element->Attribute("name");
         auto cur_cardlist_uuid = list_element->Attribute("uuid");
 
@@ -141,6 +274,11 @@ void full_load(const std::string& filename,
         auto card_element = list_element->FirstChildElement("card");
 
         while (card_element) {
+            if (token.stop_requested()) {
+                board->container().get_data().clear();
+                return false;
+            }
+
             auto cur_card_name = card_element->Attribute("name");
             auto cur_card_color = card_element->Attribute("color");
             auto cur_card_due_date = card_element->Attribute("due");
@@ -212,6 +350,7 @@ void full_load(const std::string& filename,
 
     board->modify(false);
     board->container().modify(false);
+    return true;
 }
 
 BoardManager::BoardManager() : BoardManager{progress_boards_folder()} {}
@@ -224,8 +363,8 @@ BoardManager::BoardManager(const std::string& board_dir)
     }
 
     // FIXME: The current state of the core is incomplete.
-    std::thread([this]() {
-        std::lock_guard<std::mutex> valid_mutex_guard(this->valid_mutex);
+    m_loading_thread = std::jthread([this](std::stop_token token) {
+        std::unique_lock<std::mutex> valid_mutex_guard(this->valid_mutex);
 
         // We only need to perform this check on Linux environments since this
         // version is still loading from %APPDATA%
@@ -244,57 +383,156 @@ BoardManager::BoardManager(const std::string& board_dir)
         }
 #endif
 
-        for (const auto& dir_entry :
-             std::filesystem::directory_iterator(BOARD_DIR)) {
-            const std::string board_filename = dir_entry.path().string();
-            if (board_filename.ends_with(".xml")) {
-                try {
-                    m_local_boards.push_back(
-                        LocalBoard{board_filename,
-                                   unitialized_board(board_filename), false});
-                } catch (std::invalid_argument& err) {
-                    // error loading board: keep going
+        // Boards are only listed here. Reading them is left to
+        // local_next_page
+        std::vector<PendingBoard> found;
+        std::vector<fs::path> index_files;
+        auto find_board = [&](const fs::directory_entry& dir_entry) {
+            if (!dir_entry.is_regular_file()) {
+                return;
+            }
+            if (dir_entry.path().extension() == ".xml") {
+                found.push_back(PendingBoard{dir_entry.path().string(),
+                                             dir_entry.last_write_time()});
+            } else if (dir_entry.path().extension() == ".search" ||
+                       dir_entry.path().extension() == ".agenda") {
+                index_files.push_back(dir_entry.path());
+            }
+        };
+        for (const auto& dir_entry : fs::directory_iterator(BOARD_DIR)) {
+            if (dir_entry.is_directory()) {
+                if (dir_entry.path().filename().string().size() ==
+                    SHARD_PREFIX_LENGTH) {
+                    for (const auto& shard_entry :
+                         fs::directory_iterator(dir_entry.path())) {
+                        find_board(shard_entry);
+                    }
                 }
+            } else {
+                find_board(dir_entry);
             }
         }
+        std::sort(found.begin(), found.end(),
+                  [](const PendingBoard& a, const PendingBoard& b) {
+                      return a.modified < b.modified;
+                  });
+        {
+            std::lock_guard<std::mutex> lg{m_boards_mutex};
+            m_pending_boards = found;
+        }
         m_loaded = true;
-    }).detach();
+        valid_mutex_guard.unlock();
+
+        // Search texts and summaries of boards deleted outside of the
+        // application
+        for (const fs::path& index_file : index_files) {
+            fs::path board_file = index_file;
+            board_file.replace_extension(".xml");
+            if (!fs::exists(board_file)) {
+                std::error_code ec;
+                fs::remove(index_file, ec);
+            }
+        }
+
+        __index_boards(found, token);
+        {
+            std::lock_guard<std::mutex> lg{m_index_mutex};
+            m_indexed = !token.stop_requested();
+        }
+        __index_queued(token);
+    });
 }
 
-std::shared_ptr<Board> BoardManager::local_open(const std::string& filename) {
-    for (auto it = m_local_boards.begin(); it != m_local_boards.end(); it++) {
-        if (it->filename == filename) {
-            try {
-                if (!it->is_open) {
-                    full_load(filename, it->board);
-                    it->is_open = true;
-                }
-                return it->board;
-            } catch (std::invalid_argument& err) {
-                // TODO: Signaling may be good to show a dialog where the error
-                // was since it does not mean that the file is corrupted, it
-                // just means the file is not well-formed
-
-                break;
-            } catch (std::runtime_error& err) {
-                // File has been deleted at the time for reading, delete the
-                // entry as well
-                remove_board_signal.emit(*it);
-                m_local_boards.erase(it);
-                break;
+std::shared_ptr<Board> BoardManager::local_open(const std::string& filename,
+                                                std::stop_token token) {
+    // Nothing is done for boards enumerated already
+    local_enumerate(filename);
+
+    const auto find_local = [this, &filename]() {
+        return std::find_if(m_local_boards.begin(), m_local_boards.end(),
+                            [&filename](const LocalBoard& local_board) {
+                                return local_board.filename == filename;
+                            });
+    };
+
+    std::unique_lock<std::mutex> lock{m_boards_mutex};
+    auto it = find_local();
+    if (it == m_local_boards.end()) {
+        return nullptr;
+    }
+    LocalBoard local_board = *it;
+    lock.unlock();
+
+    // The board is read without holding the lock, so enumerating boards is
+    // not held up meanwhile
+    try {
+        if (!local_board.is_open) {
+            if (!full_load(filename, local_board.board, token)) {
+                return nullptr;
+            }
+            lock.lock();
+            it = find_local();
+            if (it != m_local_boards.end()) {
+                it->is_open = true;
             }
         }
+        return local_board.board;
+    } catch (std::invalid_argument& err) {
+        // TODO: Signaling may be good to show a dialog where the error
+        // was since it does not mean that the file is corrupted, it
+        // just means the file is not well-formed
+    } catch (std::runtime_error& err) {
+        // File has been deleted at the time for reading, delete the
+        // entry as well
+        lock.lock();
+        it = find_local();
+        if (it != m_local_boards.end()) {
+            m_local_boards.erase(it);
+        }
+        lock.unlock();
+        remove_board_signal.emit(local_board);
     }
     return nullptr;
 }
 
-const std::vector<LocalBoard>& BoardManager::local_boards() const {
+std::vector<LocalBoard> BoardManager::local_boards() const {
     if (!loaded()) {
         throw std::logic_error{"Board is not valid"};
     }
+    std::lock_guard<std::mutex> lg{m_boards_mutex};
     return m_local_boards;
 }
 
+std::vector<LocalBoard> BoardManager::local_next_page(size_t count) {
+    std::vector<LocalBoard> page;
+    if (!loaded()) {
+        return page;
+    }
+
+    std::lock_guard<std::mutex> lg{m_boards_mutex};
+    while (page.size() < count && !m_pending_boards.empty()) {
+        const std::string filename = m_pending_boards.back().filename;
+        m_pending_boards.pop_back();
+        try {
+            LocalBoard local_board{filename, unitialized_board(filename),
+                                   false};
+            m_local_boards.push_back(local_board);
+            page.push_back(local_board);
+        } catch (std::invalid_argument& err) {
+            // error loading board: keep going
+        }
+    }
+    return page;
+}
+
+size_t BoardManager::local_count() const {
+    if (!loaded()) {
+        throw std::logic_error{"Board is not valid"};
+    }
+    std::lock_guard<std::mutex> lg{m_boards_mutex};
+    return m_local_boards.size() + m_pending_boards.size();
+}
+
 std::string BoardManager::local_add(const std::string& name,
                                     const std::string& background) {
     Board board{name, background};
@@ -302,32 +540,44 @@ std::string BoardManager::local_add(const std::string& name,
     LocalBoard local_board{board_filename, std::make_shared<Board>(board),
                            false};
     __local_save(local_board);
+    __queue_index(board_filename, true);
 
-    m_local_boards.push_back(local_board);
+    {
+        std::lock_guard<std::mutex> lg{m_boards_mutex};
+        m_local_boards.push_back(local_board);
+    }
     add_board_signal.emit(local_board);
 
     return board_filename;
 }
 
 void BoardManager::local_remove(const std::shared_ptr<Board>& board) {
-    if (loaded())
-        for (auto it = m_local_boards.begin(); it != m_local_boards.end();
-             it++) {
-            LocalBoard local_board = *it;
-            if (*(local_board.board) == *board) {
-                m_local_boards.erase(it);
-                fs::remove(local_board.filename);
-                remove_board_signal.emit(local_board);
-                return;
-            }
+    if (!loaded()) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock{m_boards_mutex};
+    for (auto it = m_local_boards.begin(); it != m_local_boards.end(); it++) {
+        LocalBoard local_board = *it;
+        if (*(local_board.board) == *board) {
+            m_local_boards.erase(it);
+            lock.unlock();
+            fs::remove(local_board.filename);
+            __queue_index(local_board.filename);
+            remove_board_signal.emit(local_board);
+            return;
         }
+    }
 }
 
 void BoardManager::local_save(const std::shared_ptr<Board>& board) {
+    std::unique_lock<std::mutex> lock{m_boards_mutex};
     for (auto it = m_local_boards.begin(); it != m_local_boards.end(); it++) {
         LocalBoard local_board = *it;
         if (*(local_board.board) == *board && board->modified()) {
+            lock.unlock();
             __local_save(local_board);
+            __queue_index(local_board.filename, true);
             save_board_signal.emit(local_board);
             return;
         }
@@ -335,6 +585,7 @@ void BoardManager::local_save(const std::shared_ptr<Board>& board) {
 }
 
 void BoardManager::local_close(const std::shared_ptr<Board>& board) {
+    std::lock_guard<std::mutex> lg{m_boards_mutex};
     for (auto it = m_local_boards.begin(); it != m_local_boards.end(); it++) {
         if (*(it->board) == *board) {
             (*it).is_open = false;
@@ -349,6 +600,48 @@ bool BoardManager::loaded() const {
     return m_loaded;
 }
 
+std::vector<SearchHit> BoardManager::search(const std::string& query,
+                                            SearchMode mode,
+                                            size_t max_hits) const {
+    return m_search_index.search(query, mode, max_hits);
+}
+
+bool BoardManager::search_ready() const {
+    std::lock_guard<std::mutex> lg{m_index_mutex};
+    return m_indexed && m_index_queue.empty() && !m_indexing;
+}
+
+Agenda BoardManager::agenda(const Date& today, unsigned days) const {
+    return m_agenda_index.agenda(today, days);
+}
+
+bool BoardManager::agenda_ready() const { return search_ready(); }
+
+void BoardManager::local_changed(const std::string& filename) {
+    __queue_index(filename);
+}
+
+std::vector<std::string> BoardManager::local_folders() const {
+    std::vector<std::string> folders{BOARD_DIR};
+    for (const auto& dir_entry : fs::directory_iterator(BOARD_DIR)) {
+        if (dir_entry.is_directory() &&
+            dir_entry.path().filename().string().size() ==
+                SHARD_PREFIX_LENGTH) {
+            folders.push_back(dir_entry.path().string());
+        }
+    }
+    return folders;
+}
+
+std::optional<CardStats> BoardManager::local_stats(const LocalBoard& local,
+                                                   const Date& today) const {
+    std::optional<CardStats> stats = local.board->get_saved_stats();
+    if (stats) {
+        stats->n_overdue = m_agenda_index.n_overdue(local.filename, today);
+    }
+    return stats;
+}
+
 sigc::signal<void(LocalBoard)>& BoardManager::signal_add_board() {
     return add_board_signal;
 }
@@ -361,15 +654,136 @@ sigc::signal<void(LocalBoard)>& BoardManager::signal_save_board() {
     return save_board_signal;
 }
 
+sigc::signal<void()>& BoardManager::signal_indexed() { return indexed_signal; }
+
+bool BoardManager::local_enumerate(const std::string& filename) {
+    if (!loaded()) {
+        return false;
+    }
+
+    std::unique_lock<std::mutex> lock{m_boards_mutex};
+    auto it = std::find_if(m_pending_boards.begin(), m_pending_boards.end(),
+                           [&filename](const PendingBoard& pending) {
+                               return pending.filename == filename;
+                           });
+    if (it == m_pending_boards.end()) {
+        return false;
+    }
+    m_pending_boards.erase(it);
+
+    LocalBoard local_board;
+    try {
+        local_board = LocalBoard{filename, unitialized_board(filename), false};
+    } catch (std::invalid_argument& err) {
+        return false;
+    }
+    m_local_boards.push_back(local_board);
+    lock.unlock();
+
+    // It will not be part of any page, so it is announced like a new one
+    add_board_signal.emit(local_board);
+    return true;
+}
+
+void BoardManager::__queue_index(const std::string& filename, bool reread) {
+    {
+        std::lock_guard<std::mutex> lg{m_index_mutex};
+        auto queued = std::find_if(m_index_queue.begin(), m_index_queue.end(),
+                                   [&filename](const QueuedIndex& entry) {
+                                       return entry.filename == filename;
+                                   });
+        if (queued != m_index_queue.end()) {
+            queued->reread = queued->reread || reread;
+            return;
+        }
+        m_index_queue.push_back(QueuedIndex{filename, reread});
+    }
+    m_index_cv.notify_one();
+}
+
+void BoardManager::__index_boards(const std::vector<PendingBoard>& boards,
+                                  std::stop_token token) {
+    for (const PendingBoard& pending : boards) {
+        if (token.stop_requested()) {
+            return;
+        }
+        __index_board(pending.filename, token);
+    }
+}
+
+void BoardManager::__index_board(const std::string& filename,
+                                 std::stop_token token, bool reread) {
+    if (!fs::exists(filename)) {
+        m_search_index.remove(filename);
+        m_agenda_index.remove(filename);
+        return;
+    }
+
+    // Taken before the board is read, so a write made meanwhile is noticed
+    // the next time the board is indexed. What was indexed from the board
+    // file as it is now is kept
+    const std::string stamp = file_stamp(filename);
+    const bool searchable =
+        !reread && (m_search_index.up_to_date(filename, stamp) ||
+                    m_search_index.load(filename));
+    const bool summarised =
+        !reread && (m_agenda_index.up_to_date(filename, stamp) ||
+                    m_agenda_index.load(filename));
+    if (searchable && summarised) {
+        return;
+    }
+
+    // Boards are read into their own instance, the enumerated one may be in
+    // use by the GTK thread
+    try {
+        auto board = unitialized_board(filename);
+        if (!full_load(filename, board, token)) {
+            return;
+        }
+        if (!searchable) {
+            m_search_index.update(filename, *board, stamp);
+        }
+        if (!summarised) {
+            m_agenda_index.update(filename, *board, stamp);
+        }
+    } catch (std::exception& err) {
+        // error loading board: keep going
+    }
+}
+
+void BoardManager::__index_queued(std::stop_token token) {
+    std::unique_lock<std::mutex> lock{m_index_mutex};
+    while (!token.stop_requested()) {
+        if (m_index_queue.empty()) {
+            m_indexing = false;
+            lock.unlock();
+            indexed_signal.emit();
+            lock.lock();
+            m_index_cv.wait(lock, token,
+                            [this]() { return !m_index_queue.empty(); });
+            continue;
+        }
+
+        const QueuedIndex queued = m_index_queue.front();
+        m_index_queue.pop_front();
+        m_indexing = true;
+        lock.unlock();
+        __index_board(queued.filename, token, queued.reread);
+        lock.lock();
+    }
+}
+
 void BoardManager::__local_save(const LocalBoard& local) {
     auto doc = std::make_unique<tinyxml2::XMLDocument>();
 
     std::shared_ptr<Board> board = local.board;
+    const CardStats stats = BoardStats::recount(*board);
 
     tinyxml2::XMLElement* board_element = doc->NewElement("board");
     board_element->SetAttribute("name", board->get_name().c_str());
     board_element->SetAttribute("background", board->get_background().c_str());
     board_element->SetAttribute("uuid", std::string(board->get_id()).c_str());
+    write_stats(board_element, stats);
     doc->InsertEndChild(board_element);
 
     for (const auto& cardlist : board->container()) {
@@ -429,6 +843,7 @@ void BoardManager::__local_save(const LocalBoard& local) {
             std::filesystem::last_write_time(p));
         board->m_last_modified =
             std::chrono::floor<std::chrono::seconds>(lm_filepath);
+        board->m_saved_stats = stats;
     } else {
         // failed to save: no logging emitted
     }
@@ -2,11 +2,19 @@
 
 #include <sigc++/signal.h>
 
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <stop_token>
 #include <string>
+#include <thread>
 #include <vector>
-#include <mutex>
 
+#include "agenda-index.h"
 #include "board.h"
+#include "search-index.h"
 
 /**
  * @brief Progress board in the user's filesystem
@@ -20,21 +28,78 @@ struct LocalBoard {
 /**
  * @brief Helper responsible for loading and saving different Boards across the
  * user's system
+ *
+ * @details Boards are written to shard folders named after the first
+ * characters of their id, so no folder grows with the number of boards. Boards
+ * written straight into the boards folder by older versions are still found.
+ *
+ * On construction, the boards folder is only listed. Boards are enumerated
+ * page by page, most recently modified first, and only the metadata of the
+ * enumerated boards is read.
+ *
+ * Every board is also kept in a SearchIndex and in an AgendaIndex, which are
+ * only written by the loading thread. Once the folder is listed, boards whose
+ * stored search texts or due date summary are missing or out of date are read
+ * again and indexed. Afterwards, the thread indexes the boards queued as they
+ * are created, saved or removed, or as their files are reported as changed,
+ * so saving never indexes on the caller's thread.
  */
 class BoardManager {
 public:
+    /**
+     * @brief Number of characters of a board's id naming its shard folder
+     */
+    static constexpr size_t SHARD_PREFIX_LENGTH = 2;
+
     BoardManager();
     BoardManager(const std::string& board_dir);
 
     /**
      * @brief Opens local Progress board
+     *
+     * @param filename board's file path
+     * @param token stop token checked while the board is being parsed. When a
+     * stop is requested, the partially built board is released and nullptr is
+     * returned
+     *
+     * @details A board that was not enumerated yet is enumerated first, see
+     * local_enumerate(). Callers opening boards off the thread handling the
+     * manager's signals have to enumerate them beforehand
+     */
+    std::shared_ptr<Board> local_open(const std::string& filename,
+                                      std::stop_token token = {});
+
+    /**
+     * @brief Enumerates a board out of page order, and announces it through
+     * signal_add_board() since it will not be part of any page. It must be
+     * called on the thread handling the manager's signals
+     *
+     * @return false if the board was enumerated already, if the boards folder
+     * has not been listed yet or if the board cannot be read
+     */
+    bool local_enumerate(const std::string& filename);
+
+    /**
+     * @brief Returns the local boards enumerated so far, including the ones
+     * created or opened since the manager was built
+     */
+    std::vector<LocalBoard> local_boards() const;
+
+    /**
+     * @brief Enumerates the next boards, most recently modified first
+     *
+     * @param count largest number of boards to enumerate
+     *
+     * @return the enumerated boards. Boards that cannot be read are skipped.
+     * The page is empty once every board has been enumerated or if the
+     * boards folder has not been listed yet
      */
-    std::shared_ptr<Board> local_open(const std::string& filename);
+    std::vector<LocalBoard> local_next_page(size_t count);
 
     /**
-     * @brief Returns a list of all local boards
+     * @brief Returns the number of local boards, enumerated or not
      */
-    const std::vector<LocalBoard>& local_boards() const;
+    size_t local_count() const;
 
     /**
      * @brief Creates a new local Progress board file.
@@ -67,10 +132,80 @@ public:
      */
     bool loaded() const;
 
+    /**
+     * @brief Searches the names, notes and tasks of every local board,
+     * enumerated or not
+     *
+     * @details Boards modified outside of the application are only found
+     * under their new content once search_ready() returns true
+     */
+    std::vector<SearchHit> search(const std::string& query,
+                                  SearchMode mode = SearchMode::PREFIX,
+                                  size_t max_hits = 100) const;
+
+    /**
+     * @brief Returns whether every listed board has been indexed and no board
+     * is waiting to be indexed again
+     */
+    bool search_ready() const;
+
+    /**
+     * @brief Returns the overdue cards, the cards due today and the cards due
+     * in the next days of every local board, enumerated or not. No board is
+     * loaded
+     *
+     * @details Boards modified outside of the application are only taken into
+     * account once agenda_ready() returns true
+     *
+     * @param days number of days after today looked at for upcoming cards
+     */
+    Agenda agenda(const Date& today, unsigned days = 7) const;
+
+    /**
+     * @brief Returns whether the due dates of every listed board are known and
+     * no board is waiting to be indexed again
+     */
+    bool agenda_ready() const;
+
+    /**
+     * @brief Queues a board file changed outside of the manager, e.g. by
+     * another instance, to be indexed again. Files of deleted boards are
+     * dropped from the indexes and boards whose stored index is up to date
+     * are not read
+     */
+    void local_changed(const std::string& filename);
+
+    /**
+     * @brief Returns the boards folder and the shard folders found in it,
+     * which are where board files may change
+     */
+    std::vector<std::string> local_folders() const;
+
+    /**
+     * @brief Returns the statistics of a local board without loading it
+     *
+     * @details The counts stored when the board was last saved are completed
+     * with its overdue cards, taken from the due date summaries
+     *
+     * @return an empty optional if the board file holds no statistics
+     */
+    std::optional<CardStats> local_stats(const LocalBoard& local,
+                                         const Date& today) const;
+
+    /**
+     * @brief Emitted when a board is created, or when a board is opened before
+     * its page was enumerated
+     */
     sigc::signal<void(LocalBoard)>& signal_add_board();
     sigc::signal<void(LocalBoard)>& signal_remove_board();
     sigc::signal<void(LocalBoard)>& signal_save_board();
 
+    /**
+     * @brief Emitted whenever the loading thread has indexed every queued
+     * board. It is emitted on the loading thread
+     */
+    sigc::signal<void()>& signal_indexed();
+
 protected:
     const std::string BOARD_DIR;
     std::vector<LocalBoard> m_local_boards;
@@ -78,10 +213,74 @@ protected:
     sigc::signal<void(LocalBoard)> add_board_signal;
     sigc::signal<void(LocalBoard)> remove_board_signal;
     sigc::signal<void(LocalBoard)> save_board_signal;
+    sigc::signal<void()> indexed_signal;
+
+    struct PendingBoard {
+        std::string filename;
+        std::filesystem::file_time_type modified;
+    };
+
+    // Boards listed but not enumerated yet, least recently modified first so
+    // pages are taken from the back
+    std::vector<PendingBoard> m_pending_boards;
+
+    // Guards m_local_boards and m_pending_boards, as boards may be opened on
+    // another thread than the one enumerating them
+    mutable std::mutex m_boards_mutex;
+
+    SearchIndex m_search_index;
+    AgendaIndex m_agenda_index;
 
 private:
     mutable std::mutex valid_mutex;
     volatile bool m_loaded = false;
     void __local_save(const LocalBoard& local);
+
+    mutable std::mutex m_index_mutex;
+    std::condition_variable_any m_index_cv;
+    struct QueuedIndex {
+        std::string filename;
+
+        // Set for boards saved by the manager, whose stored indexes are
+        // known to be out of date
+        bool reread;
+    };
+
+    // Files waiting to be indexed again, each one once
+    std::deque<QueuedIndex> m_index_queue;
+    bool m_indexed = false;
+    bool m_indexing = false;
+
+    /**
+     * @brief Queues a board file to be indexed again by the loading thread
+     *
+     * @param reread whether the board has to be read even if its stored
+     * indexes look up to date
+     */
+    void __queue_index(const std::string& filename, bool reread = false);
+
+    /**
+     * @brief Indexes the listed boards whose stored search texts or due date
+     * summary cannot be used. Runs on the loading thread
+     */
+    void __index_boards(const std::vector<PendingBoard>& boards,
+                        std::stop_token token);
+
+    /**
+     * @brief Brings the indexes of a board file up to date. Unless reread is
+     * set, the board is only read if its stored search texts or due date
+     * summary cannot be used. Runs on the loading thread
+     */
+    void __index_board(const std::string& filename, std::stop_token token,
+                       bool reread = false);
+
+    /**
+     * @brief Indexes queued board files until a stop is requested. Runs on
+     * the loading thread
+     */
+    void __index_queued(std::stop_token token);
+
+    // Declared last so loading stops before anything it uses goes away
+    std::jthread m_loading_thread;
 };
 
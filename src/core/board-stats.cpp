@@ -0,0 +1,242 @@
+#include "board-stats.h"
+
+#include <algorithm>
+
+void BoardStats::track(const std::shared_ptr<Board>& board,
+                       const Date& today) {
+    clear();
+    m_today = today;
+
+    m_board_cnns.push_back(board->container().signal_append().connect(
+        [this](std::shared_ptr<CardList> cardlist) {
+            track(cardlist);
+            m_changed_signal.emit();
+        }));
+    m_board_cnns.push_back(board->container().signal_insert().connect(
+        [this](std::shared_ptr<CardList> cardlist, ssize_t) {
+            track(cardlist);
+            m_changed_signal.emit();
+        }));
+    m_board_cnns.push_back(board->container().signal_remove().connect(
+        [this](std::shared_ptr<CardList> cardlist) {
+            untrack(cardlist);
+            m_changed_signal.emit();
+        }));
+
+    for (const auto& cardlist : board->container()) {
+        track(cardlist);
+    }
+    m_changed_signal.emit();
+}
+
+void BoardStats::clear() {
+    m_board_cnns.clear();
+    m_entries.clear();
+    m_cardlists.clear();
+    m_dated.clear();
+    m_board = CardStats{};
+}
+
+void BoardStats::set_today(const Date& today) {
+    if (today == m_today) {
+        return;
+    }
+    m_today = today;
+
+    for (const Card* card : m_dated) {
+        refresh(m_entries.at(card), false);
+    }
+    m_changed_signal.emit();
+}
+
+const CardStats& BoardStats::board() const { return m_board; }
+
+const CardStats& BoardStats::cardlist(const CardList& cardlist) const {
+    auto it = m_cardlists.find(&cardlist);
+    return it == m_cardlists.end() ? m_empty : it->second.stats;
+}
+
+CardStats BoardStats::recount(Board& board, const Date& today) {
+    CardStats stats;
+    for (const auto& cardlist : board.container()) {
+        for (const auto& card : cardlist->container()) {
+            add(stats, count(*card, today));
+        }
+    }
+    return stats;
+}
+
+sigc::signal<void()>& BoardStats::signal_changed() { return m_changed_signal; }
+
+BoardStats::Counted BoardStats::count(Card& card, const Date& today) {
+    Counted counted;
+    counted.color = card.is_color_set() ? card.get_color() : NO_COLOR;
+
+    const Date due = card.get_due_date();
+    if (due.ok()) {
+        counted.complete = card.get_complete();
+        counted.overdue = !counted.complete && today.ok() &&
+                          std::chrono::sys_days{due} <
+                              std::chrono::sys_days{today};
+    }
+
+    const auto& tasks = card.container().get_data();
+    counted.n_tasks = tasks.size();
+    counted.n_tasks_done =
+        std::count_if(tasks.begin(), tasks.end(),
+                      [](const auto& task) { return task->get_done(); });
+    return counted;
+}
+
+void BoardStats::add(CardStats& stats, const Counted& counted) {
+    stats.n_cards++;
+    stats.n_complete += counted.complete;
+    stats.n_overdue += counted.overdue;
+    stats.n_tasks += counted.n_tasks;
+    stats.n_tasks_done += counted.n_tasks_done;
+    stats.n_colors[counted.color]++;
+}
+
+void BoardStats::subtract(CardStats& stats, const Counted& counted) {
+    stats.n_cards--;
+    stats.n_complete -= counted.complete;
+    stats.n_overdue -= counted.overdue;
+    stats.n_tasks -= counted.n_tasks;
+    stats.n_tasks_done -= counted.n_tasks_done;
+    auto color = stats.n_colors.find(counted.color);
+    if (color != stats.n_colors.end() && --color->second == 0) {
+        stats.n_colors.erase(color);
+    }
+}
+
+void BoardStats::track(const std::shared_ptr<CardList>& cardlist) {
+    if (m_cardlists.contains(cardlist.get())) {
+        return;
+    }
+
+    CardList* list = cardlist.get();
+    auto& cnns = m_cardlists[list].cnns;
+    cnns.push_back(cardlist->container().signal_append().connect(
+        [this, list](std::shared_ptr<Card> card) {
+            track(card, list);
+            m_changed_signal.emit();
+        }));
+    cnns.push_back(cardlist->container().signal_insert().connect(
+        [this, list](std::shared_ptr<Card> card, ssize_t) {
+            track(card, list);
+            m_changed_signal.emit();
+        }));
+    cnns.push_back(cardlist->container().signal_remove().connect(
+        [this, list](std::shared_ptr<Card> card) {
+            untrack(card, list);
+            m_changed_signal.emit();
+        }));
+    cnns.push_back(cardlist->container().signal_move().connect(
+        [this, list](std::shared_ptr<Card> card, ItemContainer<Card>* from,
+                     ssize_t, ItemContainer<Card>* to, ssize_t) {
+            // Both lists report the move. The card follows it once
+            if (to == &list->container() && from != to) {
+                track(card, list);
+                m_changed_signal.emit();
+            }
+        }));
+
+    for (const auto& card : cardlist->container()) {
+        track(card, list);
+    }
+}
+
+void BoardStats::untrack(const std::shared_ptr<CardList>& cardlist) {
+    for (const auto& card : cardlist->container()) {
+        untrack(card, cardlist.get());
+    }
+    m_cardlists.erase(cardlist.get());
+}
+
+void BoardStats::track(const std::shared_ptr<Card>& card, CardList* cardlist) {
+    auto it = m_entries.find(card.get());
+    if (it != m_entries.end()) {
+        // Appended to its new list before being removed from the old one
+        Entry& entry = it->second;
+        if (entry.cardlist != cardlist) {
+            subtract(m_cardlists.at(entry.cardlist).stats, entry.counted);
+            add(m_cardlists.at(cardlist).stats, entry.counted);
+            entry.cardlist = cardlist;
+        }
+        return;
+    }
+
+    Entry& entry = m_entries[card.get()];
+    entry.card = card;
+    entry.cardlist = cardlist;
+    entry.cnns.push_back(card->signal_color().connect(
+        [this, &entry](Color, Color) { refresh(entry); }));
+    entry.cnns.push_back(card->signal_due_date().connect(
+        [this, &entry](Date, Date) { refresh(entry); }));
+    entry.cnns.push_back(card->signal_complete().connect(
+        [this, &entry](bool) { refresh(entry); }));
+    entry.cnns.push_back(card->container().signal_append().connect(
+        [this, &entry](std::shared_ptr<Task>) {
+            connect_tasks(entry);
+            refresh(entry);
+        }));
+    entry.cnns.push_back(card->container().signal_insert().connect(
+        [this, &entry](std::shared_ptr<Task>, ssize_t) {
+            connect_tasks(entry);
+            refresh(entry);
+        }));
+    entry.cnns.push_back(card->container().signal_remove().connect(
+        [this, &entry](std::shared_ptr<Task>) {
+            connect_tasks(entry);
+            refresh(entry);
+        }));
+    connect_tasks(entry);
+
+    entry.counted = count(*card, m_today);
+    add(m_cardlists.at(cardlist).stats, entry.counted);
+    add(m_board, entry.counted);
+    if (card->get_due_date().ok()) {
+        m_dated.insert(card.get());
+    }
+}
+
+void BoardStats::untrack(const std::shared_ptr<Card>& card,
+                         CardList* cardlist) {
+    auto it = m_entries.find(card.get());
+    // The card may have been moved to another list already
+    if (it == m_entries.end() || it->second.cardlist != cardlist) {
+        return;
+    }
+
+    subtract(m_cardlists.at(cardlist).stats, it->second.counted);
+    subtract(m_board, it->second.counted);
+    m_dated.erase(card.get());
+    m_entries.erase(it);
+}
+
+void BoardStats::connect_tasks(Entry& entry) {
+    entry.task_cnns.clear();
+    for (const auto& task : entry.card->container()) {
+        entry.task_cnns.push_back(task->signal_done().connect(
+            [this, &entry](bool) { refresh(entry); }));
+    }
+}
+
+void BoardStats::refresh(Entry& entry, bool notify) {
+    CardStats& list_stats = m_cardlists.at(entry.cardlist).stats;
+    subtract(list_stats, entry.counted);
+    subtract(m_board, entry.counted);
+
+    entry.counted = count(*entry.card, m_today);
+    add(list_stats, entry.counted);
+    add(m_board, entry.counted);
+
+    if (entry.card->get_due_date().ok()) {
+        m_dated.insert(entry.card.get());
+    } else {
+        m_dated.erase(entry.card.get());
+    }
+    if (notify) {
+        m_changed_signal.emit();
+    }
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <sigc++/signal.h>
+
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "board.h"
+#include "card-stats.h"
+
+/**
+ * @brief Keeps the CardStats of a board and of each of its lists up to date.
+ *
+ * @details Every tracked card remembers what it was counted as. When a card,
+ * one of its tasks or a container changes, only that card is counted again
+ * and the difference is applied to its list and to the board, so reading the
+ * statistics never walks the cards.
+ *
+ * Cards moved across lists are only taken from one list's statistics to the
+ * other's, whether they are moved at once or appended to their new list
+ * before being removed from the old one.
+ */
+class BoardStats {
+public:
+    BoardStats() = default;
+    BoardStats(const BoardStats&) = delete;
+    BoardStats& operator=(const BoardStats&) = delete;
+
+    /**
+     * @brief Counts every card of the board, replacing any tracked board
+     *
+     * @param today day due dates are compared to when counting overdue cards
+     */
+    void track(const std::shared_ptr<Board>& board, const Date& today);
+
+    /**
+     * @brief Stops tracking the board
+     */
+    void clear();
+
+    /**
+     * @brief Moves the day due dates are compared to. Only dated cards are
+     * counted again
+     */
+    void set_today(const Date& today);
+
+    /**
+     * @brief Returns the statistics of the whole board
+     */
+    const CardStats& board() const;
+
+    /**
+     * @brief Returns the statistics of one list of the board. Lists that are
+     * not tracked have no cards
+     */
+    const CardStats& cardlist(const CardList& cardlist) const;
+
+    /**
+     * @brief Counts every card of a board from scratch
+     *
+     * @param today day due dates are compared to. If it is not a valid date,
+     * no card is counted as overdue
+     */
+    static CardStats recount(Board& board, const Date& today = Date{});
+
+    /**
+     * @brief Emitted whenever the board's or some list's statistics change
+     */
+    sigc::signal<void()>& signal_changed();
+
+protected:
+    /**
+     * @brief What a single card adds to the statistics
+     */
+    struct Counted {
+        bool complete = false;
+        bool overdue = false;
+        size_t n_tasks = 0;
+        size_t n_tasks_done = 0;
+        Color color = NO_COLOR;
+    };
+
+    struct Entry {
+        std::shared_ptr<Card> card;
+        CardList* cardlist = nullptr;
+        Counted counted;
+        std::vector<sigc::scoped_connection> cnns;
+        std::vector<sigc::scoped_connection> task_cnns;
+    };
+
+    struct TrackedList {
+        CardStats stats;
+        std::vector<sigc::scoped_connection> cnns;
+    };
+
+    static Counted count(Card& card, const Date& today);
+    static void add(CardStats& stats, const Counted& counted);
+    static void subtract(CardStats& stats, const Counted& counted);
+
+    void track(const std::shared_ptr<CardList>& cardlist);
+    void untrack(const std::shared_ptr<CardList>& cardlist);
+    void track(const std::shared_ptr<Card>& card, CardList* cardlist);
+    void untrack(const std::shared_ptr<Card>& card, CardList* cardlist);
+
+    /**
+     * @brief Connects to the done signal of every task of the card, dropping
+     * the previous task connections
+     */
+    void connect_tasks(Entry& entry);
+
+    /**
+     * @brief Counts a card again and applies the difference
+     *
+     * @param notify whether signal_changed() is emitted
+     */
+    void refresh(Entry& entry, bool notify = true);
+
+    Date m_today;
+    CardStats m_board;
+    const CardStats m_empty{};
+
+    std::vector<sigc::scoped_connection> m_board_cnns;
+    std::unordered_map<const CardList*, TrackedList> m_cardlists;
+    std::unordered_map<const Card*, Entry> m_entries;
+
+    // Cards whose overdue state depends on the day
+    std::unordered_set<const Card*> m_dated;
+
+    sigc::signal<void()> m_changed_signal;
+};
@@ -71,6 +71,10 @@ time_point<system_clock, seconds> Board::get_last_modified() const {
     return m_last_modified;
 }
 
+const std::optional<CardStats>& Board::get_saved_stats() const {
+    return m_saved_stats;
+}
+
 bool Board::modified() const { return m_modified || m_cardlists.modified(); }
 
 void Board::modify(bool m) { m_modified = m; }
@@ -2,8 +2,10 @@
 
 #include <tinyxml2.h>
 
+#include <optional>
 #include <string>
 
+#include "card-stats.h"
 #include "cardlist.h"
 #include "item-container.h"
 #include "item.h"
@@ -62,6 +64,15 @@ public:
      */
     time_point<system_clock, seconds> get_last_modified() const;
 
+    /**
+     * @brief Returns the statistics the board had when it was last saved, so
+     * they are known without loading its lists. Overdue cards are not part of
+     * them
+     *
+     * @returns an empty optional if the board file holds no statistics
+     */
+    const std::optional<CardStats>& get_saved_stats() const;
+
     /**
      * @brief Returns true if either the board data or the board's container has
      * been modified
@@ -90,6 +101,7 @@ protected:
 
     std::string m_background, m_description;
     time_point<system_clock, seconds> m_last_modified;
+    std::optional<CardStats> m_saved_stats;
     ItemContainer<CardList> m_cardlists;
 
     bool m_modified = false;
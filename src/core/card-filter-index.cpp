@@ -0,0 +1,313 @@
+#include "card-filter-index.h"
+
+#include <algorithm>
+
+void CardFilterIndex::track(const std::shared_ptr<Board>& board,
+                            const Date& today) {
+    clear();
+    m_today = today;
+
+    m_board_cnns.push_back(board->container().signal_append().connect(
+        [this](std::shared_ptr<CardList> cardlist) { track(cardlist); }));
+    m_board_cnns.push_back(board->container().signal_insert().connect(
+        [this](std::shared_ptr<CardList> cardlist, ssize_t) {
+            track(cardlist);
+        }));
+    m_board_cnns.push_back(board->container().signal_remove().connect(
+        [this](std::shared_ptr<CardList> cardlist) { untrack(cardlist); }));
+
+    for (const auto& cardlist : board->container()) {
+        track(cardlist);
+    }
+}
+
+void CardFilterIndex::clear() {
+    m_board_cnns.clear();
+    m_cardlist_cnns.clear();
+    m_entries.clear();
+    m_free_slots.clear();
+    m_slots.clear();
+
+    m_live.clear();
+    m_visible.clear();
+    m_dated.clear();
+    m_overdue.clear();
+    m_due_soon.clear();
+    m_complete.clear();
+    m_notes.clear();
+    for (DynamicBitset& tasks : m_tasks) {
+        tasks.clear();
+    }
+    m_colors.clear();
+    m_filter = CardFilter{};
+}
+
+void CardFilterIndex::set_today(const Date& today) {
+    if (today == m_today) {
+        return;
+    }
+    m_today = today;
+
+    std::vector<size_t> dated;
+    m_dated.for_each([&dated](size_t slot) { dated.push_back(slot); });
+    for (const size_t slot : dated) {
+        refresh(slot);
+    }
+}
+
+void CardFilterIndex::set_filter(const CardFilter& filter) {
+    m_filter = filter;
+
+    const DynamicBitset shown = evaluate(filter);
+    DynamicBitset changed = shown;
+    changed ^= m_visible;
+    m_visible = shown;
+
+    // Visibility is only updated for the cards it changes for
+    std::vector<size_t> changed_slots;
+    changed.for_each(
+        [&changed_slots](size_t slot) { changed_slots.push_back(slot); });
+    for (const size_t slot : changed_slots) {
+        m_visibility_signal.emit(m_entries[slot].card, shown.test(slot));
+    }
+}
+
+const CardFilter& CardFilterIndex::get_filter() const { return m_filter; }
+
+bool CardFilterIndex::visible(const Card& card) const {
+    const ssize_t slot = slot_of(card);
+    return slot == -1 || m_visible.test(slot);
+}
+
+bool CardFilterIndex::matches(const Card& card,
+                              const CardFilter& filter) const {
+    const ssize_t slot = slot_of(card);
+    if (slot == -1) {
+        return false;
+    }
+
+    for (const auto& clause : filter.clauses) {
+        if (std::none_of(clause.begin(), clause.end(),
+                         [this, slot](const CardCondition& condition) {
+                             return bits(condition).test(slot);
+                         })) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t CardFilterIndex::count(const CardFilter& filter) const {
+    return evaluate(filter).count();
+}
+
+size_t CardFilterIndex::n_cards() const { return m_slots.size(); }
+
+size_t CardFilterIndex::n_visible() const { return m_visible.count(); }
+
+sigc::signal<void(std::shared_ptr<Card>, bool)>&
+CardFilterIndex::signal_visibility() {
+    return m_visibility_signal;
+}
+
+void CardFilterIndex::track(const std::shared_ptr<CardList>& cardlist) {
+    if (m_cardlist_cnns.contains(cardlist.get())) {
+        return;
+    }
+
+    auto& cnns = m_cardlist_cnns[cardlist.get()];
+    cnns.push_back(cardlist->container().signal_append().connect(
+        [this](std::shared_ptr<Card> card) { track(card); }));
+    cnns.push_back(cardlist->container().signal_insert().connect(
+        [this](std::shared_ptr<Card> card, ssize_t) { track(card); }));
+    cnns.push_back(cardlist->container().signal_remove().connect(
+        [this](std::shared_ptr<Card> card) { untrack(card); }));
+
+    for (const auto& card : cardlist->container()) {
+        track(card);
+    }
+}
+
+void CardFilterIndex::untrack(const std::shared_ptr<CardList>& cardlist) {
+    for (const auto& card : cardlist->container()) {
+        untrack(card);
+    }
+    m_cardlist_cnns.erase(cardlist.get());
+}
+
+void CardFilterIndex::track(const std::shared_ptr<Card>& card) {
+    // Cards moved across cardlists may be appended to their new cardlist
+    // before (or without) being removed from the old one
+    if (m_slots.contains(card.get())) {
+        return;
+    }
+
+    size_t slot = m_entries.size();
+    if (!m_free_slots.empty()) {
+        slot = m_free_slots.back();
+        m_free_slots.pop_back();
+    } else {
+        m_entries.emplace_back();
+    }
+    m_slots[card.get()] = slot;
+
+    Entry& entry = m_entries[slot];
+    entry.card = card;
+    entry.cnns.push_back(card->signal_color().connect(
+        [this, slot](Color, Color) { refresh(slot); }));
+    entry.cnns.push_back(card->signal_notes().connect(
+        [this, slot](std::string, std::string) { refresh(slot); }));
+    entry.cnns.push_back(card->signal_due_date().connect(
+        [this, slot](Date, Date) { refresh(slot); }));
+    entry.cnns.push_back(card->signal_complete().connect(
+        [this, slot](bool) { refresh(slot); }));
+    entry.cnns.push_back(card->container().signal_append().connect(
+        [this, slot](std::shared_ptr<Task>) {
+            connect_tasks(slot);
+            refresh(slot);
+        }));
+    entry.cnns.push_back(card->container().signal_insert().connect(
+        [this, slot](std::shared_ptr<Task>, ssize_t) {
+            connect_tasks(slot);
+            refresh(slot);
+        }));
+    entry.cnns.push_back(card->container().signal_remove().connect(
+        [this, slot](std::shared_ptr<Task>) {
+            connect_tasks(slot);
+            refresh(slot);
+        }));
+
+    m_live.set(slot);
+    m_visible.set(slot);
+    connect_tasks(slot);
+    refresh(slot, false);
+}
+
+void CardFilterIndex::untrack(const std::shared_ptr<Card>& card) {
+    const ssize_t slot = slot_of(*card);
+    if (slot == -1) {
+        return;
+    }
+
+    reset_bits(slot);
+    m_live.reset(slot);
+    m_visible.reset(slot);
+    m_entries[slot] = Entry{};
+    m_slots.erase(card.get());
+    m_free_slots.push_back(slot);
+}
+
+void CardFilterIndex::connect_tasks(size_t slot) {
+    Entry& entry = m_entries[slot];
+    entry.task_cnns.clear();
+    for (const auto& task : entry.card->container()) {
+        entry.task_cnns.push_back(task->signal_done().connect(
+            [this, slot](bool) { refresh(slot); }));
+    }
+}
+
+void CardFilterIndex::refresh(size_t slot, bool update_visibility) {
+    reset_bits(slot);
+
+    Entry& entry = m_entries[slot];
+    const Card& card = *entry.card;
+
+    entry.color = card.is_color_set() ? card.get_color() : NO_COLOR;
+    m_colors[entry.color].set(slot);
+
+    const Date due = card.get_due_date();
+    if (due.ok()) {
+        m_dated.set(slot);
+        if (card.get_complete()) {
+            m_complete.set(slot);
+        } else if (m_today.ok()) {
+            const auto days_left =
+                std::chrono::sys_days{due} - std::chrono::sys_days{m_today};
+            if (days_left < std::chrono::days{0}) {
+                m_overdue.set(slot);
+            } else if (days_left < std::chrono::days{DUE_SOON_DAYS}) {
+                m_due_soon.set(slot);
+            }
+        }
+    }
+
+    m_notes.set(slot, !card.get_notes().empty());
+
+    const auto& tasks = entry.card->container().get_data();
+    const size_t n_done =
+        std::count_if(tasks.begin(), tasks.end(),
+                      [](const auto& task) { return task->get_done(); });
+    TaskProgress progress = TaskProgress::IN_PROGRESS;
+    if (tasks.empty()) {
+        progress = TaskProgress::NO_TASKS;
+    } else if (n_done == 0) {
+        progress = TaskProgress::NOT_STARTED;
+    } else if (n_done == tasks.size()) {
+        progress = TaskProgress::DONE;
+    }
+    m_tasks[static_cast<size_t>(progress)].set(slot);
+
+    // Without a filter every card is shown, whatever its attributes
+    if (!update_visibility || m_filter.empty()) {
+        return;
+    }
+    const bool shown = matches(card, m_filter);
+    if (shown != m_visible.test(slot)) {
+        m_visible.set(slot, shown);
+        m_visibility_signal.emit(entry.card, shown);
+    }
+}
+
+void CardFilterIndex::reset_bits(size_t slot) {
+    auto color = m_colors.find(m_entries[slot].color);
+    if (color != m_colors.end()) {
+        color->second.reset(slot);
+    }
+
+    m_dated.reset(slot);
+    m_overdue.reset(slot);
+    m_due_soon.reset(slot);
+    m_complete.reset(slot);
+    m_notes.reset(slot);
+    for (DynamicBitset& tasks : m_tasks) {
+        tasks.reset(slot);
+    }
+}
+
+DynamicBitset CardFilterIndex::evaluate(const CardFilter& filter) const {
+    DynamicBitset result = m_live;
+    for (const auto& clause : filter.clauses) {
+        DynamicBitset any;
+        for (const CardCondition& condition : clause) {
+            any |= bits(condition);
+        }
+        result &= any;
+    }
+    return result;
+}
+
+const DynamicBitset& CardFilterIndex::bits(
+    const CardCondition& condition) const {
+    switch (condition.attribute) {
+        case CardAttribute::COLOR: {
+            auto it = m_colors.find(condition.color);
+            return it == m_colors.end() ? m_empty : it->second;
+        }
+        case CardAttribute::OVERDUE:
+            return m_overdue;
+        case CardAttribute::DUE_SOON:
+            return m_due_soon;
+        case CardAttribute::COMPLETE:
+            return m_complete;
+        case CardAttribute::NOTES:
+            return m_notes;
+        case CardAttribute::TASKS:
+            return m_tasks[static_cast<size_t>(condition.tasks)];
+    }
+    return m_empty;
+}
+
+ssize_t CardFilterIndex::slot_of(const Card& card) const {
+    auto it = m_slots.find(&card);
+    return it == m_slots.end() ? -1 : static_cast<ssize_t>(it->second);
+}
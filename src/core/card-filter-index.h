@@ -0,0 +1,187 @@
+#pragma once
+
+#include <sigc++/signal.h>
+#include <sys/types.h>
+
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "board.h"
+#include "dynamic-bitset.h"
+
+/**
+ * @brief Card attributes a filter can look at
+ */
+enum class CardAttribute { COLOR, OVERDUE, DUE_SOON, COMPLETE, NOTES, TASKS };
+
+/**
+ * @brief How far the tasks of a card are
+ */
+enum class TaskProgress { NO_TASKS, NOT_STARTED, IN_PROGRESS, DONE };
+
+/**
+ * @brief Condition on one card attribute
+ */
+struct CardCondition {
+    CardAttribute attribute;
+
+    /**
+     * @brief Color the card must have when attribute is COLOR. NO_COLOR
+     * matches cards without a color
+     */
+    Color color = NO_COLOR;
+
+    /**
+     * @brief Progress of the card's tasks when attribute is TASKS
+     */
+    TaskProgress tasks = TaskProgress::NO_TASKS;
+};
+
+/**
+ * @brief Combination of card conditions
+ *
+ * @details A card passes the filter when it satisfies every clause (AND), and
+ * a clause is satisfied by any of its conditions (OR). A filter without
+ * clauses lets every card through.
+ */
+struct CardFilter {
+    std::vector<std::vector<CardCondition>> clauses;
+
+    bool empty() const { return clauses.empty(); }
+};
+
+/**
+ * @brief Tracks which cards of a board pass a CardFilter.
+ *
+ * @details Every tracked card owns a bit in one bitset per attribute value
+ * (each color, overdue, due soon, complete, has notes and each task
+ * progress). The bitsets follow the card, task and container signals, so
+ * applying a filter is a handful of bitset operations and only the cards
+ * whose visibility flips are reported through signal_visibility().
+ *
+ * Cards that start being tracked (e.g. new cards) are visible until the filter
+ * is applied again, so a card being created is not hidden from its author.
+ */
+class CardFilterIndex {
+public:
+    /**
+     * @brief Number of days, starting today, in which a card is due soon
+     */
+    static constexpr int DUE_SOON_DAYS = 3;
+
+    CardFilterIndex() = default;
+    CardFilterIndex(const CardFilterIndex&) = delete;
+    CardFilterIndex& operator=(const CardFilterIndex&) = delete;
+
+    /**
+     * @brief Tracks every card of the board, replacing any tracked board. The
+     * filter is cleared
+     */
+    void track(const std::shared_ptr<Board>& board, const Date& today);
+
+    /**
+     * @brief Stops tracking the board and clears the filter
+     */
+    void clear();
+
+    /**
+     * @brief Moves the day due dates are compared to
+     */
+    void set_today(const Date& today);
+
+    /**
+     * @brief Applies a filter. Cards whose visibility changes are reported
+     * through signal_visibility()
+     */
+    void set_filter(const CardFilter& filter);
+
+    const CardFilter& get_filter() const;
+
+    /**
+     * @brief Returns whether the card should be shown. Cards that are not
+     * tracked are shown
+     */
+    bool visible(const Card& card) const;
+
+    /**
+     * @brief Returns whether the card satisfies the given filter
+     */
+    bool matches(const Card& card, const CardFilter& filter) const;
+
+    /**
+     * @brief Number of cards satisfying the given filter
+     */
+    size_t count(const CardFilter& filter) const;
+
+    size_t n_cards() const;
+    size_t n_visible() const;
+
+    /**
+     * @brief void(card, visible)
+     */
+    sigc::signal<void(std::shared_ptr<Card>, bool)>& signal_visibility();
+
+protected:
+    struct Entry {
+        std::shared_ptr<Card> card;
+        Color color = NO_COLOR;
+        std::vector<sigc::scoped_connection> cnns;
+        std::vector<sigc::scoped_connection> task_cnns;
+    };
+
+    void track(const std::shared_ptr<CardList>& cardlist);
+    void untrack(const std::shared_ptr<CardList>& cardlist);
+    void track(const std::shared_ptr<Card>& card);
+    void untrack(const std::shared_ptr<Card>& card);
+
+    /**
+     * @brief Connects to the done signal of every task of the card, dropping
+     * the previous task connections
+     */
+    void connect_tasks(size_t slot);
+
+    /**
+     * @brief Recomputes the bits of a card
+     *
+     * @param update_visibility whether the card is shown or hidden according
+     * to the current filter
+     */
+    void refresh(size_t slot, bool update_visibility = true);
+
+    /**
+     * @brief Unsets every attribute bit of a card
+     */
+    void reset_bits(size_t slot);
+
+    /**
+     * @brief Returns the cards satisfying the filter
+     */
+    DynamicBitset evaluate(const CardFilter& filter) const;
+
+    const DynamicBitset& bits(const CardCondition& condition) const;
+
+    ssize_t slot_of(const Card& card) const;
+
+    CardFilter m_filter;
+    Date m_today;
+
+    std::vector<sigc::scoped_connection> m_board_cnns;
+    std::unordered_map<CardList*, std::vector<sigc::scoped_connection>>
+        m_cardlist_cnns;
+
+    // Slots of untracked cards are handed to the next tracked ones, so
+    // bitsets stay as small as the board
+    std::vector<Entry> m_entries;
+    std::vector<size_t> m_free_slots;
+    std::unordered_map<const Card*, size_t> m_slots;
+
+    DynamicBitset m_live, m_visible, m_dated;
+    DynamicBitset m_overdue, m_due_soon, m_complete, m_notes;
+    DynamicBitset m_tasks[4];
+    std::map<Color, DynamicBitset> m_colors;
+    DynamicBitset m_empty;
+
+    sigc::signal<void(std::shared_ptr<Card>, bool)> m_visibility_signal;
+};
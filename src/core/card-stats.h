@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+
+#include "colorable.h"
+
+/**
+ * @brief Aggregates over a group of cards, such as a list or a whole board
+ */
+struct CardStats {
+    size_t n_cards = 0;
+
+    /**
+     * @brief Dated cards marked as complete
+     */
+    size_t n_complete = 0;
+
+    size_t n_tasks = 0;
+    size_t n_tasks_done = 0;
+
+    /**
+     * @brief Incomplete cards due before today
+     */
+    size_t n_overdue = 0;
+
+    /**
+     * @brief Number of cards of each color. Cards without a color are counted
+     * under NO_COLOR and colors without cards are left out
+     */
+    std::map<Color, size_t> n_colors;
+
+    CardStats& operator+=(const CardStats& other) {
+        n_cards += other.n_cards;
+        n_complete += other.n_complete;
+        n_tasks += other.n_tasks;
+        n_tasks_done += other.n_tasks_done;
+        n_overdue += other.n_overdue;
+        for (const auto& [color, n] : other.n_colors) {
+            n_colors[color] += n;
+        }
+        return *this;
+    }
+
+    CardStats& operator-=(const CardStats& other) {
+        n_cards -= other.n_cards;
+        n_complete -= other.n_complete;
+        n_tasks -= other.n_tasks;
+        n_tasks_done -= other.n_tasks_done;
+        n_overdue -= other.n_overdue;
+        for (const auto& [color, n] : other.n_colors) {
+            auto it = n_colors.find(color);
+            if (it != n_colors.end() && (it->second -= n) == 0) {
+                n_colors.erase(it);
+            }
+        }
+        return *this;
+    }
+
+    bool operator==(const CardStats& other) const = default;
+};
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+#include "card.h"
+
+/**
+ * @brief Keeps track of the dates at which the deadline state (due or past due)
+ * of a set of items flips.
+ *
+ * @details An item with a due date becomes past due on the day after its due
+ * date, and its state never changes again until its deadline or completion is
+ * modified. Boundaries are kept in a min-heap, so finding the next one is
+ * O(1) and scheduling is O(log n). Rescheduling or unscheduling an item leaves
+ * its old heap entry behind; stale entries are skipped once they surface and
+ * the heap is rebuilt when they outnumber the live ones.
+ */
+template <typename T>
+class DeadlineScheduler {
+public:
+    /**
+     * @brief Returns the first day on which an item with the given deadline
+     * will be displayed differently than it is today, if there is any
+     */
+    static std::optional<std::chrono::sys_days> next_boundary(
+        const Date& due, bool complete, const Date& today) {
+        if (complete || !due.ok() || !today.ok()) {
+            return std::nullopt;
+        }
+
+        const auto boundary = std::chrono::sys_days{due} + std::chrono::days{1};
+        if (boundary <= std::chrono::sys_days{today}) {
+            return std::nullopt;
+        }
+        return boundary;
+    }
+
+    /**
+     * @brief Schedules the item for its next boundary, replacing any previous
+     * schedule. Items whose state can no longer change are unscheduled
+     *
+     * @return true if the item has been scheduled
+     */
+    bool schedule(const T& key, const Date& due, bool complete,
+                  const Date& today) {
+        const auto boundary = next_boundary(due, complete, today);
+        if (!boundary) {
+            unschedule(key);
+            return false;
+        }
+
+        const unsigned long generation = ++m_generation;
+        m_scheduled[key] = Schedule{*boundary, generation};
+        m_heap.push(Entry{*boundary, generation, key});
+        compact();
+        return true;
+    }
+
+    void unschedule(const T& key) {
+        m_scheduled.erase(key);
+        compact();
+    }
+
+    /**
+     * @brief Returns the earliest scheduled boundary, if any item is scheduled
+     */
+    std::optional<std::chrono::sys_days> next() {
+        drop_stale();
+        if (m_heap.empty()) {
+            return std::nullopt;
+        }
+        return m_heap.top().boundary;
+    }
+
+    /**
+     * @brief Removes and returns every item whose boundary has been reached by
+     * the given day, in boundary order
+     */
+    std::vector<T> take_due(const Date& today) {
+        std::vector<T> due;
+        const auto today_days = std::chrono::sys_days{today};
+
+        drop_stale();
+        while (!m_heap.empty() && m_heap.top().boundary <= today_days) {
+            due.push_back(m_heap.top().key);
+            m_scheduled.erase(m_heap.top().key);
+            m_heap.pop();
+            drop_stale();
+        }
+        return due;
+    }
+
+    bool contains(const T& key) const { return m_scheduled.contains(key); }
+
+    size_t size() const { return m_scheduled.size(); }
+
+    bool empty() const { return m_scheduled.empty(); }
+
+    void clear() {
+        m_scheduled.clear();
+        m_heap = {};
+    }
+
+protected:
+    struct Schedule {
+        std::chrono::sys_days boundary;
+        unsigned long generation;
+    };
+
+    struct Entry {
+        std::chrono::sys_days boundary;
+        unsigned long generation;
+        T key;
+
+        bool operator>(const Entry& other) const {
+            return boundary > other.boundary;
+        }
+    };
+
+    bool is_stale(const Entry& entry) const {
+        auto it = m_scheduled.find(entry.key);
+        return it == m_scheduled.end() ||
+               it->second.generation != entry.generation;
+    }
+
+    void drop_stale() {
+        while (!m_heap.empty() && is_stale(m_heap.top())) {
+            m_heap.pop();
+        }
+    }
+
+    void compact() {
+        if (m_heap.size() <= 2 * m_scheduled.size() + 64) {
+            return;
+        }
+
+        std::vector<Entry> live;
+        live.reserve(m_scheduled.size());
+        for (const auto& [key, schedule] : m_scheduled) {
+            live.push_back(Entry{schedule.boundary, schedule.generation, key});
+        }
+        m_heap = decltype(m_heap){std::greater<Entry>{}, std::move(live)};
+    }
+
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> m_heap;
+    std::unordered_map<T, Schedule> m_scheduled;
+    unsigned long m_generation = 0;
+};
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Growable set of bits packed in 64-bit words.
+ *
+ * @details Bitsets of different sizes can be combined. Missing bits are
+ * treated as unset, so a bitset only has to grow as far as its highest set
+ * bit.
+ */
+class DynamicBitset {
+public:
+    DynamicBitset() = default;
+
+    bool test(size_t bit) const {
+        const size_t word = bit / WORD_BITS;
+        return word < m_words.size() &&
+               (m_words[word] >> (bit % WORD_BITS)) & 1;
+    }
+
+    void set(size_t bit, bool value = true) {
+        const size_t word = bit / WORD_BITS;
+        if (word >= m_words.size()) {
+            if (!value) {
+                return;
+            }
+            m_words.resize(word + 1, 0);
+        }
+
+        const uint64_t mask = uint64_t{1} << (bit % WORD_BITS);
+        m_words[word] = value ? m_words[word] | mask : m_words[word] & ~mask;
+    }
+
+    void reset(size_t bit) { set(bit, false); }
+
+    void clear() { m_words.clear(); }
+
+    /**
+     * @brief Number of set bits
+     */
+    size_t count() const {
+        size_t n = 0;
+        for (const uint64_t word : m_words) {
+            n += std::popcount(word);
+        }
+        return n;
+    }
+
+    bool none() const {
+        for (const uint64_t word : m_words) {
+            if (word) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    DynamicBitset& operator&=(const DynamicBitset& other) {
+        if (m_words.size() > other.m_words.size()) {
+            m_words.resize(other.m_words.size());
+        }
+        for (size_t i = 0; i < m_words.size(); i++) {
+            m_words[i] &= other.m_words[i];
+        }
+        return *this;
+    }
+
+    DynamicBitset& operator|=(const DynamicBitset& other) {
+        if (m_words.size() < other.m_words.size()) {
+            m_words.resize(other.m_words.size(), 0);
+        }
+        for (size_t i = 0; i < other.m_words.size(); i++) {
+            m_words[i] |= other.m_words[i];
+        }
+        return *this;
+    }
+
+    DynamicBitset& operator^=(const DynamicBitset& other) {
+        if (m_words.size() < other.m_words.size()) {
+            m_words.resize(other.m_words.size(), 0);
+        }
+        for (size_t i = 0; i < other.m_words.size(); i++) {
+            m_words[i] ^= other.m_words[i];
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Calls f with the position of every set bit, in increasing order
+     */
+    template <typename F>
+    void for_each(F&& f) const {
+        for (size_t i = 0; i < m_words.size(); i++) {
+            for (uint64_t word = m_words[i]; word; word &= word - 1) {
+                f(i * WORD_BITS + std::countr_zero(word));
+            }
+        }
+    }
+
+protected:
+    static constexpr size_t WORD_BITS = 64;
+
+    std::vector<uint64_t> m_words;
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <string>
+
+/**
+ * @brief Escapes backslashes, tabs and line breaks, so a text can be stored as
+ * a tab separated field of a line
+ */
+inline std::string escape_field(const std::string& text) {
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (const char c : text) {
+        switch (c) {
+            case '\\':
+                escaped += "\\\\";
+                break;
+            case '\t':
+                escaped += "\\t";
+                break;
+            case '\n':
+                escaped += "\\n";
+                break;
+            case '\r':
+                escaped += "\\r";
+                break;
+            default:
+                escaped += c;
+        }
+    }
+    return escaped;
+}
+
+/**
+ * @brief Reverts escape_field
+ */
+inline std::string unescape_field(const std::string& text) {
+    std::string unescaped;
+    unescaped.reserve(text.size());
+    for (size_t i = 0; i < text.size(); i++) {
+        if (text[i] != '\\' || i + 1 == text.size()) {
+            unescaped += text[i];
+            continue;
+        }
+        switch (text[++i]) {
+            case 't':
+                unescaped += '\t';
+                break;
+            case 'n':
+                unescaped += '\n';
+                break;
+            case 'r':
+                unescaped += '\r';
+                break;
+            default:
+                unescaped += text[i];
+        }
+    }
+    return unescaped;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <string>
+
+/**
+ * @brief Returns the size and last write time of a file, or an empty string if
+ * the file cannot be looked at
+ *
+ * @details Indexes stored next to a board file keep the stamp of the file they
+ * were built from, and are only trusted while the file has the same stamp.
+ * Unlike comparing modification times, this tells apart writes made within the
+ * same tick of the file clock, unless they leave the file the same size
+ */
+inline std::string file_stamp(const std::string& filename) {
+    std::error_code ec;
+    const uintmax_t size = std::filesystem::file_size(filename, ec);
+    if (ec) {
+        return "";
+    }
+    const auto written = std::filesystem::last_write_time(filename, ec);
+    if (ec) {
+        return "";
+    }
+    return std::format("{}-{}", size, written.time_since_epoch().count());
+}
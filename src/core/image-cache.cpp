@@ -0,0 +1,230 @@
+#include "image-cache.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <format>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+ImageCache::ImageCache(const std::string& dir, uintmax_t max_size)
+    : m_dir{dir}, m_max_size{max_size} {
+    std::error_code ec;
+    fs::create_directories(m_dir, ec);
+
+    struct Found {
+        std::string key;
+        uintmax_t size;
+        fs::file_time_type written;
+    };
+    std::vector<Found> found;
+    for (const auto& dir_entry : fs::directory_iterator(m_dir, ec)) {
+        const std::string key = dir_entry.path().filename().string();
+        if (!dir_entry.is_regular_file(ec) ||
+            key.find(".tmp-") != std::string::npos) {
+            continue;
+        }
+        found.push_back({key, dir_entry.file_size(ec),
+                         dir_entry.last_write_time(ec)});
+    }
+
+    // Most recently written first
+    std::sort(found.begin(), found.end(),
+              [](const Found& a, const Found& b) {
+                  return a.written > b.written;
+              });
+    for (const auto& [key, size, written] : found) {
+        const std::string slot = slot_of(key);
+        if (m_slots.contains(slot)) {
+            // An older version of the same image, left behind by a crash
+            fs::remove(path(key), ec);
+            continue;
+        }
+
+        m_lru.push_back(key);
+        m_entries[key] = Entry{size, slot, std::prev(m_lru.end()), {}};
+        m_slots[slot] = key;
+        m_stats.size += size;
+    }
+
+    std::lock_guard<std::mutex> lg{m_mutex};
+    evict();
+}
+
+std::string ImageCache::make_key(const std::string& source,
+                                 const std::string& variant) {
+    const std::string stamp = source_stamp(source);
+    return stamp.empty() ? "" : std::format("{}-{}", stamp, variant);
+}
+
+std::string ImageCache::key(const std::string& source,
+                            const std::string& variant) {
+    const auto now = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lg{m_mutex};
+        auto it = m_stamps.find(source);
+        if (it != m_stamps.end() &&
+            now - it->second.checked < KEY_RECHECK_INTERVAL) {
+            return std::format("{}-{}", it->second.stamp, variant);
+        }
+    }
+
+    // The source is looked at without holding the mutex
+    const std::string stamp = source_stamp(source);
+    if (stamp.empty()) {
+        return "";
+    }
+
+    std::lock_guard<std::mutex> lg{m_mutex};
+    m_stamps[source] = SourceStamp{stamp, now};
+    return std::format("{}-{}", stamp, variant);
+}
+
+ImageCache::Ref ImageCache::lookup(const std::string& key) {
+    std::lock_guard<std::mutex> lg{m_mutex};
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        m_stats.misses++;
+        return nullptr;
+    }
+
+    m_lru.splice(m_lru.begin(), m_lru, it->second.lru);
+    m_stats.hits++;
+    return ref(key, it->second);
+}
+
+std::string ImageCache::path(const std::string& key) const {
+    return (fs::path{m_dir} / key).string();
+}
+
+ImageCache::Ref ImageCache::insert(const std::string& key) {
+    std::error_code ec;
+    const uintmax_t size = fs::file_size(path(key), ec);
+    if (ec) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lg{m_mutex};
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        // Built twice by concurrent callers
+        m_stats.size = m_stats.size - it->second.size + size;
+        it->second.size = size;
+        m_lru.splice(m_lru.begin(), m_lru, it->second.lru);
+        return ref(key, it->second);
+    }
+
+    const std::string slot = slot_of(key);
+    auto old = m_slots.find(slot);
+    if (old != m_slots.end()) {
+        drop(std::string{old->second});
+        m_stats.invalidations++;
+    }
+
+    m_lru.push_front(key);
+    Entry& entry = m_entries[key] = Entry{size, slot, m_lru.begin(), {}};
+    m_slots[slot] = key;
+    m_stats.size += size;
+
+    Ref new_ref = ref(key, entry);
+    evict();
+    return new_ref;
+}
+
+void ImageCache::set_max_size(uintmax_t max_size) {
+    std::lock_guard<std::mutex> lg{m_mutex};
+    m_max_size = max_size;
+    evict();
+}
+
+uintmax_t ImageCache::max_size() const {
+    std::lock_guard<std::mutex> lg{m_mutex};
+    return m_max_size;
+}
+
+ImageCacheStats ImageCache::stats() const {
+    std::lock_guard<std::mutex> lg{m_mutex};
+    ImageCacheStats stats = m_stats;
+    stats.n_entries = m_entries.size();
+    return stats;
+}
+
+std::string ImageCache::source_stamp(const std::string& source) {
+    std::error_code ec;
+    const uintmax_t size = fs::file_size(source, ec);
+    if (ec) {
+        return "";
+    }
+    const auto written = fs::last_write_time(source, ec);
+    if (ec) {
+        return "";
+    }
+
+    // FNV-1a, only meant to tell sources apart in a file name
+    uint64_t hash = 14695981039346656037ull;
+    for (const unsigned char c : source) {
+        hash = (hash ^ c) * 1099511628211ull;
+    }
+
+    // The file clock's epoch is implementation defined and times may be
+    // negative, they are written as unsigned so keys keep their layout
+    return std::format(
+        "{:016x}-{}-{:x}", hash, size,
+        static_cast<uint64_t>(written.time_since_epoch().count()));
+}
+
+std::string ImageCache::slot_of(const std::string& key) {
+    // <source hash>-<size>-<modification time>-<variant>
+    const size_t size_start = key.find('-');
+    const size_t time_start = size_start == std::string::npos
+                                  ? std::string::npos
+                                  : key.find('-', size_start + 1);
+    const size_t variant_start = time_start == std::string::npos
+                                     ? std::string::npos
+                                     : key.find('-', time_start + 1);
+    if (variant_start == std::string::npos) {
+        // Not made by make_key, so it has no other versions
+        return key;
+    }
+    return key.substr(0, size_start) + key.substr(variant_start);
+}
+
+void ImageCache::drop(const std::string& key) {
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        return;
+    }
+
+    std::error_code ec;
+    fs::remove(path(key), ec);
+
+    m_stats.size -= it->second.size;
+    m_lru.erase(it->second.lru);
+    m_slots.erase(it->second.slot);
+    m_entries.erase(it);
+}
+
+ImageCache::Ref ImageCache::ref(const std::string& key, Entry& entry) {
+    Ref entry_ref = entry.ref.lock();
+    if (!entry_ref) {
+        entry_ref = std::make_shared<const std::string>(path(key));
+        entry.ref = entry_ref;
+    }
+    return entry_ref;
+}
+
+void ImageCache::evict() {
+    if (m_lru.empty()) {
+        return;
+    }
+
+    // The loop stops before reaching the most recent entry
+    auto it = std::prev(m_lru.end());
+    while (m_stats.size > m_max_size && it != m_lru.begin()) {
+        auto victim = it--;
+        if (m_entries.at(*victim).ref.expired()) {
+            drop(std::string{*victim});
+            m_stats.evictions++;
+        }
+    }
+}
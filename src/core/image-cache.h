@@ -0,0 +1,171 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @brief Counters describing how an ImageCache has been used
+ */
+struct ImageCacheStats {
+    size_t n_entries = 0;
+    uintmax_t size = 0;
+
+    /**
+     * @brief Lookups answered from the cache
+     */
+    size_t hits = 0;
+
+    /**
+     * @brief Lookups that found nothing
+     */
+    size_t misses = 0;
+
+    /**
+     * @brief Entries dropped to stay under the size cap
+     */
+    size_t evictions = 0;
+
+    /**
+     * @brief Entries dropped because their source image changed
+     */
+    size_t invalidations = 0;
+};
+
+/**
+ * @brief Size-bounded, least recently used cache of images derived from other
+ * images (compressed backgrounds, thumbnails...).
+ *
+ * @details Every entry is a file in the cache directory named after its key.
+ * Keys are made of the source's path, size and modification time together with
+ * a variant (e.g. the quality of the derived image), so a modified source never
+ * maps to a stale entry. The directory is scanned once on construction, and
+ * from then on lookups only use an in-memory index. Recency is kept in memory:
+ * on construction, entries are ordered by the time they were written.
+ *
+ * Lookups and insertions hand out a Ref to the entry. Entries are not evicted
+ * while a Ref to them is alive, so their file can be read in the meantime.
+ *
+ * All methods are thread-safe.
+ */
+class ImageCache {
+public:
+    /**
+     * @brief Filename of a cache entry, which is kept from being evicted as
+     * long as the reference lives. Empty references mean "not cached"
+     */
+    using Ref = std::shared_ptr<const std::string>;
+
+    /**
+     * @brief Time during which key() reuses the key made for a source instead
+     * of looking at the source again
+     */
+    static constexpr std::chrono::seconds KEY_RECHECK_INTERVAL{2};
+
+    /**
+     * @param dir cache directory. It is created if needed
+     * @param max_size largest size, in bytes, of all the entries together
+     */
+    ImageCache(const std::string& dir, uintmax_t max_size);
+
+    /**
+     * @brief Returns the key of a source image's variant, or an empty string
+     * if the source cannot be read
+     */
+    static std::string make_key(const std::string& source,
+                                const std::string& variant);
+
+    /**
+     * @brief Same as make_key, but the source is only looked at again once
+     * KEY_RECHECK_INTERVAL has passed. Changes made to the source in the
+     * meantime are noticed late
+     */
+    std::string key(const std::string& source, const std::string& variant);
+
+    /**
+     * @brief Returns the entry for the key and marks it as the most recently
+     * used, or an empty reference if the key is not cached
+     */
+    Ref lookup(const std::string& key);
+
+    /**
+     * @brief Returns where the entry for the key is (or has to be) written
+     */
+    std::string path(const std::string& key) const;
+
+    /**
+     * @brief Adds the entry written at path(key) to the index. Older entries
+     * of the same source and variant are dropped, and least recently used
+     * entries are evicted until the cache fits its size cap again. The new
+     * entry itself is never evicted
+     *
+     * @return the new entry, or an empty reference if nothing was written at
+     * path(key)
+     */
+    Ref insert(const std::string& key);
+
+    void set_max_size(uintmax_t max_size);
+    uintmax_t max_size() const;
+
+    ImageCacheStats stats() const;
+
+protected:
+    struct Entry {
+        uintmax_t size = 0;
+        std::string slot;
+        std::list<std::string>::iterator lru;
+        std::weak_ptr<const std::string> ref;
+    };
+
+    struct SourceStamp {
+        std::string stamp;
+        std::chrono::steady_clock::time_point checked;
+    };
+
+    /**
+     * @brief Returns the part of a key describing the source's version, or an
+     * empty string if the source cannot be read
+     */
+    static std::string source_stamp(const std::string& source);
+
+    /**
+     * @brief Returns the part of a key shared by every version of the same
+     * source and variant
+     */
+    static std::string slot_of(const std::string& key);
+
+    /**
+     * @brief Returns a reference to an indexed entry, sharing the live one if
+     * there is any. The mutex must be held
+     */
+    Ref ref(const std::string& key, Entry& entry);
+
+    /**
+     * @brief Drops an entry from the index and deletes its file. The mutex
+     * must be held
+     */
+    void drop(const std::string& key);
+
+    /**
+     * @brief Evicts least recently used entries, sparing the most recent one
+     * and the referenced ones, until the cache fits its cap. The mutex must be
+     * held
+     */
+    void evict();
+
+    const std::string m_dir;
+    uintmax_t m_max_size;
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, Entry> m_entries;
+    std::unordered_map<std::string, std::string> m_slots;
+    std::unordered_map<std::string, SourceStamp> m_stamps;
+
+    // Most recently used keys first
+    std::list<std::string> m_lru;
+    ImageCacheStats m_stats;
+};
@@ -1,7 +1,22 @@
 #include "item-container.h"
 
+#include <algorithm>
+
 #include "cardlist.h"
 
+namespace {
+/**
+ * @brief Returns the position of an item in a container's data, or -1 if it is
+ * not part of it
+ */
+template <typename T>
+ssize_t index_of(const std::vector<std::shared_ptr<T>>& data,
+                 const std::shared_ptr<T>& item) {
+    auto it = std::find(data.begin(), data.end(), item);
+    return it == data.end() ? -1 : std::distance(data.begin(), it);
+}
+}  // namespace
+
 template <typename T>
     requires std::is_base_of_v<Item, T> && std::is_base_of_v<Modifiable, T>
 ItemContainer<T>::ItemContainer() : m_data() {}
@@ -31,6 +46,25 @@ void ItemContainer<T>::remove(std::shared_ptr<T>& item) {
     }
 }
 
+template <typename T>
+    requires std::is_base_of_v<Item, T> && std::is_base_of_v<Modifiable, T>
+void ItemContainer<T>::insert(std::shared_ptr<T>& item, ssize_t index) {
+    for (auto& i_item : m_data) {
+        if (i_item == item) {
+            return;
+        }
+    }
+
+    if (index < 0 || index >= size()) {
+        append(item);
+        return;
+    }
+
+    m_data.insert(std::next(m_data.begin(), index), item);
+    modify();
+    on_insert_signal.emit(item, index);
+}
+
 template <typename T>
     requires std::is_base_of_v<Item, T> && std::is_base_of_v<Modifiable, T>
 void ItemContainer<T>::insert_after(std::shared_ptr<T>& item,
@@ -60,6 +94,7 @@ void ItemContainer<T>::insert_after(std::shared_ptr<T>& item,
         m_data.insert(sibling_it, item);
     }
     modify();
+    on_insert_signal.emit(item, index + 1);
 }
 
 template <typename T>
@@ -88,6 +123,7 @@ void ItemContainer<T>::insert_before(std::shared_ptr<T>& item,
 
     m_data.insert(sibling_it, item);
     modify();
+    on_insert_signal.emit(item, index);
 }
 
 template <typename T>
@@ -158,6 +194,95 @@ void ItemContainer<T>::reorder_before(std::shared_ptr<T>& next,
     on_reorder_signal.emit(next, sibling, ReorderingType::BEFORE);
 }
 
+template <typename T>
+    requires std::is_base_of_v<Item, T> && std::is_base_of_v<Modifiable, T>
+bool ItemContainer<T>::move(std::shared_ptr<T>& item, ItemContainer<T>& from,
+                            ItemContainer<T>& to, ssize_t position) {
+    auto it = std::find(from.m_data.begin(), from.m_data.end(), item);
+    if (it == from.m_data.end()) {
+        return false;
+    }
+    const ssize_t from_index = std::distance(from.m_data.begin(), it);
+
+    // Once the item is taken out, to has one item less if it is from
+    const ssize_t last = &from == &to ? to.size() - 1 : to.size();
+    splice(from, from_index, to,
+           position < 0 || position > last ? last : position);
+    return true;
+}
+
+template <typename T>
+    requires std::is_base_of_v<Item, T> && std::is_base_of_v<Modifiable, T>
+bool ItemContainer<T>::move(std::shared_ptr<T>& item, ItemContainer<T>& from,
+                            ItemContainer<T>& to,
+                            const std::shared_ptr<T>& sibling,
+                            ReorderingType where) {
+    if (where == ReorderingType::INVALID || item == sibling) {
+        return false;
+    }
+
+    ssize_t from_index = -1, sibling_index = -1;
+    if (&from == &to) {
+        for (ssize_t i = 0;
+             i < from.size() && (from_index == -1 || sibling_index == -1);
+             i++) {
+            if (from.m_data[i] == item) {
+                from_index = i;
+            } else if (from.m_data[i] == sibling) {
+                sibling_index = i;
+            }
+        }
+    } else {
+        from_index = index_of(from.m_data, item);
+        sibling_index = index_of(to.m_data, sibling);
+    }
+    if (from_index == -1 || sibling_index == -1) {
+        return false;
+    }
+
+    // Positions are counted once the item is taken out
+    if (&from == &to && from_index < sibling_index) {
+        sibling_index--;
+    }
+    splice(from, from_index, to,
+           where == ReorderingType::AFTER ? sibling_index + 1 : sibling_index);
+    return true;
+}
+
+template <typename T>
+    requires std::is_base_of_v<Item, T> && std::is_base_of_v<Modifiable, T>
+void ItemContainer<T>::splice(ItemContainer<T>& from, ssize_t from_index,
+                              ItemContainer<T>& to, ssize_t to_index) {
+    auto it = std::next(from.m_data.begin(), from_index);
+
+    // The caller's item may be a reference to the very element being moved
+    std::shared_ptr<T> moved = *it;
+
+    if (&from == &to) {
+        if (to_index == from_index) {
+            return;
+        }
+
+        auto target = std::next(to.m_data.begin(), to_index);
+        if (from_index < to_index) {
+            std::rotate(it, std::next(it), std::next(target));
+        } else {
+            std::rotate(target, it, std::next(it));
+        }
+        to.modify();
+        to.on_move_signal.emit(moved, &from, from_index, &to, to_index);
+        return;
+    }
+
+    from.m_data.erase(it);
+    to.m_data.insert(std::next(to.m_data.begin(), to_index), moved);
+
+    from.modify();
+    to.modify();
+    from.on_move_signal.emit(moved, &from, from_index, &to, to_index);
+    to.on_move_signal.emit(moved, &from, from_index, &to, to_index);
+}
+
 template <typename T>
     requires std::is_base_of_v<Item, T> && std::is_base_of_v<Modifiable, T>
 std::vector<std::shared_ptr<T>>& ItemContainer<T>::get_data() {
@@ -227,6 +352,13 @@ sigc::signal<void(std::shared_ptr<T>)>& ItemContainer<T>::signal_remove() {
     return on_remove_signal;
 }
 
+template <typename T>
+    requires std::is_base_of_v<Item, T> && std::is_base_of_v<Modifiable, T>
+sigc::signal<void(std::shared_ptr<T>, ssize_t)>&
+ItemContainer<T>::signal_insert() {
+    return on_insert_signal;
+}
+
 template <typename T>
     requires std::is_base_of_v<Item, T> && std::is_base_of_v<Modifiable, T>
 sigc::signal<void(std::shared_ptr<T>, std::shared_ptr<T>, ReorderingType)>&
@@ -234,6 +366,14 @@ ItemContainer<T>::signal_reorder() {
     return on_reorder_signal;
 }
 
+template <typename T>
+    requires std::is_base_of_v<Item, T> && std::is_base_of_v<Modifiable, T>
+sigc::signal<void(std::shared_ptr<T>, ItemContainer<T>*, ssize_t,
+                  ItemContainer<T>*, ssize_t)>&
+ItemContainer<T>::signal_move() {
+    return on_move_signal;
+}
+
 template class ItemContainer<CardList>;
 template class ItemContainer<Card>;
 template class ItemContainer<Task>;
@@ -48,6 +48,17 @@ public:
      */
     virtual void remove(std::shared_ptr<T>& item);
 
+    /**
+     * @brief Inserts an item at the given position.
+     *
+     * @details Positions past the end of the container append the item.
+     * Nothing is done if the item is already in the container.
+     *
+     * @param item The item to insert.
+     * @param index Position the item will occupy once inserted.
+     */
+    virtual void insert(std::shared_ptr<T>& item, ssize_t index);
+
     virtual void insert_after(std::shared_ptr<T>& item,
                               std::shared_ptr<T>& sibling);
     virtual void insert_before(std::shared_ptr<T>& item,
@@ -59,6 +70,42 @@ public:
     virtual void reorder_before(std::shared_ptr<T>& next,
                                 std::shared_ptr<T>& sibling);
 
+    /**
+     * @brief Moves an item to a position of another container, or to another
+     * position of the same container.
+     *
+     * @details The item is spliced out of from and into to as is, so it keeps
+     * its identity and nothing holding it has to be rebound. It is looked up
+     * once and only the items between its old and new positions are shifted.
+     * Instead of remove and insert signals, each container involved emits
+     * signal_move() once.
+     *
+     * The item must not already be part of to, unless both containers are the
+     * same one.
+     *
+     * @param position Position the item occupies in to once moved. Negative
+     * positions and positions past the end leave the item last.
+     *
+     * @return false if the item is not part of from
+     */
+    static bool move(std::shared_ptr<T>& item, ItemContainer<T>& from,
+                     ItemContainer<T>& to, ssize_t position);
+
+    /**
+     * @brief Moves an item right after (or right before) a sibling of another
+     * container, or of the same one. Works like move(item, from, to,
+     * position), but both items are looked up in a single pass when the
+     * containers are the same.
+     *
+     * @param where ReorderingType::AFTER or ReorderingType::BEFORE
+     *
+     * @return false, without moving anything, if the item is not part of from,
+     * the sibling is not part of to, or both are the same item
+     */
+    static bool move(std::shared_ptr<T>& item, ItemContainer<T>& from,
+                     ItemContainer<T>& to, const std::shared_ptr<T>& sibling,
+                     ReorderingType where);
+
     void modify(bool m = true) override;
 
     ssize_t size() const;
@@ -97,16 +144,35 @@ public:
 
     sigc::signal<void(std::shared_ptr<T>)>& signal_append();
     sigc::signal<void(std::shared_ptr<T>)>& signal_remove();
+    sigc::signal<void(std::shared_ptr<T>, ssize_t)>& signal_insert();
     sigc::signal<void(std::shared_ptr<T>, std::shared_ptr<T>, ReorderingType)>&
     signal_reorder();
 
+    /**
+     * @brief void(item, from, from_index, to, to_index)
+     */
+    sigc::signal<void(std::shared_ptr<T>, ItemContainer<T>*, ssize_t,
+                      ItemContainer<T>*, ssize_t)>&
+    signal_move();
+
 protected:
+    /**
+     * @brief Moves the item found at from_index of from to to_index of to,
+     * which must both be valid positions once the item is taken out
+     */
+    static void splice(ItemContainer<T>& from, ssize_t from_index,
+                       ItemContainer<T>& to, ssize_t to_index);
+
     std::vector<std::shared_ptr<T>> m_data;
     bool m_modified = false;
 
     // Signals
     sigc::signal<void(std::shared_ptr<T>)> on_append_signal;
     sigc::signal<void(std::shared_ptr<T>)> on_remove_signal;
+    sigc::signal<void(std::shared_ptr<T>, ssize_t)> on_insert_signal;
     sigc::signal<void(std::shared_ptr<T>, std::shared_ptr<T>, ReorderingType)>
         on_reorder_signal;
+    sigc::signal<void(std::shared_ptr<T>, ItemContainer<T>*, ssize_t,
+                      ItemContainer<T>*, ssize_t)>
+        on_move_signal;
 };
@@ -0,0 +1,254 @@
+#pragma once
+
+#include <sys/types.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Keeps track of the position of every item of an ordered sequence.
+ *
+ * @details Items are kept in a treap ordered by position, where every node
+ * knows the size of its subtree and its parent. Looking up, inserting, removing
+ * and moving an item are O(log n) (expected), while membership tests are O(1).
+ * This lets containers of widgets answer "where is this child" without walking
+ * their whole list of children.
+ */
+template <typename T>
+class PositionIndex {
+public:
+    PositionIndex() = default;
+    PositionIndex(const PositionIndex&) = delete;
+    PositionIndex& operator=(const PositionIndex&) = delete;
+
+    bool contains(const T& item) const { return m_nodes.contains(item); }
+
+    size_t size() const { return m_nodes.size(); }
+
+    bool empty() const { return m_nodes.empty(); }
+
+    /**
+     * @brief Returns the item's position, or -1 if the item is not indexed
+     */
+    ssize_t index_of(const T& item) const {
+        auto it = m_nodes.find(item);
+        if (it == m_nodes.end()) {
+            return -1;
+        }
+        return position(&it->second);
+    }
+
+    /**
+     * @brief Returns the item at the given position, which must be lower than
+     * size()
+     */
+    const T& at(size_t index) const {
+        const Node* node = m_root;
+        while (true) {
+            const size_t n_left = size_of(node->left);
+            if (index < n_left) {
+                node = node->left;
+            } else if (index == n_left) {
+                return *node->item;
+            } else {
+                index -= n_left + 1;
+                node = node->right;
+            }
+        }
+    }
+
+    /**
+     * @brief Inserts an item at the given position. Positions past the end
+     * append the item
+     *
+     * @return false if the item was already indexed
+     */
+    bool insert(const T& item, size_t index) {
+        if (contains(item)) {
+            return false;
+        }
+
+        const size_t n_items = size();
+        auto it = m_nodes.try_emplace(item).first;
+        Node* node = &it->second;
+        node->item = &it->first;
+        node->priority = m_rng();
+        attach(node, std::min(index, n_items));
+        return true;
+    }
+
+    bool append(const T& item) { return insert(item, size()); }
+
+    /**
+     * @brief Inserts an item right after an indexed sibling
+     *
+     * @return false if the item was already indexed or the sibling is not
+     */
+    bool insert_after(const T& item, const T& sibling) {
+        const ssize_t sibling_i = index_of(sibling);
+        if (sibling_i == -1) {
+            return false;
+        }
+        return insert(item, sibling_i + 1);
+    }
+
+    /**
+     * @return false if the item was not indexed
+     */
+    bool erase(const T& item) {
+        auto it = m_nodes.find(item);
+        if (it == m_nodes.end()) {
+            return false;
+        }
+
+        detach(&it->second);
+        m_nodes.erase(it);
+        return true;
+    }
+
+    /**
+     * @brief Moves an indexed item right after another one
+     *
+     * @return false if either item is not indexed, or both are the same
+     */
+    bool move_after(const T& item, const T& sibling) {
+        return move(item, sibling, 1);
+    }
+
+    /**
+     * @brief Moves an indexed item right before another one
+     *
+     * @return false if either item is not indexed, or both are the same
+     */
+    bool move_before(const T& item, const T& sibling) {
+        return move(item, sibling, 0);
+    }
+
+    /**
+     * @brief Returns the indexed items in order
+     */
+    std::vector<T> items() const {
+        std::vector<T> items;
+        items.reserve(size());
+
+        std::vector<const Node*> stack;
+        const Node* node = m_root;
+        while (node || !stack.empty()) {
+            for (; node; node = node->left) {
+                stack.push_back(node);
+            }
+            node = stack.back();
+            stack.pop_back();
+            items.push_back(*node->item);
+            node = node->right;
+        }
+        return items;
+    }
+
+    void clear() {
+        m_nodes.clear();
+        m_root = nullptr;
+    }
+
+protected:
+    struct Node {
+        Node *left = nullptr, *right = nullptr, *parent = nullptr;
+        size_t size = 1;
+        uint32_t priority = 0;
+        const T* item = nullptr;
+    };
+
+    static size_t size_of(const Node* node) { return node ? node->size : 0; }
+
+    static void update(Node* node) {
+        node->size = 1 + size_of(node->left) + size_of(node->right);
+        if (node->left) node->left->parent = node;
+        if (node->right) node->right->parent = node;
+    }
+
+    /**
+     * @brief Splits the first count nodes of a subtree into left, and the
+     * remaining ones into right
+     */
+    static void split(Node* node, size_t count, Node*& left, Node*& right) {
+        if (!node) {
+            left = right = nullptr;
+            return;
+        }
+
+        if (size_of(node->left) < count) {
+            split(node->right, count - size_of(node->left) - 1, node->right,
+                  right);
+            left = node;
+        } else {
+            split(node->left, count, left, node->left);
+            right = node;
+        }
+        update(node);
+    }
+
+    static Node* merge(Node* left, Node* right) {
+        if (!left || !right) {
+            return left ? left : right;
+        }
+
+        if (left->priority > right->priority) {
+            left->right = merge(left->right, right);
+            update(left);
+            return left;
+        }
+        right->left = merge(left, right->left);
+        update(right);
+        return right;
+    }
+
+    static size_t position(const Node* node) {
+        size_t index = size_of(node->left);
+        for (; node->parent; node = node->parent) {
+            if (node == node->parent->right) {
+                index += size_of(node->parent->left) + 1;
+            }
+        }
+        return index;
+    }
+
+    void attach(Node* node, size_t index) {
+        Node *left, *right;
+        split(m_root, index, left, right);
+        m_root = merge(merge(left, node), right);
+        m_root->parent = nullptr;
+    }
+
+    void detach(Node* node) {
+        Node *left, *rest, *detached, *right;
+        split(m_root, position(node), left, rest);
+        split(rest, 1, detached, right);
+        m_root = merge(left, right);
+        if (m_root) {
+            m_root->parent = nullptr;
+        }
+
+        node->left = node->right = node->parent = nullptr;
+        node->size = 1;
+    }
+
+    bool move(const T& item, const T& sibling, size_t offset) {
+        auto item_it = m_nodes.find(item);
+        auto sibling_it = m_nodes.find(sibling);
+        if (item_it == m_nodes.end() || sibling_it == m_nodes.end() ||
+            item_it == sibling_it) {
+            return false;
+        }
+
+        detach(&item_it->second);
+        attach(&item_it->second, position(&sibling_it->second) + offset);
+        return true;
+    }
+
+    std::unordered_map<T, Node> m_nodes;
+    Node* m_root = nullptr;
+    std::minstd_rand m_rng{std::random_device{}()};
+};
@@ -0,0 +1,379 @@
+#include "search-index.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+#include "field-escape.h"
+#include "file-stamp.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+constexpr const char* SEARCH_FILE_HEADER = "progress-search 2";
+
+std::vector<std::string> trigrams(const std::string& word) {
+    std::vector<std::string> word_trigrams;
+    for (size_t i = 0; i + 3 <= word.size(); i++) {
+        word_trigrams.push_back(word.substr(i, 3));
+    }
+    return word_trigrams;
+}
+
+/**
+ * @brief Returns the distinct words of a text
+ */
+std::vector<std::string> unique_words(const std::string& text) {
+    std::vector<std::string> words = SearchIndex::tokenize(text);
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+    return words;
+}
+
+/**
+ * @brief Reads the kind, id and text of an item from its line in the stored
+ * texts
+ *
+ * @return false if the line is malformed
+ */
+bool parse_item(const std::string& line, SearchItemKind& kind,
+                std::string& item_id, std::string& text) {
+    const size_t id_start = line.find('\t');
+    const size_t text_start = id_start == std::string::npos
+                                  ? std::string::npos
+                                  : line.find('\t', id_start + 1);
+    if (text_start == std::string::npos) {
+        return false;
+    }
+
+    const int kind_value = std::atoi(line.substr(0, id_start).c_str());
+    if (kind_value < static_cast<int>(SearchItemKind::BOARD) ||
+        kind_value > static_cast<int>(SearchItemKind::TASK)) {
+        return false;
+    }
+    kind = static_cast<SearchItemKind>(kind_value);
+    item_id = line.substr(id_start + 1, text_start - id_start - 1);
+    text = unescape_field(line.substr(text_start + 1));
+    return true;
+}
+}  // namespace
+
+std::string SearchIndex::search_filename(const std::string& filename) {
+    return fs::path{filename}.replace_extension(".search").string();
+}
+
+std::vector<std::string> SearchIndex::tokenize(const std::string& text) {
+    std::vector<std::string> words;
+    std::string word;
+    for (const char c : text) {
+        const unsigned char byte = c;
+        // Bytes of multi-byte UTF-8 characters are kept as part of the word
+        if (std::isalnum(byte) || byte >= 0x80) {
+            word += static_cast<char>(std::tolower(byte));
+        } else if (!word.empty()) {
+            words.push_back(std::move(word));
+            word.clear();
+        }
+    }
+    if (!word.empty()) {
+        words.push_back(std::move(word));
+    }
+    return words;
+}
+
+void SearchIndex::update(const std::string& filename, Board& board,
+                         const std::string& stamp) {
+    const std::string board_stamp =
+        stamp.empty() ? file_stamp(filename) : stamp;
+    std::ostringstream texts;
+    texts << SEARCH_FILE_HEADER << '\t' << board_stamp << '\t'
+          << escape_field(board.get_name()) << '\n';
+    std::vector<Doc> docs;
+    const auto add_doc = [&](SearchItemKind kind, const Item& item,
+                             const std::string& text) {
+        docs.push_back(Doc{texts.tellp(), unique_words(text)});
+        texts << static_cast<int>(kind) << '\t' << item.get_id().str() << '\t'
+              << escape_field(text) << '\n';
+    };
+
+    add_doc(SearchItemKind::BOARD, board, board.get_name());
+    for (const auto& cardlist : board.container()) {
+        add_doc(SearchItemKind::CARDLIST, *cardlist, cardlist->get_name());
+        for (const auto& card : cardlist->container()) {
+            add_doc(SearchItemKind::CARD, *card, card->get_name());
+            if (!card->get_notes().empty()) {
+                add_doc(SearchItemKind::NOTES, *card, card->get_notes());
+            }
+            for (const auto& task : card->container()) {
+                add_doc(SearchItemKind::TASK, *task, task->get_name());
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> file_lg{m_file_mutex};
+    const std::string stored = search_filename(filename);
+    std::ofstream search_file{stored, std::ios::binary | std::ios::trunc};
+    search_file << texts.str();
+    search_file.close();
+
+    std::lock_guard<std::mutex> lg{m_mutex};
+    if (search_file.fail()) {
+        // Hits could not be read back
+        drop(filename);
+        std::error_code ec;
+        fs::remove(stored, ec);
+        return;
+    }
+    index(filename, board.get_name(), board_stamp, std::move(docs));
+}
+
+bool SearchIndex::load(const std::string& filename) {
+    std::lock_guard<std::mutex> file_lg{m_file_mutex};
+    const std::string stamp = file_stamp(filename);
+    if (stamp.empty()) {
+        return false;
+    }
+
+    // The header holds the stamp of the board file and the board's name
+    std::ifstream search_file{search_filename(filename), std::ios::binary};
+    std::string line;
+    const std::string header =
+        std::format("{}\t{}\t", SEARCH_FILE_HEADER, stamp);
+    if (!std::getline(search_file, line) || !line.starts_with(header)) {
+        return false;
+    }
+    const std::string board_name = unescape_field(line.substr(header.size()));
+
+    std::vector<Doc> docs;
+    for (std::streamoff offset = search_file.tellg();
+         std::getline(search_file, line); offset = search_file.tellg()) {
+        SearchItemKind kind;
+        std::string item_id, text;
+        if (!parse_item(line, kind, item_id, text)) {
+            return false;
+        }
+        docs.push_back(Doc{offset, unique_words(text)});
+    }
+
+    std::lock_guard<std::mutex> lg{m_mutex};
+    index(filename, board_name, stamp, std::move(docs));
+    return true;
+}
+
+void SearchIndex::remove(const std::string& filename) {
+    std::lock_guard<std::mutex> file_lg{m_file_mutex};
+    {
+        std::lock_guard<std::mutex> lg{m_mutex};
+        drop(filename);
+    }
+
+    std::error_code ec;
+    fs::remove(search_filename(filename), ec);
+}
+
+std::vector<SearchHit> SearchIndex::search(const std::string& query,
+                                           SearchMode mode,
+                                           size_t max_hits) const {
+    const std::vector<std::string> query_words = unique_words(query);
+    if (query_words.empty()) {
+        return {};
+    }
+
+    // Hits are read from the stored texts, which must not change meanwhile
+    std::lock_guard<std::mutex> file_lg{m_file_mutex};
+    std::vector<SearchHit> hits;
+    std::vector<std::streamoff> offsets;
+    {
+        std::lock_guard<std::mutex> lg{m_mutex};
+        for (const DocId id : found_docs(query_words, mode, max_hits)) {
+            const std::string& filename =
+                std::prev(m_first_docs.upper_bound(id))->second;
+            const IndexedBoard& board = m_boards.at(filename);
+            // The item itself is read from the board's search file below
+            hits.push_back(SearchHit{filename, board.name,
+                                     SearchItemKind::BOARD, "", ""});
+            offsets.push_back(board.offsets[id - board.first_doc]);
+        }
+    }
+
+    std::unordered_map<std::string, std::ifstream> search_files;
+    std::vector<SearchHit> read_hits;
+    for (size_t i = 0; i < hits.size(); i++) {
+        auto [it, opened] = search_files.try_emplace(hits[i].filename);
+        if (opened) {
+            it->second.open(search_filename(hits[i].filename),
+                            std::ios::binary);
+        }
+        std::ifstream& search_file = it->second;
+        search_file.clear();
+        search_file.seekg(offsets[i]);
+
+        std::string line;
+        if (std::getline(search_file, line) &&
+            parse_item(line, hits[i].kind, hits[i].item_id, hits[i].text)) {
+            read_hits.push_back(std::move(hits[i]));
+        }
+    }
+    return read_hits;
+}
+
+std::vector<SearchIndex::DocId> SearchIndex::found_docs(
+    const std::vector<std::string>& query_words, SearchMode mode,
+    size_t max_hits) const {
+    std::vector<std::vector<DocId>> word_matches;
+    for (const std::string& word : query_words) {
+        word_matches.push_back(matches(word, mode));
+        if (word_matches.back().empty()) {
+            return {};
+        }
+    }
+
+    // Documents have to match every word. Starting from the rarest word keeps
+    // the intersection small
+    std::sort(word_matches.begin(), word_matches.end(),
+              [](const auto& a, const auto& b) { return a.size() < b.size(); });
+    std::vector<DocId> found = std::move(word_matches.front());
+    for (auto it = std::next(word_matches.begin());
+         it != word_matches.end() && !found.empty(); it++) {
+        std::vector<DocId> both;
+        std::set_intersection(found.begin(), found.end(), it->begin(),
+                              it->end(), std::back_inserter(both));
+        found = std::move(both);
+    }
+    if (found.size() > max_hits) {
+        found.resize(max_hits);
+    }
+    return found;
+}
+
+bool SearchIndex::contains(const std::string& filename) const {
+    std::lock_guard<std::mutex> lg{m_mutex};
+    return m_boards.contains(filename);
+}
+
+bool SearchIndex::up_to_date(const std::string& filename,
+                             const std::string& stamp) const {
+    std::lock_guard<std::mutex> lg{m_mutex};
+    auto it = m_boards.find(filename);
+    return it != m_boards.end() && !stamp.empty() && it->second.stamp == stamp;
+}
+
+size_t SearchIndex::n_boards() const {
+    std::lock_guard<std::mutex> lg{m_mutex};
+    return m_boards.size();
+}
+
+size_t SearchIndex::n_words() const {
+    std::lock_guard<std::mutex> lg{m_mutex};
+    return m_words.size();
+}
+
+void SearchIndex::index(const std::string& filename,
+                        const std::string& board_name,
+                        const std::string& stamp, std::vector<Doc> docs) {
+    drop(filename);
+
+    IndexedBoard& board = m_boards[filename];
+    board.name = board_name;
+    board.stamp = stamp;
+    board.first_doc = m_next_doc;
+    m_first_docs.emplace(board.first_doc, filename);
+    for (Doc& doc : docs) {
+        const DocId id = m_next_doc++;
+        for (std::string& word : doc.words) {
+            auto [it, inserted] = m_words.try_emplace(std::move(word));
+            if (inserted) {
+                for (const std::string& trigram : trigrams(it->first)) {
+                    m_trigrams[trigram].insert(it->first);
+                }
+            }
+            // Words already seen in this board end with one of its documents
+            if (it->second.empty() || it->second.back() < board.first_doc) {
+                board.words.push_back(it);
+            }
+            it->second.push_back(id);
+        }
+        board.offsets.push_back(doc.offset);
+    }
+}
+
+void SearchIndex::drop(const std::string& filename) {
+    auto board = m_boards.find(filename);
+    if (board == m_boards.end()) {
+        return;
+    }
+
+    const DocId first = board->second.first_doc;
+    const DocId end = first + board->second.offsets.size();
+    for (const Postings::iterator it : board->second.words) {
+        std::vector<DocId>& docs = it->second;
+        docs.erase(std::lower_bound(docs.begin(), docs.end(), first),
+                   std::lower_bound(docs.begin(), docs.end(), end));
+        if (!docs.empty()) {
+            continue;
+        }
+
+        for (const std::string& trigram : trigrams(it->first)) {
+            auto words = m_trigrams.find(trigram);
+            words->second.erase(it->first);
+            if (words->second.empty()) {
+                m_trigrams.erase(words);
+            }
+        }
+        m_words.erase(it);
+    }
+    m_first_docs.erase(first);
+    m_boards.erase(board);
+}
+
+std::vector<SearchIndex::DocId> SearchIndex::matches(const std::string& word,
+                                                    SearchMode mode) const {
+    std::vector<const std::vector<DocId>*> word_docs;
+    if (mode == SearchMode::PREFIX) {
+        for (auto it = m_words.lower_bound(word);
+             it != m_words.end() && it->first.starts_with(word); it++) {
+            word_docs.push_back(&it->second);
+        }
+    } else if (word.size() < 3) {
+        // Too short to have trigrams, the whole vocabulary is looked at
+        for (const auto& [indexed_word, docs] : m_words) {
+            if (indexed_word.find(word) != std::string::npos) {
+                word_docs.push_back(&docs);
+            }
+        }
+    } else {
+        // Indexed words containing the query word contain all of its
+        // trigrams, the rarest one gives the fewest words to check
+        const std::unordered_set<std::string>* candidates = nullptr;
+        for (const std::string& trigram : trigrams(word)) {
+            auto it = m_trigrams.find(trigram);
+            if (it == m_trigrams.end()) {
+                return {};
+            }
+            if (!candidates || it->second.size() < candidates->size()) {
+                candidates = &it->second;
+            }
+        }
+        for (const std::string& candidate : *candidates) {
+            if (candidate.find(word) != std::string::npos) {
+                word_docs.push_back(&m_words.at(candidate));
+            }
+        }
+    }
+
+    if (word_docs.size() == 1) {
+        return *word_docs.front();
+    }
+    std::vector<DocId> docs;
+    for (const std::vector<DocId>* some_docs : word_docs) {
+        docs.insert(docs.end(), some_docs->begin(), some_docs->end());
+    }
+    std::sort(docs.begin(), docs.end());
+    docs.erase(std::unique(docs.begin(), docs.end()), docs.end());
+    return docs;
+}
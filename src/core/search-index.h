@@ -0,0 +1,193 @@
+#pragma once
+
+#include <ios>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "board.h"
+
+/**
+ * @brief Kind of item a piece of indexed text comes from
+ */
+enum class SearchItemKind { BOARD, CARDLIST, CARD, NOTES, TASK };
+
+/**
+ * @brief How query words are matched against indexed words
+ */
+enum class SearchMode { PREFIX, SUBSTRING };
+
+/**
+ * @brief Item matching a search query
+ */
+struct SearchHit {
+    /**
+     * @brief File of the board the item is part of
+     */
+    std::string filename;
+    std::string board_name;
+    SearchItemKind kind;
+    std::string item_id;
+
+    /**
+     * @brief The item's indexed text (e.g. the card's name or notes)
+     */
+    std::string text;
+};
+
+/**
+ * @brief Inverted index of the names, notes and tasks of many boards.
+ *
+ * @details Texts are split into lowercase words, and every word points to the
+ * items it appears in. Prefix queries walk the sorted vocabulary, and substring
+ * queries narrow the vocabulary down through the trigrams of their words, so no
+ * board has to be loaded to answer a query.
+ *
+ * The indexed texts of each board are stored next to the board file, in a file
+ * with the same name and a ".search" extension, along with the file_stamp() of
+ * the board file they were read from. Boards edited while the index was not
+ * looking are found by comparing that stamp with the board file's. Only the
+ * words and where each item's line starts in that file are kept in memory.
+ * The ids and texts of the hits are read back from it.
+ *
+ * Words are only lowercased in the ASCII range, other characters are matched
+ * as they are.
+ *
+ * All methods are thread-safe. Stored texts are written and read one board at
+ * a time, along with the matching change to the index.
+ */
+class SearchIndex {
+public:
+    /**
+     * @brief Returns where the indexed texts of a board file are stored
+     */
+    static std::string search_filename(const std::string& filename);
+
+    /**
+     * @brief Splits a text into lowercase words
+     */
+    static std::vector<std::string> tokenize(const std::string& text);
+
+    /**
+     * @brief Indexes a fully loaded board, replacing what was indexed for its
+     * file, and stores its texts next to the board file. If they cannot be
+     * stored, the board is dropped from the index
+     *
+     * @param stamp file_stamp() of the board file taken before the board was
+     * read. When empty, the board file's current stamp is used
+     */
+    void update(const std::string& filename, Board& board,
+                const std::string& stamp = "");
+
+    /**
+     * @brief Indexes the texts stored next to a board file
+     *
+     * @return false if there are no stored texts or if the board file was
+     * written since. The board has to be updated then
+     */
+    bool load(const std::string& filename);
+
+    /**
+     * @brief Drops a board from the index and deletes its stored texts
+     */
+    void remove(const std::string& filename);
+
+    /**
+     * @brief Returns the items matching every word of the query, in the order
+     * they were indexed
+     *
+     * @param max_hits largest number of hits returned
+     */
+    std::vector<SearchHit> search(const std::string& query,
+                                  SearchMode mode = SearchMode::PREFIX,
+                                  size_t max_hits = 100) const;
+
+    /**
+     * @brief Returns whether a board file is indexed
+     */
+    bool contains(const std::string& filename) const;
+
+    /**
+     * @brief Returns whether a board file is indexed from its contents as of
+     * the given file_stamp()
+     */
+    bool up_to_date(const std::string& filename,
+                    const std::string& stamp) const;
+
+    size_t n_boards() const;
+    size_t n_words() const;
+
+protected:
+    using DocId = size_t;
+    using Postings = std::map<std::string, std::vector<DocId>>;
+
+    /**
+     * @brief Item about to be indexed
+     */
+    struct Doc {
+        /**
+         * @brief Start of the item's line in the stored texts
+         */
+        std::streamoff offset;
+
+        /**
+         * @brief Distinct words of the item's text
+         */
+        std::vector<std::string> words;
+    };
+
+    struct IndexedBoard {
+        std::string name, stamp;
+
+        // The board's documents have consecutive ids
+        DocId first_doc;
+        std::vector<std::streamoff> offsets;
+
+        // Every word appearing in the board's documents
+        std::vector<Postings::iterator> words;
+    };
+
+    /**
+     * @brief Replaces the documents of a board. The mutex must be held
+     */
+    void index(const std::string& filename, const std::string& board_name,
+               const std::string& stamp, std::vector<Doc> docs);
+
+    /**
+     * @brief Drops the documents of a board. The mutex must be held
+     */
+    void drop(const std::string& filename);
+
+    /**
+     * @brief Returns the sorted documents having a word matching the query
+     * word. The mutex must be held
+     */
+    std::vector<DocId> matches(const std::string& word, SearchMode mode) const;
+
+    /**
+     * @brief Returns the first documents matching every query word. The mutex
+     * must be held
+     */
+    std::vector<DocId> found_docs(const std::vector<std::string>& query_words,
+                                  SearchMode mode, size_t max_hits) const;
+
+    // Held while stored texts are written or read, before m_mutex, so they
+    // always match the index
+    mutable std::mutex m_file_mutex;
+
+    mutable std::mutex m_mutex;
+    DocId m_next_doc = 0;
+    std::unordered_map<std::string, IndexedBoard> m_boards;
+
+    // File of the board owning each document, by the board's first document
+    std::map<DocId, std::string> m_first_docs;
+
+    // Sorted, so words sharing a prefix are next to each other. Documents
+    // get increasing ids, so their lists stay sorted by being appended to
+    Postings m_words;
+    std::unordered_map<std::string, std::unordered_set<std::string>>
+        m_trigrams;
+};
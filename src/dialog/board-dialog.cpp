@@ -2,6 +2,7 @@
 
 #include <adwaita.h>
 #include <glibmm/i18n.h>
+#include <image-pipeline.h>
 #include <spdlog/spdlog.h>
 #include <utils.h>
 
@@ -81,7 +82,7 @@ void BoardDialog::on_filedialog_finish(
     const Glib::RefPtr<Gtk::FileDialog>& dialog) {
     try {
         image_filename = dialog->open_finish(result)->get_path();
-        set_picture(compressed_thumb_filename(image_filename));
+        set_picture(image_filename);
     } catch (Glib::Error& err) {
         spdlog::get("app")->warn("[BoardDialog.on_filedialog_finish] {}",
                                  err.what());
@@ -106,7 +107,20 @@ void BoardDialog::set_picture(const Gdk::RGBA& rgba) {
 }
 
 void BoardDialog::set_picture(const std::string& image_filename) {
-    board_picture->set_filename(image_filename);
     bg_type = BackgroundType::IMAGE;
+
+    // The picture stays empty until the thumbnail is ready
+    board_picture->set_paintable(nullptr);
+    ImagePipeline::get().request_thumbnail(
+        image_filename,
+        sigc::track_obj(
+            [this, image_filename](const std::string& thumbnail) {
+                if (thumbnail.empty() || bg_type != BackgroundType::IMAGE ||
+                    this->image_filename != image_filename) {
+                    return;
+                }
+                board_picture->set_filename(thumbnail);
+            },
+            *board_picture));
 }
 }  // namespace ui
\ No newline at end of file
@@ -28,6 +28,8 @@ CardDialog::CardDialog()
           builder->get_widget<Gtk::Revealer>("checkbutton-revealer")},
       m_checkbutton{builder->get_widget<Gtk::CheckButton>("checkbutton")},
       m_tasks_box{builder->get_widget<Gtk::Box>("tasks-box")},
+      m_tasks_view{builder->get_widget<Gtk::ListView>("tasks-view")},
+      m_task_pool{[this]() { return new TaskWidget(*this, ""); }},
       m_notes_textbuffer{
           builder->get_object<Gtk::TextBuffer>("notes-textbuffer")},
       m_adw_dialog{builder->get_object("card-dialog")} {
@@ -57,9 +59,14 @@ CardDialog::CardDialog()
     m_checklist_add_button.set_margin_end(4);
     m_checklist_add_button.set_margin_bottom(3);
     m_tasks_box->append(m_checklist_add_button);
+
+    setup_tasks_view();
 }
 
-CardDialog::~CardDialog() {}
+CardDialog::~CardDialog() {
+    // Hands every row widget back to the pool before it goes away
+    m_tasks_view->set_model(nullptr);
+}
 
 void CardDialog::set_title(const std::string& title) {
     if (!title.empty()) {
@@ -110,98 +117,87 @@ void CardDialog::set_complete(bool complete) {
     m_checkbutton->set_active(complete);
 }
 
-void CardDialog::append(TaskWidget& task) {
-    m_tasks_box->append(task);
-    m_tasks_box->reorder_child_after(m_checklist_add_button, task);
+void CardDialog::set_model(const Glib::RefPtr<TaskListModel>& model) {
+    m_model = model;
+    m_tasks_selection->set_model(model);
+}
 
-    task.signal_complete_changed().connect(sigc::track_obj(
-        [this, &task]() { m_n_tasks_complete += task.get_complete() ? 1 : -1; },
-        task));
+void CardDialog::add_task(const std::string& title, TaskWidget* sibling) {
+    if (!m_model) {
+        return;
+    }
 
-    m_n_tasks++;
-    m_n_tasks_complete += task.get_complete() ? 1 : 0;
+    int index = -1;
+    if (sibling && m_bound_tasks.contains(sibling)) {
+        index = m_model->find(m_bound_tasks[sibling]);
+    }
+    m_task_request_signal.emit(title, index);
 
-    m_task_add_signal.emit(&task, -1);
+#if GTKMM_CHECK_VERSION(4, 12, 0)
+    const guint new_i = index == -1 ? m_model->size() - 1 : index + 1;
+    if (new_i < m_model->size()) {
+        m_tasks_view->scroll_to(new_i, Gtk::ListScrollFlags::FOCUS);
+    }
+#endif
 }
 
-// FIXME: This method (probably the similar ones too) do not have defined
-// measures against non-child siblings
-void CardDialog::insert_after(TaskWidget& next, TaskWidget& sibling) {
-    int index = 0;
-    for (Gtk::Widget* task = m_tasks_box->get_first_child();
-         task && task != &sibling; task = task->get_next_sibling())
-        index++;
+void CardDialog::remove_task(TaskWidget& task_widget) {
+    if (!m_bound_tasks.contains(&task_widget)) {
+        return;
+    }
 
-    m_tasks_box->insert_child_after(next, sibling);
+    if (TaskWidget* previous_task = prev_task(task_widget)) {
+        previous_task->grab_focus();
+    }
 
-    next.signal_complete_changed().connect(sigc::track_obj(
-        [this, &next]() { m_n_tasks_complete += next.get_complete() ? 1 : -1; },
-        next));
+    // The row goes away once the task is removed from the model
+    m_task_remove_signal.emit(&task_widget);
+}
 
-    m_n_tasks++;
-    m_n_tasks_complete += next.get_complete() ? 1 : 0;
+TaskWidget* CardDialog::prev_task(TaskWidget& task_widget) {
+    if (!m_model || !m_bound_tasks.contains(&task_widget)) {
+        return nullptr;
+    }
 
-    m_task_add_signal.emit(&next, index);
+    const ssize_t task_i = m_model->find(m_bound_tasks[&task_widget]);
+    return task_i > 0 ? widget_of(m_model->get_task(task_i - 1)) : nullptr;
 }
 
-void CardDialog::remove_task(TaskWidget& task_widget) {
-    if (Gtk::Widget* previous_sibling = task_widget.get_prev_sibling()) {
-        previous_sibling->grab_focus();
+TaskWidget* CardDialog::next_task(TaskWidget& task_widget) {
+    if (!m_model || !m_bound_tasks.contains(&task_widget)) {
+        return nullptr;
     }
 
-    // Whatever needs to be done with TaskWidget will be done first
-    m_task_remove_signal.emit(&task_widget);
-
-    m_n_tasks--;
-    m_n_tasks_complete -= task_widget.get_complete() ? 1 : 0;
+    const ssize_t task_i = m_model->find(m_bound_tasks[&task_widget]);
+    return task_i != -1 ? widget_of(m_model->get_task(task_i + 1)) : nullptr;
+}
 
-    m_tasks_box->remove(task_widget);
+TaskWidget* CardDialog::widget_of(const std::shared_ptr<Task>& task) const {
+    auto it = task ? m_task_widgets.find(task.get()) : m_task_widgets.end();
+    return it != m_task_widgets.end() ? it->second : nullptr;
 }
 
 void CardDialog::reorder(TaskWidget& next, TaskWidget& sibling) {
-    ssize_t next_i = -1;
-    ssize_t sibling_i = -1;
-
-    ssize_t c_i = 0;
-    for (Gtk::Widget* task = m_tasks_box->get_first_child(); task;
-         task = task->get_next_sibling()) {
-        if ((next_i) != -1 && (sibling_i != -1)) {
-            break;
-        }
-
-        if (&next == task) {
-            next_i = c_i;
-        } else if (&sibling == task) {
-            sibling_i = c_i;
-        }
-        c_i++;
+    if (!m_model || !m_bound_tasks.contains(&next) ||
+        !m_bound_tasks.contains(&sibling)) {
+        return;
     }
 
-    if ((next_i) == -1 || (sibling_i == -1)) {
+    std::shared_ptr<Task> moved = m_bound_tasks[&next];
+    const ssize_t next_i = m_model->find(moved);
+    const ssize_t sibling_i = m_model->find(m_bound_tasks[&sibling]);
+    if (next_i == -1 || sibling_i == -1 || next_i == sibling_i) {
         return;
     }
 
-    bool up = false;
-    if (sibling.get_prev_sibling() == &next) {
-        m_tasks_box->reorder_child_after(next, sibling);
-    } else if (sibling.get_next_sibling() == &next) {
-        m_tasks_box->reorder_child_after(sibling, next);
-        up = true;
-    } else {
-        // Widgets are not neighbours. How to reorder them now depends on their
-        // index
-        if (next_i > sibling_i) {  // Move the widget up
-            sibling.get_prev_sibling() == nullptr
-                ? m_tasks_box->reorder_child_at_start(next)
-                : m_tasks_box->reorder_child_after(next,
-                                                   *sibling.get_prev_sibling());
-            up = true;
-        } else {  // Move the widget down
-            m_tasks_box->reorder_child_after(next, sibling);
-        }
-    }
+    m_task_reorder_signal.emit(&next, &sibling, next_i > sibling_i);
 
-    m_task_reorder_signal.emit(&next, &sibling, up);
+#if GTKMM_CHECK_VERSION(4, 12, 0)
+    const ssize_t moved_i = m_model->find(moved);
+    if (moved_i != -1) {
+        m_tasks_view->scroll_to(moved_i, Gtk::ListScrollFlags::FOCUS);
+    }
+#endif
 }
 
 void CardDialog::open(Gtk::Window& parent, CardWidget* card_widget) {
@@ -236,8 +232,17 @@ sigc::signal<void()>& CardDialog::signal_complete_changed() {
     return m_complete_changed_signal;
 }
 
-sigc::signal<void(TaskWidget*, int)>& CardDialog::signal_task_added() {
-    return m_task_add_signal;
+sigc::signal<void(std::string, int)>& CardDialog::signal_task_requested() {
+    return m_task_request_signal;
+}
+
+sigc::signal<void(TaskWidget*, std::shared_ptr<Task>)>&
+CardDialog::signal_task_bound() {
+    return m_task_bind_signal;
+}
+
+sigc::signal<void(TaskWidget*)>& CardDialog::signal_task_unbound() {
+    return m_task_unbind_signal;
 }
 
 sigc::signal<void(TaskWidget*)>& CardDialog::signal_task_removed() {
@@ -257,10 +262,7 @@ sigc::signal<void()>& CardDialog::signal_closed() {
     return m_card_dialog_closed_signal;
 }
 
-void CardDialog::on_add_task() {
-    auto new_task = Gtk::make_managed<TaskWidget>(*this, _("New Task"));
-    append(*new_task);
-}
+void CardDialog::on_add_task() { add_task(_("New Task")); }
 
 std::string CardDialog::get_title() const { return m_title_entry->get_text(); }
 
@@ -275,7 +277,10 @@ std::chrono::year_month_day CardDialog::get_deadline() const {
 bool CardDialog::get_complete() const { return m_checkbutton->get_active(); }
 
 std::pair<int, int> CardDialog::get_completion_ratio() const {
-    return {m_n_tasks_complete, m_n_tasks};
+    if (!m_model) {
+        return {0, 0};
+    }
+    return {m_model->n_done(), m_model->size()};
 }
 
 void CardDialog::on_delete_card() {
@@ -307,12 +312,16 @@ void CardDialog::on_set_due_date() {
 
 void CardDialog::clear() {
     m_title_entry->set_text("");
-    for (Gtk::Widget* task = m_checklist_add_button.get_prev_sibling(); task;
-         task = m_checklist_add_button.get_prev_sibling()) {
-        m_tasks_box->remove(*task);
-    }
 
-    m_n_tasks = m_n_tasks_complete = 0;
+    // Rows unbound while the model goes away are not announced
+    m_bound_tasks.clear();
+    m_task_widgets.clear();
+    set_model(nullptr);
+
+    const auto [tasks_created, tasks_reused] = m_task_pool.take_counts();
+    spdlog::get("app")->debug(
+        "[CardDialog.clear] Task widgets created/reused: {}/{}", tasks_created,
+        tasks_reused);
 
     m_notes_textbuffer->set_text("");
 
@@ -321,4 +330,56 @@ void CardDialog::clear() {
 
     m_card_widget = nullptr;
 }
+
+void CardDialog::setup_tasks_view() {
+    auto factory = Gtk::SignalListItemFactory::create();
+    factory->signal_setup().connect(
+        [this](const Glib::RefPtr<Gtk::ListItem>& list_item) {
+            list_item->set_activatable(false);
+            list_item->set_selectable(false);
+            list_item->set_child(*m_task_pool.acquire());
+        });
+    factory->signal_bind().connect(
+        [this](const Glib::RefPtr<Gtk::ListItem>& list_item) {
+            auto task = static_cast<TaskWidget*>(list_item->get_child());
+            auto task_object =
+                std::dynamic_pointer_cast<TaskObject>(list_item->get_item());
+            if (task && task_object) {
+                const std::shared_ptr<Task>& db_task = task_object->task();
+                task->reset(db_task->get_name(), db_task->get_done());
+                m_bound_tasks[task] = db_task;
+                m_task_widgets[db_task.get()] = task;
+                m_task_bind_signal.emit(task, db_task);
+            }
+        });
+    factory->signal_unbind().connect(
+        [this](const Glib::RefPtr<Gtk::ListItem>& list_item) {
+            auto task = static_cast<TaskWidget*>(list_item->get_child());
+            auto it = task ? m_bound_tasks.find(task) : m_bound_tasks.end();
+            if (it == m_bound_tasks.end()) {
+                return;
+            }
+
+            // The task may be shown by another row already
+            auto widget_it = m_task_widgets.find(it->second.get());
+            if (widget_it != m_task_widgets.end() &&
+                widget_it->second == task) {
+                m_task_widgets.erase(widget_it);
+            }
+            m_bound_tasks.erase(it);
+            m_task_unbind_signal.emit(task);
+        });
+    factory->signal_teardown().connect(
+        [this](const Glib::RefPtr<Gtk::ListItem>& list_item) {
+            auto task = static_cast<TaskWidget*>(list_item->get_child());
+            list_item->unset_child();
+            if (task) {
+                m_task_pool.release(task);
+            }
+        });
+
+    m_tasks_selection = Gtk::NoSelection::create();
+    m_tasks_view->set_factory(factory);
+    m_tasks_view->set_model(m_tasks_selection);
+}
 }  // namespace ui
@@ -2,8 +2,12 @@
 #include <adwaita.h>
 #include <core/task.h>
 #include <gtkmm.h>
+#include <widgets/task-list-model.h>
+#include <widgets/widget-pool.h>
 
 #include <chrono>
+#include <memory>
+#include <unordered_map>
 #include <utility>
 
 namespace ui {
@@ -30,12 +34,39 @@ public:
     void set_deadline(const Glib::Date& deadline = {});
     void set_complete(bool complete = true);
 
-    void append(TaskWidget& task);
-    void insert_after(TaskWidget& next, TaskWidget& sibling);
+    /**
+     * @brief Shows the tasks of a model in the checklist area.
+     *
+     * @details Task widgets are only bound to the rows that are visible, and
+     * are recycled across openings of the dialog. The task bound and unbound
+     * signals are emitted as rows come and go.
+     *
+     * @param model Tasks to show, or nullptr to empty the checklist.
+     */
+    void set_model(const Glib::RefPtr<TaskListModel>& model);
+
+    /**
+     * @brief Requests a new task. No widget is created here, the row shows up
+     * once the task is added to the model
+     *
+     * @param title Title of the new task.
+     * @param sibling Task widget the new task is placed after, or nullptr to
+     * append it.
+     */
+    void add_task(const std::string& title, TaskWidget* sibling = nullptr);
+
     void remove_task(TaskWidget& task_widget);
 
     /**
-     * @brief Reorders task widgets within the checklist area.
+     * @brief Returns the task widget bound to the task right before (or after)
+     * the given one, or nullptr if there is none or it is not realized
+     */
+    TaskWidget* prev_task(TaskWidget& task_widget);
+    TaskWidget* next_task(TaskWidget& task_widget);
+
+    /**
+     * @brief Reorders task widgets within the checklist area. The rows are
+     * moved by the model once the tasks are reordered
      *
      * @param next Reference to the TaskWidget to be placed after the
      * sibling.
@@ -71,7 +102,10 @@ public:
     sigc::signal<void(std::string, std::string)>& signal_notes_changed();
     sigc::signal<void(Glib::Date, Glib::Date)>& signal_deadline_changed();
     sigc::signal<void()>& signal_complete_changed();
-    sigc::signal<void(TaskWidget*, int)>& signal_task_added();
+    sigc::signal<void(std::string, int)>& signal_task_requested();
+    sigc::signal<void(TaskWidget*, std::shared_ptr<Task>)>&
+    signal_task_bound();
+    sigc::signal<void(TaskWidget*)>& signal_task_unbound();
     sigc::signal<void(TaskWidget*)>& signal_task_removed();
     sigc::signal<void(TaskWidget*, TaskWidget*, bool)>& signal_task_reordered();
     sigc::signal<void(CardWidget*)>& signal_open();
@@ -103,6 +137,14 @@ protected:
      */
     void clear();
 
+    void setup_tasks_view();
+
+    /**
+     * @brief Returns the widget bound to the task, or nullptr if its row is
+     * not realized
+     */
+    TaskWidget* widget_of(const std::shared_ptr<Task>& task) const;
+
     // Widgets
     Glib::RefPtr<Gtk::Builder> builder;
     Glib::RefPtr<Glib::Object> m_adw_dialog;
@@ -114,6 +156,8 @@ protected:
     Gtk::Revealer* m_checkbutton_revealer;
     Gtk::CheckButton* m_checkbutton;
     Gtk::Box* m_tasks_box;
+    Gtk::ListView* m_tasks_view;
+    Glib::RefPtr<Gtk::NoSelection> m_tasks_selection;
     Glib::RefPtr<Gtk::TextBuffer> m_notes_textbuffer;
 
     // Signals
@@ -121,17 +165,24 @@ protected:
     sigc::signal<void(std::string, std::string)> m_notes_changed_signal;
     sigc::signal<void(Glib::Date, Glib::Date)> m_deadline_changed_signal;
     sigc::signal<void()> m_complete_changed_signal;
-    sigc::signal<void(TaskWidget*, int)> m_task_add_signal;
+    sigc::signal<void(std::string, int)> m_task_request_signal;
+    sigc::signal<void(TaskWidget*, std::shared_ptr<Task>)> m_task_bind_signal;
+    sigc::signal<void(TaskWidget*)> m_task_unbind_signal;
     sigc::signal<void(TaskWidget*)> m_task_remove_signal;
     sigc::signal<void(TaskWidget*, TaskWidget*, bool up)> m_task_reorder_signal;
     sigc::signal<void(CardWidget*)> m_card_dialog_opened_signal;
     sigc::signal<void()> m_card_dialog_closed_signal;
 
-    CardWidget* m_card_widget;
+    CardWidget* m_card_widget = nullptr;
 
     std::chrono::year_month_day m_deadline;
-    int m_n_tasks_complete = 0;
-    int m_n_tasks = 0;
+
+    // Row widgets are taken from the pool when the list view sets them up and
+    // handed back on teardown, so they outlive the card they were shown for
+    Glib::RefPtr<TaskListModel> m_model;
+    WidgetPool<TaskWidget> m_task_pool;
+    std::unordered_map<TaskWidget*, std::shared_ptr<Task>> m_bound_tasks;
+    std::unordered_map<Task*, TaskWidget*> m_task_widgets;
 };
 
 }  // namespace ui
@@ -0,0 +1,148 @@
+#include "image-pipeline.h"
+
+#include <glibmm/error.h>
+#include <spdlog/spdlog.h>
+
+#include <filesystem>
+#include <format>
+
+namespace fs = std::filesystem;
+
+ImagePipeline& ImagePipeline::get() {
+    static ImagePipeline pipeline;
+    return pipeline;
+}
+
+ImagePipeline::ImagePipeline() {
+    m_dispatcher.connect(sigc::mem_fun(*this, &ImagePipeline::on_jobs_done));
+    for (unsigned int i = 0; i < N_WORKERS; i++) {
+        m_workers.emplace_back(
+            [this](std::stop_token token) { work(token); });
+    }
+}
+
+ImagePipeline::~ImagePipeline() {
+    for (auto& worker : m_workers) {
+        worker.request_stop();
+    }
+    m_jobs_cv.notify_all();
+    m_workers.clear();
+}
+
+void ImagePipeline::request_background(const std::string& filename,
+                                       ImageQuality quality, Slot slot) {
+    request(Job{std::format("bg:{}", filename), JobType::BACKGROUND, filename,
+                quality},
+            cached_bg_filename(filename, quality),
+            Waiter{quality, std::move(slot)});
+}
+
+void ImagePipeline::request_thumbnail(const std::string& filename,
+                                      Slot slot) {
+    request(Job{std::format("thumb:{}", filename), JobType::THUMBNAIL,
+                filename, ImageQuality::MEDIUM},
+            cached_thumb_filename(filename),
+            Waiter{ImageQuality::MEDIUM, std::move(slot)});
+}
+
+void ImagePipeline::request(Job job, const ImageCache::Ref& cached,
+                            Waiter waiter) {
+    // Cache hits are answered from the cache's index, there is no need to
+    // bother the workers
+    if (cached) {
+        waiter.slot(*cached);
+        return;
+    }
+
+    auto waiting = m_waiting.find(job.key);
+    if (waiting != m_waiting.end()) {
+        waiting->second.push_back(std::move(waiter));
+        return;
+    }
+
+    m_waiting[job.key].push_back(std::move(waiter));
+    {
+        std::lock_guard<std::mutex> lg{m_mutex};
+        m_jobs.push_back(std::move(job));
+    }
+    m_jobs_cv.notify_one();
+}
+
+void ImagePipeline::work(std::stop_token token) {
+    while (!token.stop_requested()) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock{m_mutex};
+            if (!m_jobs_cv.wait(lock, token, [this]() {
+                    return !m_jobs.empty();
+                })) {
+                return;
+            }
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+
+        ImageCache::Ref result;
+        try {
+            result = job.type == JobType::BACKGROUND
+                         ? compressed_bg_filename(job.filename, job.quality,
+                                                  token)
+                         : compressed_thumb_filename(job.filename, token);
+        } catch (Glib::Error& err) {
+            spdlog::get("app")->warn(
+                "[ImagePipeline.work] Cannot decode \"{}\": {}", job.filename,
+                err.what());
+        } catch (fs::filesystem_error& err) {
+            spdlog::get("app")->warn(
+                "[ImagePipeline.work] Cannot cache \"{}\": {}", job.filename,
+                err.what());
+        }
+
+        if (token.stop_requested()) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lg{m_mutex};
+            m_done.emplace_back(std::move(job), std::move(result));
+        }
+        m_dispatcher.emit();
+    }
+}
+
+void ImagePipeline::on_jobs_done() {
+    std::vector<std::pair<Job, ImageCache::Ref>> done;
+    {
+        std::lock_guard<std::mutex> lg{m_mutex};
+        done.swap(m_done);
+    }
+
+    for (const auto& [job, result] : done) {
+        auto waiting = m_waiting.extract(job.key);
+        if (waiting.empty()) {
+            continue;
+        }
+
+        for (auto& [quality, slot] : waiting.mapped()) {
+            // The job built every level of the pyramid, but only returned
+            // the one it was queued for
+            const bool other_level = job.type == JobType::BACKGROUND &&
+                                     quality != job.quality && result;
+            const ImageCache::Ref image =
+                other_level ? cached_bg_filename(job.filename, quality)
+                            : result;
+            slot(image ? *image : "");
+        }
+    }
+
+    for (const auto& [name, cache] :
+         {std::pair{"Background", &background_cache()},
+          std::pair{"Thumbnail", &thumbnail_cache()}}) {
+        const ImageCacheStats stats = cache->stats();
+        spdlog::get("app")->debug(
+            "[ImagePipeline.on_jobs_done] {} cache: {} entries, {} KiB. "
+            "{} hits, {} misses, {} evictions, {} invalidations",
+            name, stats.n_entries, stats.size / 1024, stats.hits,
+            stats.misses, stats.evictions, stats.invalidations);
+    }
+}
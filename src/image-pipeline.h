@@ -0,0 +1,111 @@
+#pragma once
+
+#include <glibmm/dispatcher.h>
+#include <sigc++/sigc++.h>
+#include <utils.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Decodes, scales and encodes background images on worker threads.
+ *
+ * @details Requests are made from the GTK thread and are answered on it,
+ * through a Glib::Dispatcher, with the filename of the compressed image (or an
+ * empty string if the image could not be decoded). Images already in the
+ * ImageCache are answered right away. Requests for an image that is still
+ * being worked on wait for the same job instead of queueing another one. A
+ * background job builds the whole pyramid of its source, so requests for
+ * other levels of the same background wait for it too.
+ *
+ * Slots are kept until the job is done, so callers are expected to track the
+ * objects they capture (e.g. with sigc::track_obj) and to check the answer is
+ * still relevant to them.
+ */
+class ImagePipeline {
+public:
+    using Slot = sigc::slot<void(const std::string&)>;
+
+    /**
+     * @brief Number of worker threads. Decoding is I/O and memory heavy, more
+     * workers would mostly compete with each other
+     */
+    static constexpr unsigned int N_WORKERS = 2;
+
+    /**
+     * @brief Returns the application's pipeline. It must first be called from
+     * the GTK thread
+     */
+    static ImagePipeline& get();
+
+    ImagePipeline(const ImagePipeline&) = delete;
+    ImagePipeline& operator=(const ImagePipeline&) = delete;
+    ~ImagePipeline();
+
+    /**
+     * @brief Requests a level of the compressed background pyramid of an
+     * image
+     *
+     * @param slot called with the compressed image's filename
+     */
+    void request_background(const std::string& filename, ImageQuality quality,
+                            Slot slot);
+
+    /**
+     * @brief Requests the thumbnail version of an image
+     *
+     * @param slot called with the thumbnail's filename
+     */
+    void request_thumbnail(const std::string& filename, Slot slot);
+
+protected:
+    enum class JobType { BACKGROUND, THUMBNAIL };
+
+    struct Job {
+        std::string key;
+        JobType type;
+        std::string filename;
+        ImageQuality quality;
+    };
+
+    ImagePipeline();
+
+    struct Waiter {
+        ImageQuality quality;
+        Slot slot;
+    };
+
+    void request(Job job, const ImageCache::Ref& cached, Waiter waiter);
+
+    /**
+     * @brief Worker thread loop. Takes jobs until a stop is requested
+     */
+    void work(std::stop_token token);
+
+    /**
+     * @brief Answers the requests of every finished job. Runs on the GTK
+     * thread
+     */
+    void on_jobs_done();
+
+    // Slots waiting for each job. Only touched from the GTK thread
+    std::unordered_map<std::string, std::vector<Waiter>> m_waiting;
+
+    std::mutex m_mutex;
+    std::condition_variable_any m_jobs_cv;
+    std::deque<Job> m_jobs;
+    // Answers hold their cache entries until the slots have read them
+    std::vector<std::pair<Job, ImageCache::Ref>> m_done;
+
+    Glib::Dispatcher m_dispatcher;
+
+    // Declared last so workers are stopped before anything they use goes away
+    std::vector<std::jthread> m_workers;
+};
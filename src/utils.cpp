@@ -1,9 +1,14 @@
 #include "utils.h"
 
 #include <gdkmm/pixbuf.h>
-#include <glibmm/checksum.h>
+#include <glibmm/date.h>
+#include <glibmm/fileutils.h>
 
+#include <algorithm>
+#include <cmath>
 #include <filesystem>
+#include <sstream>
+#include <thread>
 
 namespace fs = std::filesystem;
 
@@ -36,56 +41,155 @@ std::string thumb_cache_dir() {
 #endif
 }
 
-std::string compressed_bg_filename(const std::string& filename,
+ImageCache& background_cache() {
+    static ImageCache cache{bg_cache_dir(), IMAGE_CACHE_DEFAULT_SIZE};
+    return cache;
+}
+
+ImageCache& thumbnail_cache() {
+    static ImageCache cache{thumb_cache_dir(), IMAGE_CACHE_DEFAULT_SIZE};
+    return cache;
+}
+
+static std::string bg_variant(ImageQuality quality) {
+    switch (quality) {
+        case ImageQuality::LOW:
+            return "bg-low";
+        case ImageQuality::HIGH:
+            return "bg-high";
+        default:
+            return "bg-medium";
+    }
+}
+
+static constexpr const char* THUMB_VARIANT = "thumb";
+
+ImageCache::Ref cached_bg_filename(const std::string& filename,
                                    ImageQuality quality) {
-    std::string filename_checksum =
-        Glib::Checksum::compute_checksum(Glib::Checksum::Type::MD5, filename);
-
-    const fs::path cached_image = fs::path{bg_cache_dir()} / filename_checksum;
-    if (!fs::exists(cached_image)) {
-        // Compresses the given image file and return the compressed's filename
-        // We ensure a cache directory exists at all times
-        fs::create_directories(bg_cache_dir());
-
-        auto image_pixbuf = Gdk::Pixbuf::create_from_file(filename);
-        Glib::RefPtr<Gdk::Pixbuf> compressed_image;
-
-        switch (quality) {
-            case ImageQuality::LOW: {
-                compressed_image = image_pixbuf->scale_simple(
-                    720, 480, Gdk::InterpType::BILINEAR);
-                break;
-            }
-            case ImageQuality::MEDIUM: {
-                compressed_image = image_pixbuf->scale_simple(
-                    1280, 720, Gdk::InterpType::BILINEAR);
-                break;
-            }
-            case ImageQuality::HIGH: {
-                compressed_image = image_pixbuf->scale_simple(
-                    1920, 1080, Gdk::InterpType::BILINEAR);
-                break;
-            }
-        }
+    ImageCache& cache = background_cache();
+    return cache.lookup(cache.key(filename, bg_variant(quality)));
+}
+
+ImageCache::Ref cached_thumb_filename(const std::string& filename) {
+    ImageCache& cache = thumbnail_cache();
+    return cache.lookup(cache.key(filename, THUMB_VARIANT));
+}
+
+/**
+ * @brief Saves the pixbuf as a PNG under a name unique to the calling thread,
+ * then moves it to its final place
+ */
+static void save_cache_entry(const Glib::RefPtr<Gdk::Pixbuf>& pixbuf,
+                             const fs::path& cached_image) {
+    std::ostringstream tmp_suffix;
+    tmp_suffix << ".tmp-" << std::this_thread::get_id();
+    fs::path tmp_image = cached_image;
+    tmp_image += tmp_suffix.str();
 
-        compressed_image->save(cached_image.string(), "png");
+    pixbuf->save(tmp_image.string(), "png");
+    fs::rename(tmp_image, cached_image);
+}
+
+std::pair<int, int> bg_size(ImageQuality quality) {
+    switch (quality) {
+        case ImageQuality::LOW:
+            return {720, 480};
+        case ImageQuality::HIGH:
+            return {1920, 1080};
+        default:
+            return {1280, 720};
     }
+}
 
-    return cached_image.string();
+ImageQuality bg_quality_for(int width, int height) {
+    for (auto level = BG_PYRAMID.rbegin(); level != BG_PYRAMID.rend();
+         level++) {
+        const auto [level_width, level_height] = bg_size(*level);
+        if (level_width >= width && level_height >= height) {
+            return *level;
+        }
+    }
+    return BG_PYRAMID.front();
 }
 
-std::string compressed_thumb_filename(const std::string& filename) {
-    std::string filename_checksum =
-        Glib::Checksum::compute_checksum(Glib::Checksum::Type::MD5, filename);
+ImageCache::Ref compressed_bg_filename(const std::string& filename,
+                                       ImageQuality quality,
+                                       std::stop_token token) {
+    ImageCache& cache = background_cache();
+    const std::string key = cache.key(filename, bg_variant(quality));
+    if (key.empty()) {
+        throw Glib::FileError{Glib::FileError::NO_SUCH_ENTITY,
+                              "Cannot read " + filename};
+    }
+    if (auto cached_image = cache.lookup(key)) {
+        return cached_image;
+    }
+
+    if (token.stop_requested()) return nullptr;
+    auto level_pixbuf = Gdk::Pixbuf::create_from_file(filename);
+
+    // The requested level is held while the smaller ones are inserted
+    ImageCache::Ref image;
+    for (ImageQuality level : BG_PYRAMID) {
+        if (token.stop_requested()) return nullptr;
+
+        // Scaling from the level above is much cheaper than scaling from the
+        // source again. Levels fit inside their box with the source's aspect
+        // ratio, and levels larger than the source keep its size
+        const auto [box_width, box_height] = bg_size(level);
+        const double scale =
+            std::min(double(box_width) / level_pixbuf->get_width(),
+                     double(box_height) / level_pixbuf->get_height());
+        if (scale < 1) {
+            const int width = std::max(
+                1, int(std::lround(level_pixbuf->get_width() * scale)));
+            const int height = std::max(
+                1, int(std::lround(level_pixbuf->get_height() * scale)));
+            level_pixbuf = level_pixbuf->scale_simple(
+                width, height, Gdk::InterpType::BILINEAR);
+        }
+
+        const std::string level_key = cache.key(filename, bg_variant(level));
+        if (level_key.empty() ||
+            (level_key != key && cache.lookup(level_key))) {
+            continue;
+        }
+        if (token.stop_requested()) return nullptr;
+        save_cache_entry(level_pixbuf, cache.path(level_key));
+        ImageCache::Ref level_image = cache.insert(level_key);
+        if (level_key == key) {
+            image = level_image;
+        }
+    }
 
-    fs::create_directories(thumb_cache_dir());
+    return image;
+}
 
-    const fs::path cached_image =
-        fs::path{thumb_cache_dir()} / filename_checksum;
-    if (!fs::exists(cached_image)) {
-        auto bg_pixbuf = Gdk::Pixbuf::create_from_file(filename);
-        bg_pixbuf->scale_simple(256, 256, Gdk::InterpType::BILINEAR)
-            ->save(cached_image.string(), "png");
+ImageCache::Ref compressed_thumb_filename(const std::string& filename,
+                                          std::stop_token token) {
+    ImageCache& cache = thumbnail_cache();
+    const std::string key = cache.key(filename, THUMB_VARIANT);
+    if (key.empty()) {
+        throw Glib::FileError{Glib::FileError::NO_SUCH_ENTITY,
+                              "Cannot read " + filename};
     }
-    return cached_image.string();
+    if (auto cached_image = cache.lookup(key)) {
+        return cached_image;
+    }
+
+    if (token.stop_requested()) return nullptr;
+    auto bg_pixbuf = Gdk::Pixbuf::create_from_file(filename);
+    if (token.stop_requested()) return nullptr;
+    save_cache_entry(
+        bg_pixbuf->scale_simple(256, 256, Gdk::InterpType::BILINEAR),
+        cache.path(key));
+    return cache.insert(key);
+}
+
+Date local_today() {
+    Glib::Date today;
+    today.set_time_current();
+    return Date{std::chrono::year{today.get_year()},
+                std::chrono::month{static_cast<unsigned>(today.get_month())},
+                std::chrono::day{today.get_day()}};
 }
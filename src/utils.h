@@ -1,18 +1,97 @@
+#pragma once
+
+#include <core/card.h>
+#include <core/image-cache.h>
+
+#include <array>
+#include <cstdint>
+#include <stop_token>
 #include <string>
+#include <utility>
 
 /**
  * @brief Background compression image quality
  */
 enum class ImageQuality { HIGH, MEDIUM, LOW };
 
+/**
+ * @brief Levels of the background pyramid, from the largest to the smallest.
+ * Every level is built when a background is first compressed
+ */
+constexpr std::array<ImageQuality, 3> BG_PYRAMID = {
+    ImageQuality::HIGH, ImageQuality::MEDIUM, ImageQuality::LOW};
+
+/**
+ * @brief Returns the box, in pixels, the compressed backgrounds of the given
+ * quality fit in. Backgrounds keep their aspect ratio, and are never larger
+ * than their source
+ */
+std::pair<int, int> bg_size(ImageQuality quality);
+
+/**
+ * @brief Returns the smallest pyramid level covering an area of the given
+ * size, in pixels. Areas larger than every level get the largest one
+ */
+ImageQuality bg_quality_for(int width, int height);
+
+/**
+ * @brief Default size cap, in bytes, of each image cache
+ */
+constexpr uintmax_t IMAGE_CACHE_DEFAULT_SIZE = uintmax_t{256} * 1024 * 1024;
+
+/**
+ * @brief Cache of the compressed background images. Its index is loaded on
+ * first use
+ */
+ImageCache& background_cache();
+
+/**
+ * @brief Cache of the board thumbnails. Its index is loaded on first use
+ */
+ImageCache& thumbnail_cache();
+
 /**
  * @brief Returns a compressed background image version from the image in
- * filename
+ * filename. The cache entry is not evicted while the reference lives
+ *
+ * @details If the requested level is not cached, the source is decoded once
+ * and every missing level of the pyramid is built from it, each one scaled
+ * down from the level above.
+ *
+ * token is checked between decoding, scaling and encoding. If a stop is
+ * requested, the remaining levels are not written to the cache and an empty
+ * reference is returned. Images are written under a temporary name first, so
+ * other threads never read a half-written cache entry
  */
-std::string compressed_bg_filename(const std::string& filename,
-                                   ImageQuality quality = ImageQuality::MEDIUM);
+ImageCache::Ref compressed_bg_filename(
+    const std::string& filename, ImageQuality quality = ImageQuality::MEDIUM,
+    std::stop_token token = {});
 
 /**
  * @brief Returns a thumbnail version of the image in filename
+ *
+ * @details token is checked like in compressed_bg_filename
+ */
+ImageCache::Ref compressed_thumb_filename(const std::string& filename,
+                                          std::stop_token token = {});
+
+/**
+ * @brief Returns the cached compressed background of the image in filename, or
+ * an empty reference if it has not been built yet. Only the cache's index is
+ * looked at, and the source itself at most once per
+ * ImageCache::KEY_RECHECK_INTERVAL
+ */
+ImageCache::Ref cached_bg_filename(const std::string& filename,
+                                   ImageQuality quality = ImageQuality::MEDIUM);
+
+/**
+ * @brief Returns the cached thumbnail of the image in filename, or an empty
+ * reference if it has not been built yet. Lookups work like in
+ * cached_bg_filename
+ */
+ImageCache::Ref cached_thumb_filename(const std::string& filename);
+
+/**
+ * @brief Returns the current date in the local timezone
  */
-std::string compressed_thumb_filename(const std::string& filename);
+Date local_today();
@@ -0,0 +1,141 @@
+#include "agenda-view.h"
+
+#include <glibmm/i18n.h>
+
+#include <format>
+
+namespace ui {
+
+AgendaView::AgendaView()
+    : Gtk::ScrolledWindow{},
+      m_root{Gtk::Orientation::VERTICAL},
+      m_indexing_box{Gtk::Orientation::HORIZONTAL, 6},
+      m_indexing_label{_("Reading the due dates of every board…")},
+      m_empty_label{_("Nothing is due in the next days")} {
+    m_root.set_spacing(6);
+    m_root.set_margin(12);
+
+    m_indexing_label.add_css_class("dim-label");
+    m_indexing_box.set_halign(Gtk::Align::CENTER);
+    m_indexing_box.append(m_indexing_spinner);
+    m_indexing_box.append(m_indexing_label);
+    m_indexing_box.set_visible(false);
+    m_root.append(m_indexing_box);
+
+    m_empty_label.add_css_class("dim-label");
+    m_empty_label.set_vexpand();
+    m_root.append(m_empty_label);
+
+    const unsigned days = UPCOMING_DAYS;
+    setup_section(m_overdue, _("Overdue"));
+    setup_section(m_today, _("Today"));
+    setup_section(m_upcoming, std::vformat(_("Next {} days"),
+                                           std::make_format_args(days)));
+
+    set_child(m_root);
+}
+
+void AgendaView::set_agenda(const Agenda& agenda, const Date& today) {
+    fill_section(m_overdue, agenda.overdue, today);
+    fill_section(m_today, agenda.today, today);
+    fill_section(m_upcoming, agenda.upcoming, today);
+    update_empty_label();
+}
+
+void AgendaView::set_indexing(bool indexing) {
+    m_indexing_box.set_visible(indexing);
+    m_indexing_spinner.set_spinning(indexing);
+    update_empty_label();
+}
+
+void AgendaView::update_empty_label() {
+    // Until every board is read, an empty agenda only means nothing is known
+    // to be due yet
+    m_empty_label.set_visible(!m_indexing_box.get_visible() &&
+                              m_overdue.filenames.empty() &&
+                              m_today.filenames.empty() &&
+                              m_upcoming.filenames.empty());
+}
+
+sigc::signal<void(std::string)>& AgendaView::signal_board_activated() {
+    return m_board_activated_signal;
+}
+
+void AgendaView::setup_section(Section& section, const std::string& title) {
+    section.title.set_label(title);
+    section.title.set_halign(Gtk::Align::START);
+    section.title.set_margin_top(12);
+    section.title.add_css_class("heading");
+
+    section.list.set_selection_mode(Gtk::SelectionMode::NONE);
+    section.list.add_css_class("boxed-list");
+    section.list.signal_row_activated().connect(
+        [this, &section](Gtk::ListBoxRow* row) {
+            const int index = row->get_index();
+            if (index >= 0 && size_t(index) < section.filenames.size()) {
+                m_board_activated_signal.emit(section.filenames[index]);
+            }
+        });
+
+    m_root.append(section.title);
+    m_root.append(section.list);
+}
+
+void AgendaView::fill_section(Section& section,
+                              const std::vector<AgendaEntry>& entries,
+                              const Date& today) {
+    while (Gtk::Widget* row = section.list.get_first_child()) {
+        section.list.remove(*row);
+    }
+    section.filenames.clear();
+
+    for (const AgendaEntry& entry : entries) {
+        auto row_box =
+            Gtk::make_managed<Gtk::Box>(Gtk::Orientation::HORIZONTAL, 12);
+        row_box->set_margin(10);
+
+        auto labels = Gtk::make_managed<Gtk::Box>(Gtk::Orientation::VERTICAL);
+        labels->set_hexpand();
+        auto card_label = Gtk::make_managed<Gtk::Label>(entry.card_name);
+        card_label->set_halign(Gtk::Align::START);
+        card_label->set_ellipsize(Pango::EllipsizeMode::END);
+        auto board_label = Gtk::make_managed<Gtk::Label>(entry.board_name);
+        board_label->set_halign(Gtk::Align::START);
+        board_label->set_ellipsize(Pango::EllipsizeMode::END);
+        board_label->add_css_class("dim-label");
+        board_label->add_css_class("caption");
+        labels->append(*card_label);
+        labels->append(*board_label);
+
+        const Glib::Date due{
+            Glib::Date::Day(unsigned(entry.due.day())),
+            static_cast<Glib::Date::Month>(unsigned(entry.due.month())),
+            Glib::Date::Year(int(entry.due.year()))};
+        auto due_label =
+            Gtk::make_managed<Gtk::Label>(due.format_string("%d %b, %Y"));
+        due_label->set_valign(Gtk::Align::CENTER);
+        if (entry.complete) {
+            due_label->add_css_class("due-date-complete");
+        } else if (std::chrono::sys_days{entry.due} <
+                   std::chrono::sys_days{today}) {
+            due_label->add_css_class("past-due-date");
+        } else {
+            due_label->add_css_class("due-date");
+        }
+
+        row_box->append(*labels);
+        row_box->append(*due_label);
+
+        auto row = Gtk::make_managed<Gtk::ListBoxRow>();
+        row->set_child(*row_box);
+        row->set_activatable();
+        row->set_tooltip_text(_("Open board"));
+        section.list.append(*row);
+        section.filenames.push_back(entry.filename);
+    }
+
+    section.title.set_visible(!entries.empty());
+    section.list.set_visible(!entries.empty());
+}
+
+}  // namespace ui
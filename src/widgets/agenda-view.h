@@ -0,0 +1,65 @@
+#pragma once
+
+#include <core/agenda-index.h>
+#include <gtkmm.h>
+
+#include <string>
+#include <vector>
+
+namespace ui {
+
+/**
+ * @brief Lists the overdue cards, the cards due today and the cards due in the
+ * next days of every board. Activating a card opens its board
+ */
+class AgendaView : public Gtk::ScrolledWindow {
+public:
+    /**
+     * @brief Number of days after today whose cards are shown as upcoming
+     */
+    static constexpr unsigned UPCOMING_DAYS = 7;
+
+    AgendaView();
+
+    /**
+     * @brief Replaces the shown cards
+     *
+     * @param today day the due dates are shown relative to
+     */
+    void set_agenda(const Agenda& agenda, const Date& today);
+
+    /**
+     * @brief Shows whether due dates are still being read from boards, in
+     * which case the shown cards may be incomplete
+     */
+    void set_indexing(bool indexing);
+
+    /**
+     * @brief void(filename)
+     */
+    sigc::signal<void(std::string)>& signal_board_activated();
+
+protected:
+    struct Section {
+        Gtk::Label title;
+        Gtk::ListBox list;
+
+        // Board file of every row, in row order
+        std::vector<std::string> filenames;
+    };
+
+    void setup_section(Section& section, const std::string& title);
+    void fill_section(Section& section, const std::vector<AgendaEntry>& entries,
+                      const Date& today);
+
+    void update_empty_label();
+
+    Gtk::Box m_root, m_indexing_box;
+    Gtk::Spinner m_indexing_spinner;
+    Gtk::Label m_indexing_label, m_empty_label;
+    Section m_overdue, m_today, m_upcoming;
+
+    sigc::signal<void(std::string)> m_board_activated_signal;
+};
+
+}  // namespace ui
@@ -0,0 +1,106 @@
+#include "board-background.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <list>
+#include <utility>
+
+namespace ui {
+
+namespace {
+// Most recently used textures first
+std::list<std::pair<std::string, Glib::RefPtr<Gdk::Texture>>>&
+texture_cache() {
+    static std::list<std::pair<std::string, Glib::RefPtr<Gdk::Texture>>>
+        cache;
+    return cache;
+}
+}  // namespace
+
+BoardBackground::BoardBackground()
+    : Glib::ObjectBase{"BoardBackground"}, Gtk::Widget{} {
+    set_can_target(false);
+    set_can_focus(false);
+}
+
+void BoardBackground::set_color(const Gdk::RGBA& color) {
+    if (!m_texture && m_color == color) {
+        return;
+    }
+
+    m_color = color;
+    m_texture = nullptr;
+    queue_draw();
+}
+
+bool BoardBackground::set_image(const std::string& filename) {
+    Glib::RefPtr<Gdk::Texture> texture;
+    try {
+        texture = load_texture(filename);
+    } catch (Glib::Error& err) {
+        spdlog::get("ui")->warn(
+            "[BoardBackground.set_image] Cannot load \"{}\": {}", filename,
+            err.what());
+        return false;
+    }
+
+    if (texture != m_texture) {
+        m_texture = texture;
+        queue_draw();
+    }
+    return true;
+}
+
+Glib::RefPtr<Gdk::Texture> BoardBackground::load_texture(
+    const std::string& filename) {
+    auto& cache = texture_cache();
+    auto it = std::find_if(cache.begin(), cache.end(), [&](const auto& entry) {
+        return entry.first == filename;
+    });
+    if (it != cache.end()) {
+        cache.splice(cache.begin(), cache, it);
+        return cache.front().second;
+    }
+
+    // Cached backgrounds are named after the version of their source, so a
+    // filename always maps to the same image
+    cache.emplace_front(filename, Gdk::Texture::create_from_filename(filename));
+    if (cache.size() > TEXTURE_CACHE_SIZE) {
+        cache.pop_back();
+    }
+    return cache.front().second;
+}
+
+void BoardBackground::measure_vfunc(Gtk::Orientation orientation, int for_size,
+                                    int& minimum, int& natural,
+                                    int& minimum_baseline,
+                                    int& natural_baseline) const {
+    // The background takes whatever space the board gives it
+    minimum = natural = 0;
+    minimum_baseline = natural_baseline = -1;
+}
+
+void BoardBackground::snapshot_vfunc(
+    const Glib::RefPtr<Gtk::Snapshot>& snapshot) {
+    const float width = get_width();
+    const float height = get_height();
+    const Gdk::Graphene::Rect bounds{0, 0, width, height};
+
+    if (!m_texture) {
+        snapshot->append_color(m_color, bounds);
+        return;
+    }
+
+    // Same as "background-size: cover": the image is scaled, keeping its
+    // aspect ratio, until it fills the widget, and is anchored at its top left
+    // corner
+    const float scale = std::max(width / m_texture->get_width(),
+                                 height / m_texture->get_height());
+    snapshot->push_clip(bounds);
+    snapshot->append_texture(
+        m_texture, Gdk::Graphene::Rect{0, 0, m_texture->get_width() * scale,
+                                       m_texture->get_height() * scale});
+    snapshot->pop();
+}
+}  // namespace ui
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <gtkmm.h>
+
+#include <string>
+
+namespace ui {
+
+/**
+ * @brief Paints a board's background: a solid color or an image covering the
+ * whole widget.
+ *
+ * @details Backgrounds are drawn straight into the snapshot, so changing one
+ * only redraws this widget and leaves the styles of the board's cardlists and
+ * cards alone. Image textures are kept in a small cache shared by every
+ * instance, so reapplying a background does not decode its image again.
+ */
+class BoardBackground : public Gtk::Widget {
+public:
+    /**
+     * @brief Number of textures kept in the cache. It fits every level of a
+     * background pyramid plus the previous background
+     */
+    static constexpr size_t TEXTURE_CACHE_SIZE = 4;
+
+    BoardBackground();
+
+    /**
+     * @brief Paints a solid color
+     */
+    void set_color(const Gdk::RGBA& color);
+
+    /**
+     * @brief Paints the image in filename, keeping its aspect ratio
+     *
+     * @return false if the image cannot be loaded. The current background is
+     * kept in that case
+     */
+    bool set_image(const std::string& filename);
+
+protected:
+    /**
+     * @brief Returns the texture of the image in filename, from the cache if
+     * it has been loaded recently
+     *
+     * @throws Glib::Error if the image cannot be loaded
+     */
+    static Glib::RefPtr<Gdk::Texture> load_texture(const std::string& filename);
+
+    void measure_vfunc(Gtk::Orientation orientation, int for_size, int& minimum,
+                       int& natural, int& minimum_baseline,
+                       int& natural_baseline) const override;
+    void snapshot_vfunc(const Glib::RefPtr<Gtk::Snapshot>& snapshot) override;
+
+    Gdk::RGBA m_color;
+    Glib::RefPtr<Gdk::Texture> m_texture;
+};
+}  // namespace ui
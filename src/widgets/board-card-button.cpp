@@ -1,17 +1,50 @@
 #include "board-card-button.h"
 
+#include <glibmm/i18n.h>
+#include <image-pipeline.h>
 #include <spdlog/spdlog.h>
 #include <utils.h>
 
+#include <format>
 #include <string>
 
+std::string ui::card_stats_markup(const CardStats& stats) {
+    std::string markup = std::vformat(
+        ngettext("{}/{} card complete", "{}/{} cards complete", stats.n_cards),
+        std::make_format_args(stats.n_complete, stats.n_cards));
+    if (stats.n_tasks > 0) {
+        markup += " · " + std::vformat(_("{}/{} tasks done"),
+                                       std::make_format_args(
+                                           stats.n_tasks_done, stats.n_tasks));
+    }
+    if (stats.n_overdue > 0) {
+        markup += std::format(
+            " · <span foreground=\"#c01c28\">{}</span>",
+            std::vformat(_("{} overdue"),
+                         std::make_format_args(stats.n_overdue)));
+    }
+    for (const auto& [color, n] : stats.n_colors) {
+        if (color != NO_COLOR) {
+            markup += std::format(
+                " <span foreground=\"#{:02x}{:02x}{:02x}\">●</span>{}",
+                std::get<0>(color), std::get<1>(color), std::get<2>(color), n);
+        }
+    }
+    return markup;
+}
+
 ui::BoardCardButton::BoardCardButton(LocalBoard board_entry)
+    : BoardCardButton{} {
+    set_local_board(board_entry);
+}
+
+ui::BoardCardButton::BoardCardButton()
     : Button{},
       root_box{Gtk::Orientation::VERTICAL},
       board_thumbnail{},
       board_name{},
-      local_board_entry{board_entry} {
-    set_name_(board_entry.board->get_name());
+      board_stats{},
+      local_board_entry{} {
     set_valign(Gtk::Align::CENTER);
     set_halign(Gtk::Align::CENTER);
     set_has_frame(false);
@@ -21,27 +54,56 @@ ui::BoardCardButton::BoardCardButton(LocalBoard board_entry)
     board_name.set_valign(Gtk::Align::CENTER);
     board_name.set_vexpand(false);
 
-    set_background(board_entry.board->get_background());
+    board_stats.add_css_class("caption");
+    board_stats.add_css_class("dim-label");
+    board_stats.set_visible(false);
+
     board_thumbnail.set_size_request(256, 256);
     board_thumbnail.set_margin_top(10);
     board_thumbnail.set_content_fit(Gtk::ContentFit::SCALE_DOWN);
 
-    local_board_entry.board->signal_name_changed().connect(
-        [this]() { set_name_(local_board_entry.board->get_name()); });
-    local_board_entry.board->signal_background().connect(
-        [this](std::string background) { set_background(background); });
-
     root_box.set_spacing(4);
     root_box.append(board_thumbnail);
     root_box.append(board_name);
+    root_box.append(board_stats);
     set_child(root_box);
 }
 
+void ui::BoardCardButton::set_local_board(const LocalBoard& board_entry) {
+    local_board_entry = board_entry;
+    set_name_(board_entry.board->get_name());
+    set_background(board_entry.board->get_background());
+
+    name_cnn = local_board_entry.board->signal_name_changed().connect(
+        [this]() { set_name_(local_board_entry.board->get_name()); });
+    background_cnn = local_board_entry.board->signal_background().connect(
+        [this](std::string background) { set_background(background); });
+}
+
+void ui::BoardCardButton::unset_local_board() {
+    name_cnn.disconnect();
+    background_cnn.disconnect();
+    local_board_entry = LocalBoard{};
+    board_thumbnail.set_paintable(nullptr);
+    set_stats(std::nullopt);
+}
+
+const LocalBoard& ui::BoardCardButton::get_local_board() const {
+    return local_board_entry;
+}
+
 time_point<system_clock, seconds> ui::BoardCardButton::get_last_modified()
     const {
     return local_board_entry.board->get_last_modified();
 }
 
+void ui::BoardCardButton::set_stats(const std::optional<CardStats>& stats) {
+    if (stats) {
+        board_stats.set_markup(card_stats_markup(*stats));
+    }
+    board_stats.set_visible(stats.has_value());
+}
+
 const std::shared_ptr<Board> ui::BoardCardButton::get_board() const {
     return local_board_entry.board;
 }
@@ -63,7 +125,22 @@ void ui::BoardCardButton::set_background(const std::string& background) {
             break;
         }
         case BackgroundType::IMAGE: {
-            board_thumbnail.set_filename(compressed_thumb_filename(background));
+            // Nothing is shown until the thumbnail is ready
+            board_thumbnail.set_paintable(nullptr);
+            ImagePipeline::get().request_thumbnail(
+                background,
+                sigc::track_obj(
+                    [this, board = local_board_entry.board,
+                     background](const std::string& thumbnail) {
+                        // The button may show another board by now
+                        if (thumbnail.empty() ||
+                            local_board_entry.board != board ||
+                            board->get_background() != background) {
+                            return;
+                        }
+                        board_thumbnail.set_filename(thumbnail);
+                    },
+                    *this));
             break;
         }
         case BackgroundType::INVALID: {
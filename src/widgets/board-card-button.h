@@ -5,11 +5,18 @@
 
 #include <chrono>
 #include <compare>
+#include <optional>
 
 namespace ui {
 
 using namespace std::chrono;
 
+/**
+ * @brief Returns a one line summary of card statistics as Pango markup. Every
+ * card color is shown as a dot of that color followed by its number of cards
+ */
+std::string card_stats_markup(const CardStats& stats);
+
 /**
  * @brief Custom Gtk::Button implementation that presents to the user the board
  * to be loaded. It also shows the user to which Board the button will lead to
@@ -28,6 +35,25 @@ public:
      */
     BoardCardButton(LocalBoard board_entry);
 
+    /**
+     * @brief Creates a button that is not showing any board yet. Boards are
+     * given through set_local_board
+     */
+    BoardCardButton();
+
+    /**
+     * @brief Shows another board. The button follows the board's name and
+     * background changes until it is given another one
+     */
+    void set_local_board(const LocalBoard& board_entry);
+
+    /**
+     * @brief Stops showing the current board
+     */
+    void unset_local_board();
+
+    const LocalBoard& get_local_board() const;
+
     /**
      * @brief Updates the button's title
      */
@@ -38,6 +64,12 @@ public:
      */
     void set_background(const std::string& background);
 
+    /**
+     * @brief Updates the statistics shown below the title. Nothing is shown
+     * if they are not known
+     */
+    void set_stats(const std::optional<CardStats>& stats);
+
     const std::shared_ptr<Board> get_board() const;
 
     /**
@@ -51,6 +83,8 @@ private:
     Gtk::Box root_box;
     Gtk::Picture board_thumbnail;
     Gtk::Label board_name;
+    Gtk::Label board_stats;
     LocalBoard local_board_entry;
+    sigc::scoped_connection name_cnn, background_cnn;
 };
 }  // namespace ui
@@ -0,0 +1,163 @@
+#include "board-list-model.h"
+
+#include <algorithm>
+
+namespace ui {
+
+Glib::RefPtr<BoardObject> BoardObject::create(const LocalBoard& local_board) {
+    return Glib::make_refptr_for_instance<BoardObject>(
+        new BoardObject{local_board});
+}
+
+BoardObject::BoardObject(const LocalBoard& local_board)
+    : Glib::Object{}, m_local_board{local_board} {}
+
+const LocalBoard& BoardObject::local_board() const { return m_local_board; }
+
+Glib::RefPtr<BoardListModel> BoardListModel::create() {
+    return Glib::make_refptr_for_instance<BoardListModel>(new BoardListModel{});
+}
+
+BoardListModel::BoardListModel()
+    : Glib::ObjectBase{typeid(BoardListModel)},
+      Glib::Object{},
+      Gio::ListModel{} {}
+
+void BoardListModel::insert(const LocalBoard& local_board) {
+    if (m_modified.contains(local_board.board.get())) {
+        return;
+    }
+
+    const TimePoint modified = local_board.board->get_last_modified();
+    auto it = m_entries.insert(position_for(modified),
+                               Entry{local_board, modified, nullptr});
+    m_modified[local_board.board.get()] = modified;
+    items_changed(std::distance(m_entries.begin(), it), 0, 1);
+}
+
+void BoardListModel::insert(const std::vector<LocalBoard>& local_boards) {
+    std::vector<Entry> new_entries;
+    for (const LocalBoard& local_board : local_boards) {
+        if (m_modified.contains(local_board.board.get())) {
+            continue;
+        }
+
+        const TimePoint modified = local_board.board->get_last_modified();
+        new_entries.push_back(Entry{local_board, modified, nullptr});
+        m_modified[local_board.board.get()] = modified;
+    }
+    if (new_entries.empty()) {
+        return;
+    }
+
+    const auto newest_first = [](const Entry& a, const Entry& b) {
+        return a.modified > b.modified;
+    };
+    std::stable_sort(new_entries.begin(), new_entries.end(), newest_first);
+
+    const guint old_size = m_entries.size();
+    const bool older =
+        m_entries.empty() ||
+        new_entries.front().modified <= m_entries.back().modified;
+    m_entries.insert(m_entries.end(),
+                     std::make_move_iterator(new_entries.begin()),
+                     std::make_move_iterator(new_entries.end()));
+
+    // Pages of boards come in order, so they usually go after every board
+    // already shown and the rows above them are left alone
+    if (older) {
+        items_changed(old_size, 0, new_entries.size());
+    } else {
+        std::inplace_merge(m_entries.begin(),
+                           std::next(m_entries.begin(), old_size),
+                           m_entries.end(), newest_first);
+        items_changed(0, old_size, m_entries.size());
+    }
+}
+
+void BoardListModel::remove(const std::shared_ptr<Board>& board) {
+    const ssize_t index = find(board);
+    if (index == -1) {
+        return;
+    }
+
+    m_entries.erase(std::next(m_entries.begin(), index));
+    m_modified.erase(board.get());
+    items_changed(index, 1, 0);
+}
+
+void BoardListModel::update(const std::shared_ptr<Board>& board) {
+    const ssize_t old_i = find(board);
+    const TimePoint modified = board->get_last_modified();
+    if (old_i == -1 || m_entries[old_i].modified == modified) {
+        return;
+    }
+
+    Entry entry = std::move(m_entries[old_i]);
+    entry.modified = modified;
+    m_entries.erase(std::next(m_entries.begin(), old_i));
+    const ssize_t new_i = std::distance(
+        m_entries.begin(),
+        m_entries.insert(position_for(modified), std::move(entry)));
+    m_modified[board.get()] = modified;
+
+    const guint first = std::min(old_i, new_i);
+    const guint n_changed = std::max(old_i, new_i) - first + 1;
+    items_changed(first, n_changed, n_changed);
+}
+
+std::shared_ptr<Board> BoardListModel::get_board(guint position) const {
+    if (position >= m_entries.size()) {
+        return nullptr;
+    }
+    return m_entries[position].local_board.board;
+}
+
+ssize_t BoardListModel::find(const std::shared_ptr<Board>& board) const {
+    auto modified = m_modified.find(board.get());
+    if (modified == m_modified.end()) {
+        return -1;
+    }
+
+    // Only the boards sorted by the same time have to be looked at
+    const TimePoint time = modified->second;
+    auto first = std::partition_point(
+        m_entries.begin(), m_entries.end(),
+        [time](const Entry& entry) { return entry.modified > time; });
+    auto last = std::partition_point(
+        first, m_entries.end(),
+        [time](const Entry& entry) { return entry.modified >= time; });
+    auto it = std::find_if(first, last, [&board](const Entry& entry) {
+        return entry.local_board.board == board;
+    });
+    return it != last ? std::distance(m_entries.begin(), it) : -1;
+}
+
+guint BoardListModel::size() const { return m_entries.size(); }
+
+GType BoardListModel::get_item_type_vfunc() {
+    return Glib::Object::get_base_type();
+}
+
+guint BoardListModel::get_n_items_vfunc() { return m_entries.size(); }
+
+gpointer BoardListModel::get_item_vfunc(guint position) {
+    if (position >= m_entries.size()) {
+        return nullptr;
+    }
+
+    // Grid views compare items by identity, so a wrapper is kept once created
+    Entry& entry = m_entries[position];
+    if (!entry.item) {
+        entry.item = BoardObject::create(entry.local_board);
+    }
+    return entry.item->gobj_copy();
+}
+
+std::vector<BoardListModel::Entry>::iterator BoardListModel::position_for(
+    TimePoint modified) {
+    return std::partition_point(
+        m_entries.begin(), m_entries.end(),
+        [modified](const Entry& entry) { return entry.modified > modified; });
+}
+}  // namespace ui
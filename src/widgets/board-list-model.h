@@ -0,0 +1,103 @@
+#pragma once
+
+#include <core/board-manager.h>
+#include <giomm/listmodel.h>
+#include <glibmm/object.h>
+
+#include <chrono>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace ui {
+
+/**
+ * @brief Glib::Object wrapper around a LocalBoard so it can be handed out by
+ * a Gio::ListModel
+ */
+class BoardObject : public Glib::Object {
+public:
+    static Glib::RefPtr<BoardObject> create(const LocalBoard& local_board);
+
+    const LocalBoard& local_board() const;
+
+protected:
+    BoardObject(const LocalBoard& local_board);
+
+    LocalBoard m_local_board;
+};
+
+/**
+ * @brief Gio::ListModel of the local boards, most recently modified first.
+ *
+ * @details Boards are kept sorted by the modification time they had when they
+ * were last added or updated, so a board is found by binary search and an
+ * updated board is moved straight to its new position. Only the rows between
+ * its old and new positions are reported as changed.
+ */
+class BoardListModel : public Glib::Object, public Gio::ListModel {
+public:
+    using TimePoint =
+        std::chrono::time_point<std::chrono::system_clock,
+                                std::chrono::seconds>;
+
+    static Glib::RefPtr<BoardListModel> create();
+
+    /**
+     * @brief Adds a board at the position matching its modification time
+     */
+    void insert(const LocalBoard& local_board);
+
+    /**
+     * @brief Adds many boards at once. Boards older than every board in the
+     * model are appended without touching the other rows
+     */
+    void insert(const std::vector<LocalBoard>& local_boards);
+
+    void remove(const std::shared_ptr<Board>& board);
+
+    /**
+     * @brief Moves the board to the position matching its current
+     * modification time
+     */
+    void update(const std::shared_ptr<Board>& board);
+
+    /**
+     * @brief Returns the board at the given position, or nullptr if the
+     * position is out of range
+     */
+    std::shared_ptr<Board> get_board(guint position) const;
+
+    /**
+     * @brief Returns the position of the board in the model, or -1 if the
+     * board is not part of it
+     */
+    ssize_t find(const std::shared_ptr<Board>& board) const;
+
+    guint size() const;
+
+protected:
+    struct Entry {
+        LocalBoard local_board;
+        TimePoint modified;
+        Glib::RefPtr<BoardObject> item;
+    };
+
+    BoardListModel();
+
+    GType get_item_type_vfunc() override;
+    guint get_n_items_vfunc() override;
+    gpointer get_item_vfunc(guint position) override;
+
+    /**
+     * @brief Returns where a board modified at the given time goes. Boards
+     * come before older ones and before those modified at the same time
+     */
+    std::vector<Entry>::iterator position_for(TimePoint modified);
+
+    std::vector<Entry> m_entries;
+
+    // Modification time each board is sorted by
+    std::unordered_map<Board*, TimePoint> m_modified;
+};
+}  // namespace ui
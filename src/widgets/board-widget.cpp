@@ -1,69 +1,37 @@
 #include "board-widget.h"
 
 #include <glibmm/i18n.h>
+#include <image-pipeline.h>
+#include <spdlog/spdlog.h>
 #include <utils.h>
 #include <window.h>
 
+#include <algorithm>
+#include <cmath>
 #include <format>
 
 #include "cardlist-widget.h"
 
 namespace ui {
-#ifdef WIN32
 BoardWidget::BoardWidget()
     : Gtk::ScrolledWindow{},
       m_root{Gtk::Orientation::HORIZONTAL},
-      m_picture{},
-      m_scr{},
-      m_overlay{},
-      m_add_button{_("Add List")},
-      m_css_provider{Gtk::CssProvider::create()} {
-    Gtk::StyleProvider::add_provider_for_display(
-        get_display(), m_css_provider, GTK_STYLE_PROVIDER_PRIORITY_USER);
-    m_css_provider->load_from_data(BOARD_BACKGROUND);
+      m_add_button{_("Add List")} {
+    // The background is painted under the cardlists, so it does not scroll
+    // with them
+    set_policy(Gtk::PolicyType::NEVER, Gtk::PolicyType::NEVER);
     set_child(m_overlay);
-    m_picture.set_keep_aspect_ratio(false);
-
-    m_overlay.set_child(m_picture);
+    m_overlay.set_child(m_background_widget);
     m_overlay.add_overlay(m_scr);
     m_overlay.set_expand(true);
+    m_background_widget.set_color(Gdk::RGBA{Board::BACKGROUND_DEFAULT});
 
     m_scr.set_child(m_root);
 
     Gtk::Widget::set_name("board-root");
 
     __setup_auto_scrolling();
-
-    m_root.set_halign(Gtk::Align::START);
-    m_root.set_spacing(25);
-    m_root.set_margin(10);
-
-    m_add_button.signal_clicked().connect([this]() {
-        CardlistWidget* new_cardlist =
-            Gtk::make_managed<CardlistWidget>(*this, _("New CardList"));
-        append(*new_cardlist);
-    });
-    m_add_button.set_valign(Gtk::Align::START);
-    m_add_button.set_size_request(CardlistWidget::CARDLIST_MAX_WIDTH);
-    m_add_button.add_css_class("opaque");
-
-    m_root.append(m_add_button);
-}
-#else
-BoardWidget::BoardWidget()
-    : Gtk::ScrolledWindow{},
-      m_root{Gtk::Orientation::HORIZONTAL},
-      m_add_button{_("Add List")},
-      m_css_provider{Gtk::CssProvider::create()} {
-    Gtk::StyleProvider::add_provider_for_display(
-        get_display(), m_css_provider, GTK_STYLE_PROVIDER_PRIORITY_USER);
-    m_css_provider->load_from_data(BOARD_BACKGROUND);
-
-    set_child(m_root);
-
-    Gtk::Widget::set_name("board-root");
-
-    __setup_auto_scrolling();
+    __setup_viewport_tracking();
 
     m_root.set_halign(Gtk::Align::START);
     m_root.set_spacing(25);
@@ -81,103 +49,123 @@ BoardWidget::BoardWidget()
 
     m_root.append(m_add_button);
 }
-#endif
 
 void BoardWidget::set_name(const std::string& board_name) {
     m_name_changed_signal.emit(m_name, board_name);
     m_name = board_name;
 }
 
-#ifdef WIN32
 void BoardWidget::set_background(const std::string& background) {
     BackgroundType bg_type = Board::get_background_type(background);
     switch (bg_type) {
         case BackgroundType::COLOR: {
             m_background_changed_signal.emit(m_background, background);
             m_background = background;
-            m_css_provider->load_from_data(
-                std::format(BOARD_BACKGROUND_RGB, background));
-            m_picture.set_visible(false);
+            m_background_widget.set_color(Gdk::RGBA{background});
             break;
         }
         case BackgroundType::IMAGE: {
             m_background_changed_signal.emit(m_background, background);
             m_background = background;
-            m_picture.set_filename(compressed_bg_filename(background));
-            m_picture.set_visible(true);
+
+            // The default background stands in until the image is ready
+            m_background_widget.set_color(
+                Gdk::RGBA{Board::BACKGROUND_DEFAULT});
+            if (get_width() > 0) {
+                const int scale = get_scale_factor();
+                m_bg_quality =
+                    bg_quality_for(get_width() * scale, get_height() * scale);
+            }
+            request_background_image();
             break;
         }
         case BackgroundType::INVALID: {
-            m_picture.set_visible(false);
+            m_background_widget.set_color(
+                Gdk::RGBA{Board::BACKGROUND_DEFAULT});
             break;
         }
     }
 }
-#else
-void BoardWidget::set_background(const std::string& background) {
-    BackgroundType bg_type = Board::get_background_type(background);
-    switch (bg_type) {
-        case BackgroundType::COLOR: {
-            m_background_changed_signal.emit(m_background, background);
-            m_background = background;
-            m_css_provider->load_from_data(
-                std::format(BOARD_BACKGROUND_RGB, background));
-            break;
-        }
-        case BackgroundType::IMAGE: {
-            m_background_changed_signal.emit(m_background, background);
-            m_background = background;
-            m_css_provider->load_from_data(std::format(
-                BOARD_BACKGROUND_IMAGE, compressed_bg_filename(background)));
-            break;
-        }
-        case BackgroundType::INVALID: {
-            m_css_provider->load_from_data(
-                std::format(BOARD_BACKGROUND_RGB, Board::BACKGROUND_DEFAULT));
-            break;
-        }
+
+void BoardWidget::request_background_image() {
+    const std::string background = m_background;
+    const ImageQuality quality = m_bg_quality;
+    ImagePipeline::get().request_background(
+        background, quality,
+        sigc::track_obj(
+            [this, background, quality](const std::string& compressed) {
+                // The background or the board's size may have changed while
+                // the image was being compressed
+                if (background != m_background || quality != m_bg_quality ||
+                    compressed.empty()) {
+                    return;
+                }
+                m_background_widget.set_image(compressed);
+            },
+            *this));
+}
+
+void BoardWidget::size_allocate_vfunc(int width, int height, int baseline) {
+    Gtk::ScrolledWindow::size_allocate_vfunc(width, height, baseline);
+
+    const int scale = get_scale_factor();
+    if (m_bg_level_cnn.connected() ||
+        bg_quality_for(width * scale, height * scale) == m_bg_quality) {
+        return;
+    }
+
+    // The background is not changed while GTK is still allocating the board
+    m_bg_level_cnn = Glib::signal_idle().connect(
+        sigc::mem_fun(*this, &BoardWidget::update_background_level),
+        Glib::PRIORITY_HIGH_IDLE);
+}
+
+bool BoardWidget::update_background_level() {
+    const int scale = get_scale_factor();
+    const ImageQuality quality =
+        bg_quality_for(get_width() * scale, get_height() * scale);
+    if (quality == m_bg_quality) {
+        return false;
     }
+
+    m_bg_quality = quality;
+    if (Board::get_background_type(m_background) == BackgroundType::IMAGE) {
+        spdlog::get("app")->debug(
+            "[BoardWidget.update_background_level] Board is {}x{}, switching "
+            "to background level {}x{}",
+            get_width() * scale, get_height() * scale,
+            bg_size(quality).first, bg_size(quality).second);
+        request_background_image();
+    }
+    return false;
 }
-#endif
 
 void BoardWidget::append(CardlistWidget& child) {
     m_root.append(child);
     m_root.reorder_child_after(m_add_button, child);
+    m_cardlist_positions.append(&child);
+    m_awake.insert(&child);
 
     m_cardlist_added_signal.emit(&child, -1);
 }
 
 void BoardWidget::insert_after(CardlistWidget& widget,
                                CardlistWidget& sibling) {
-    ssize_t index = 0;
-    if (!sibling.get_next_sibling()) {
-        index = -1;
-    } else {
-        for (Gtk::Widget* cardlist = m_root.get_first_child();
-             cardlist && cardlist != &sibling;
-             (cardlist = cardlist->get_next_sibling(), index++));
-    }
+    const ssize_t index = sibling.get_next_sibling()
+                              ? m_cardlist_positions.index_of(&sibling)
+                              : -1;
 
     m_root.insert_child_after(widget, sibling);
+    m_cardlist_positions.insert_after(&widget, &sibling);
+    m_awake.insert(&widget);
     m_cardlist_added_signal.emit(&widget, index);
 }
 
 void BoardWidget::reorder(CardlistWidget& next, CardlistWidget& sibling) {
-    ssize_t next_i = -1;
-    ssize_t sibling_i = -1;
-
-    ssize_t c_i = 0;
-    for (Gtk::Widget* cardlist = m_root.get_first_child(); cardlist;
-         cardlist = cardlist->get_next_sibling()) {
-        if (&next == cardlist) {
-            next_i = c_i;
-        } else if (&sibling == cardlist) {
-            sibling_i = c_i;
-        }
-        c_i++;
-    }
+    const ssize_t next_i = m_cardlist_positions.index_of(&next);
+    const ssize_t sibling_i = m_cardlist_positions.index_of(&sibling);
 
-    if ((next_i) == -1 || (sibling_i == -1)) {
+    if ((next_i) == -1 || (sibling_i == -1) || (&next == &sibling)) {
         return;
     }
 
@@ -200,6 +188,12 @@ void BoardWidget::reorder(CardlistWidget& next, CardlistWidget& sibling) {
         }
     }
 
+    if (up) {
+        m_cardlist_positions.move_before(&next, &sibling);
+    } else {
+        m_cardlist_positions.move_after(&next, &sibling);
+    }
+
     m_cardlist_reorder_signal.emit(&next, &sibling, up);
 }
 
@@ -214,17 +208,26 @@ void BoardWidget::remove(CardlistWidget& cardlist) {
     }
 
     m_cardlist_remove_signal.emit(&cardlist);
+    m_cardlist_positions.erase(&cardlist);
+    m_awake.erase(&cardlist);
     m_root.remove(cardlist);
 }
 
 void BoardWidget::set_scroll(bool scroll) {
     m_on_scroll = scroll;
     m_scroll_changed_signal.emit();
+
+    // Cardlists scrolled out of view during a drag were left awake
+    if (!scroll) {
+        queue_viewport_update();
+    }
 }
 
 void BoardWidget::pop() {
     if (Gtk::Widget* cardlist = m_add_button.get_prev_sibling()) {
         m_cardlist_remove_signal.emit(static_cast<CardlistWidget*>(cardlist));
+        m_cardlist_positions.erase(static_cast<CardlistWidget*>(cardlist));
+        m_awake.erase(static_cast<CardlistWidget*>(cardlist));
         m_root.remove(*cardlist);
     }
 }
@@ -263,48 +266,176 @@ BoardWidget::signal_reorder() {
 void BoardWidget::__setup_auto_scrolling() {
     auto drop_controller_motion_c = Gtk::DropControllerMotion::create();
 
+    drop_controller_motion_c->signal_enter().connect(
+        [this](double x, double y) {
+            this->m_x = x;
+            this->m_y = y;
+            this->m_drag_inside = true;
+        });
     drop_controller_motion_c->signal_motion().connect(
         [this](double x, double y) {
             this->m_x = x;
             this->m_y = y;
         });
-#ifdef WIN32
+    drop_controller_motion_c->signal_leave().connect(
+        [this]() { this->m_drag_inside = false; });
     m_scr.add_controller(drop_controller_motion_c);
-#else
-    add_controller(drop_controller_motion_c);
-#endif
 
     m_scroll_changed_signal.connect([this]() {
-        if (m_on_scroll) {
-            m_timeout_scroller = Glib::signal_timeout().connect(
-                [this]() {
-#ifdef WIN32
-                    double cur_max_width = m_scr.get_width();
-                    auto hadjustment = m_scr.get_hadjustment();
-#else
-                    double cur_max_width = get_width();
-                    auto hadjustment = get_hadjustment();
-#endif
-                    double lower = hadjustment->get_lower();
-                    double upper = hadjustment->get_upper();
-
-                    if (m_x >= (cur_max_width * 0.8)) {
-                        double new_value =
-                            hadjustment->get_value() + SCROLL_SPEED_FACTOR;
-                        hadjustment->set_value(new_value >= upper ? upper
-                                                                  : new_value);
-                    } else if (m_x <= (cur_max_width * 0.2)) {
-                        double new_value =
-                            hadjustment->get_value() - SCROLL_SPEED_FACTOR;
-                        hadjustment->set_value(new_value <= lower ? lower
-                                                                  : new_value);
-                    }
-                    return true;
-                },
-                10);
-        } else {
-            m_timeout_scroller.disconnect();
+        if (m_on_scroll && !m_scroll_tick_id) {
+            m_scroll_last_frame = 0;
+            m_scroll_frames = 0;
+            m_scroll_total_frame_time = m_scroll_worst_frame_time = 0;
+            m_scroll_tick_id = add_tick_callback(
+                sigc::mem_fun(*this, &BoardWidget::tick_auto_scroll));
+        } else if (!m_on_scroll) {
+            stop_auto_scroll();
         }
     });
 }
+
+bool BoardWidget::tick_auto_scroll(
+    const Glib::RefPtr<Gdk::FrameClock>& frame_clock) {
+    const gint64 frame_time = frame_clock->get_frame_time();
+    const gint64 interval =
+        m_scroll_last_frame ? frame_time - m_scroll_last_frame : 0;
+    m_scroll_last_frame = frame_time;
+    if (interval > 0) {
+        m_scroll_frames++;
+        m_scroll_total_frame_time += interval;
+        m_scroll_worst_frame_time =
+            std::max(m_scroll_worst_frame_time, interval);
+    }
+
+    if (!m_drag_inside || interval <= 0) {
+        return true;
+    }
+
+    const double width = m_scr.get_width();
+    auto hadjustment = m_scr.get_hadjustment();
+    const double edge = width * AUTO_SCROLL_EDGE;
+    if (edge <= 0) {
+        return true;
+    }
+
+    // How far into an edge the pointer is, from 0 (the edge's inner border)
+    // to 1 (the board's border). Negative values scroll to the left
+    double depth = 0;
+    if (m_x >= width - edge) {
+        depth = (m_x - (width - edge)) / edge;
+    } else if (m_x <= edge) {
+        depth = -(edge - m_x) / edge;
+    }
+    if (depth == 0) {
+        return true;
+    }
+    depth = std::clamp(depth, -1.0, 1.0);
+
+    // Speed grows quadratically so the board can be nudged near the edge's
+    // inner border
+    const double velocity = AUTO_SCROLL_MAX_SPEED * depth * std::abs(depth);
+    const double step = velocity *
+                        std::min(interval, AUTO_SCROLL_MAX_FRAME_TIME) /
+                        G_USEC_PER_SEC;
+
+    const double lower = hadjustment->get_lower();
+    const double upper = std::max(
+        lower, hadjustment->get_upper() - hadjustment->get_page_size());
+    hadjustment->set_value(
+        std::clamp(hadjustment->get_value() + step, lower, upper));
+    return true;
+}
+
+void BoardWidget::stop_auto_scroll() {
+    if (!m_scroll_tick_id) {
+        return;
+    }
+
+    remove_tick_callback(m_scroll_tick_id);
+    m_scroll_tick_id = 0;
+    m_drag_inside = false;
+
+    if (m_scroll_frames) {
+        spdlog::get("app")->debug(
+            "[BoardWidget.stop_auto_scroll] Auto-scroll ran for {} frames "
+            "(mean frame interval {:.2f}ms, worst {:.2f}ms)",
+            m_scroll_frames,
+            m_scroll_total_frame_time / (m_scroll_frames * 1000.0),
+            m_scroll_worst_frame_time / 1000.0);
+    }
+}
+
+void BoardWidget::__setup_viewport_tracking() {
+    auto hadjustment = m_scr.get_hadjustment();
+
+    // value-changed covers scrolling, changed covers resizes and cardlists
+    // being added or removed
+    hadjustment->signal_value_changed().connect(
+        sigc::mem_fun(*this, &BoardWidget::queue_viewport_update));
+    hadjustment->signal_changed().connect(
+        sigc::mem_fun(*this, &BoardWidget::queue_viewport_update));
+}
+
+void BoardWidget::queue_viewport_update() {
+    if (m_viewport_update_cnn.connected()) {
+        return;
+    }
+
+    // Run before the next frame is drawn
+    m_viewport_update_cnn = Glib::signal_idle().connect(
+        sigc::mem_fun(*this, &BoardWidget::update_viewport),
+        Glib::PRIORITY_HIGH_IDLE);
+}
+
+bool BoardWidget::update_viewport() {
+    auto hadjustment = m_scr.get_hadjustment();
+    const double page_size = hadjustment->get_page_size();
+    const size_t n_cardlists = m_cardlist_positions.size();
+
+    // Nothing is known about the viewport before the board is allocated
+    if (page_size <= 0 || n_cardlists == 0) {
+        return false;
+    }
+
+    // Cardlists share the same width whether they are dormant or not, so the
+    // ones in view are found from their positions without walking the others
+    CardlistWidget* first_cardlist = m_cardlist_positions.at(0);
+    const double width = first_cardlist->get_width() > 0
+                             ? first_cardlist->get_width()
+                             : CardlistWidget::CARDLIST_MAX_WIDTH;
+    const double stride = width + m_root.get_spacing();
+    const double start = hadjustment->get_value() -
+                         (page_size * VIEWPORT_MARGIN) -
+                         m_root.get_margin_start();
+    const double end = hadjustment->get_value() +
+                       (page_size * (1 + VIEWPORT_MARGIN)) -
+                       m_root.get_margin_start();
+
+    const size_t first = std::clamp(std::floor(start / stride), 0.0,
+                                    double(n_cardlists));
+    const size_t last = std::clamp(std::floor(end / stride) + 1, 0.0,
+                                   double(n_cardlists));
+
+    std::unordered_set<CardlistWidget*> awake;
+    for (size_t i = first; i < last; i++) {
+        CardlistWidget* cardlist = m_cardlist_positions.at(i);
+        cardlist->set_dormant(false);
+        awake.insert(cardlist);
+    }
+
+    // Whatever is being dragged keeps its widgets until it is dropped
+    if (m_on_scroll) {
+        m_awake.insert(awake.begin(), awake.end());
+        return false;
+    }
+
+    for (CardlistWidget* cardlist : m_awake) {
+        if (!awake.contains(cardlist)) {
+            cardlist->set_dormant(true);
+        }
+    }
+    m_awake = std::move(awake);
+
+    return false;
+}
 }  // namespace ui
@@ -1,10 +1,15 @@
 #pragma once
 
 #include <core/board-manager.h>
+#include <core/position-index.h>
 #include <gtkmm.h>
+#include <utils.h>
 
+#include <unordered_set>
 #include <utility>
 
+#include "board-background.h"
+
 namespace ui {
 class CardlistWidget;
 
@@ -14,21 +19,29 @@ using CardlistWidgetLocation = std::pair<CardlistWidget*, int>;
  */
 class BoardWidget : public Gtk::ScrolledWindow {
 public:
-    static constexpr const char* BOARD_BACKGROUND =
-        "#board-root {transition-property: background-image, "
-        "background-color;}";
-    static constexpr const char* BOARD_BACKGROUND_IMAGE =
-        "#board-root {{transition-property: background-image, "
-        "background-color; "
-        "background-size: cover;"
-        "background-repeat: no-repeat;"
-        "background-image: url(\"file:{}\");}}";
-    static constexpr const char* BOARD_BACKGROUND_RGB =
-        "#board-root {{transition-property: background-image, "
-        "background-color; "
-        "background-color: {};}}";
-
-    static constexpr int SCROLL_SPEED_FACTOR = 6;
+    /**
+     * @brief Fraction of the visible width, on each side of the board, in
+     * which dragging something scrolls the board
+     */
+    static constexpr double AUTO_SCROLL_EDGE = 0.2;
+
+    /**
+     * @brief Scrolling speed, in pixels per second, reached when the pointer
+     * is right at the edge of the board
+     */
+    static constexpr double AUTO_SCROLL_MAX_SPEED = 1500;
+
+    /**
+     * @brief Longest frame interval, in microseconds, the auto-scroller makes
+     * up for. The board does not jump after longer stalls
+     */
+    static constexpr gint64 AUTO_SCROLL_MAX_FRAME_TIME = 1000 * 50;
+
+    /**
+     * @brief Fraction of the visible width, on each side of the viewport, in
+     * which cardlists are kept awake
+     */
+    static constexpr double VIEWPORT_MARGIN = 0.5;
 
     /**
      * @brief BoardWidget constructor
@@ -128,11 +141,61 @@ public:
 
 protected:
     void __setup_auto_scrolling();
+    void __setup_viewport_tracking();
+
+    /**
+     * @brief Looks for a better fitting background pyramid level whenever
+     * the board is resized
+     */
+    void size_allocate_vfunc(int width, int height, int baseline) override;
+
+    /**
+     * @brief Switches to the smallest background pyramid level covering the
+     * board, if it is not the one shown already
+     */
+    bool update_background_level();
+
+    /**
+     * @brief Requests the m_bg_quality level of the background image and
+     * shows it once it is ready
+     */
+    void request_background_image();
+
+    /**
+     * @brief Frame clock callback scrolling the board while something is
+     * dragged close to its edges. The scrolled distance follows the time
+     * elapsed since the last frame, so the speed does not depend on the
+     * display's refresh rate
+     */
+    bool tick_auto_scroll(const Glib::RefPtr<Gdk::FrameClock>& frame_clock);
+
+    /**
+     * @brief Removes the auto-scroll tick callback and reports its frame
+     * pacing
+     */
+    void stop_auto_scroll();
+
+    /**
+     * @brief Schedules a viewport update. Updates requested before the
+     * scheduled one runs are merged into it
+     */
+    void queue_viewport_update();
+
+    /**
+     * @brief Wakes up the cardlists intersecting the visible region (plus
+     * VIEWPORT_MARGIN) and puts the remaining awake ones to sleep. Only the
+     * cardlists in view and the ones awake before are visited
+     */
+    bool update_viewport();
 
     std::string m_name;
     std::string m_background;
 
-    sigc::connection m_timeout_scroller;
+    sigc::connection m_viewport_update_cnn;
+
+    // Background pyramid level fitting the board's size
+    ImageQuality m_bg_quality = ImageQuality::MEDIUM;
+    sigc::connection m_bg_level_cnn;
 
     sigc::signal<void(std::string, std::string)> m_name_changed_signal;
     sigc::signal<void(std::string, std::string)> m_background_changed_signal;
@@ -151,19 +214,28 @@ protected:
 
     sigc::signal<void()> m_scroll_changed_signal;
 
-#ifdef WIN32
+    // The cardlists are scrolled by m_scr, on top of the background
     Gtk::Overlay m_overlay;
-    Gtk::Picture m_picture;
+    BoardBackground m_background_widget;
     Gtk::ScrolledWindow m_scr;
-#endif
 
     Gtk::Box m_root;
     Gtk::Button m_add_button;
-    Glib::RefPtr<Gtk::CssProvider> m_css_provider;
+
+    // Positions of the cardlist widgets among m_root's children
+    PositionIndex<CardlistWidget*> m_cardlist_positions;
+
+    // Cardlists that may be awake. New cardlists start awake
+    std::unordered_set<CardlistWidget*> m_awake;
 
     // Necessary for drag-and-drop
-    double m_x, m_y;
-    bool m_on_scroll = false;
+    double m_x = 0, m_y = 0;
+    bool m_on_scroll = false, m_drag_inside = false;
+
+    // Auto-scroll context. Frame intervals are kept to measure its pacing
+    guint m_scroll_tick_id = 0, m_scroll_frames = 0;
+    gint64 m_scroll_last_frame = 0, m_scroll_total_frame_time = 0,
+           m_scroll_worst_frame_time = 0;
 };
 
 }  // namespace ui
@@ -0,0 +1,140 @@
+#include "card-filter-popover.h"
+
+#include <glibmm/i18n.h>
+
+#include <array>
+
+#include "card-widget.h"
+
+namespace ui {
+
+CardFilterPopover::CardFilterPopover()
+    : Gtk::Popover{},
+      m_root{Gtk::Orientation::VERTICAL},
+      m_match_any_box{Gtk::Orientation::HORIZONTAL},
+      m_match_any_label{_("Match any option")},
+      m_clear_button{_("Clear")} {
+    set_position(Gtk::PositionType::BOTTOM);
+
+    m_root.set_spacing(6);
+    m_root.set_margin(6);
+
+    const std::array<std::pair<CoverColor, Color>, 7> colors = {
+        std::pair{CoverColor::RED, RED_COLOR},
+        {CoverColor::ORANGE, ORANGE_COLOR},
+        {CoverColor::YELLOW, YELLOW_COLOR},
+        {CoverColor::GREEN, GREEN_COLOR},
+        {CoverColor::BLUE, BLUE_COLOR},
+        {CoverColor::PURPLE, PURPLE_COLOR},
+        {CoverColor::UNSET, NO_COLOR}};
+    OptionList color_options;
+    for (const auto& [cover_color, color] : colors) {
+        color_options.emplace_back(
+            label_for_color(cover_color),
+            CardCondition{CardAttribute::COLOR, color});
+    }
+    add_group(_("Color"), color_options);
+
+    add_group(_("Due Date"),
+              {{_("Overdue"), CardCondition{CardAttribute::OVERDUE}},
+               {_("Due soon"), CardCondition{CardAttribute::DUE_SOON}},
+               {_("Complete"), CardCondition{CardAttribute::COMPLETE}}});
+    add_group(_("Notes"),
+              {{_("Has notes"), CardCondition{CardAttribute::NOTES}}});
+    add_group(_("Tasks"),
+              {{_("No tasks"), CardCondition{CardAttribute::TASKS, NO_COLOR,
+                                             TaskProgress::NO_TASKS}},
+               {_("Not started"),
+                CardCondition{CardAttribute::TASKS, NO_COLOR,
+                              TaskProgress::NOT_STARTED}},
+               {_("In progress"),
+                CardCondition{CardAttribute::TASKS, NO_COLOR,
+                              TaskProgress::IN_PROGRESS}},
+               {_("Done"), CardCondition{CardAttribute::TASKS, NO_COLOR,
+                                         TaskProgress::DONE}}});
+
+    m_match_any_label.set_hexpand();
+    m_match_any_label.set_halign(Gtk::Align::START);
+    m_match_any.set_valign(Gtk::Align::CENTER);
+    m_match_any.property_active().signal_changed().connect(
+        sigc::mem_fun(*this, &CardFilterPopover::update_filter));
+    m_match_any_box.set_spacing(6);
+    m_match_any_box.append(m_match_any_label);
+    m_match_any_box.append(m_match_any);
+    m_root.append(m_match_any_box);
+
+    m_clear_button.signal_clicked().connect([this]() {
+        reset();
+        m_changed_signal.emit(m_filter);
+    });
+    m_root.append(m_clear_button);
+
+    set_child(m_root);
+}
+
+const CardFilter& CardFilterPopover::get_filter() const { return m_filter; }
+
+void CardFilterPopover::reset() {
+    m_resetting = true;
+    for (const Option& option : m_options) {
+        option.button->set_active(false);
+    }
+    m_match_any.set_active(false);
+    m_resetting = false;
+
+    m_filter = CardFilter{};
+}
+
+sigc::signal<void(CardFilter)>& CardFilterPopover::signal_changed() {
+    return m_changed_signal;
+}
+
+void CardFilterPopover::add_group(const std::string& title,
+                                  const OptionList& options) {
+    auto title_label = Gtk::make_managed<Gtk::Label>(title);
+    title_label->set_halign(Gtk::Align::START);
+    title_label->add_css_class("heading");
+    m_root.append(*title_label);
+
+    auto flowbox = Gtk::make_managed<Gtk::FlowBox>();
+    flowbox->set_selection_mode(Gtk::SelectionMode::NONE);
+    flowbox->set_max_children_per_line(4);
+    for (const auto& [label, condition] : options) {
+        auto button = Gtk::make_managed<Gtk::CheckButton>(label);
+        button->signal_toggled().connect(
+            sigc::mem_fun(*this, &CardFilterPopover::update_filter));
+        flowbox->append(*button);
+        m_options.push_back(Option{button, condition, m_n_groups});
+    }
+    m_root.append(*flowbox);
+    m_n_groups++;
+}
+
+void CardFilterPopover::update_filter() {
+    if (m_resetting) {
+        return;
+    }
+
+    std::vector<std::vector<CardCondition>> groups(m_n_groups);
+    for (const Option& option : m_options) {
+        if (option.button->get_active()) {
+            groups[option.group].push_back(option.condition);
+        }
+    }
+
+    m_filter = CardFilter{};
+    for (auto& group : groups) {
+        if (group.empty()) {
+            continue;
+        }
+        if (m_match_any.get_active() && !m_filter.empty()) {
+            m_filter.clauses.front().insert(m_filter.clauses.front().end(),
+                                            group.begin(), group.end());
+        } else {
+            m_filter.clauses.push_back(std::move(group));
+        }
+    }
+    m_changed_signal.emit(m_filter);
+}
+
+}  // namespace ui
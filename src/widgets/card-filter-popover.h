@@ -0,0 +1,66 @@
+#pragma once
+
+#include <core/card-filter-index.h>
+#include <gtkmm.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ui {
+
+/**
+ * @brief Popover picking the quick filter of the open board
+ *
+ * @details Options of the same group (e.g. two colors) are combined with OR
+ * and groups are combined with AND, unless "Match any" is on, in which case
+ * every option is combined with OR. The filter is reported as soon as an
+ * option is toggled.
+ */
+class CardFilterPopover : public Gtk::Popover {
+public:
+    CardFilterPopover();
+
+    const CardFilter& get_filter() const;
+
+    /**
+     * @brief Unchecks every option without emitting signal_changed()
+     */
+    void reset();
+
+    /**
+     * @brief void(filter)
+     */
+    sigc::signal<void(CardFilter)>& signal_changed();
+
+protected:
+    struct Option {
+        Gtk::CheckButton* button;
+        CardCondition condition;
+        size_t group;
+    };
+
+    using OptionList = std::vector<std::pair<std::string, CardCondition>>;
+
+    void add_group(const std::string& title, const OptionList& options);
+
+    /**
+     * @brief Rebuilds the filter from the checked options
+     */
+    void update_filter();
+
+    Gtk::Box m_root;
+    Gtk::Box m_match_any_box;
+    Gtk::Label m_match_any_label;
+    Gtk::Switch m_match_any;
+    Gtk::Button m_clear_button;
+
+    std::vector<Option> m_options;
+    size_t m_n_groups = 0;
+    bool m_resetting = false;
+
+    CardFilter m_filter;
+    sigc::signal<void(CardFilter)> m_changed_signal;
+};
+
+}  // namespace ui
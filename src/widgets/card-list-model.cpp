@@ -0,0 +1,148 @@
+#include "card-list-model.h"
+
+#include <algorithm>
+
+namespace ui {
+
+Glib::RefPtr<CardObject> CardObject::create(
+    const std::shared_ptr<Card>& card) {
+    return Glib::make_refptr_for_instance<CardObject>(new CardObject{card});
+}
+
+CardObject::CardObject(const std::shared_ptr<Card>& card)
+    : Glib::Object{}, m_card{card} {}
+
+const std::shared_ptr<Card>& CardObject::card() const { return m_card; }
+
+Glib::RefPtr<CardListModel> CardListModel::create(
+    const std::shared_ptr<CardList>& cardlist) {
+    return Glib::make_refptr_for_instance<CardListModel>(
+        new CardListModel{cardlist});
+}
+
+CardListModel::CardListModel(const std::shared_ptr<CardList>& cardlist)
+    : Glib::ObjectBase{typeid(CardListModel)},
+      Glib::Object{},
+      Gio::ListModel{},
+      m_cardlist{cardlist} {
+    auto& container = m_cardlist->container();
+    m_items.reserve(container.size());
+    for (const auto& card : container) {
+        m_items.push_back(CardObject::create(card));
+        m_positions.append(card.get());
+    }
+
+    m_cnns.push_back(container.signal_append().connect(
+        sigc::mem_fun(*this, &CardListModel::on_append)));
+    m_cnns.push_back(container.signal_insert().connect(
+        sigc::mem_fun(*this, &CardListModel::on_insert)));
+    m_cnns.push_back(container.signal_remove().connect(
+        sigc::mem_fun(*this, &CardListModel::on_remove)));
+    m_cnns.push_back(container.signal_reorder().connect(
+        sigc::mem_fun(*this, &CardListModel::on_reorder)));
+    m_cnns.push_back(container.signal_move().connect(
+        sigc::mem_fun(*this, &CardListModel::on_move)));
+}
+
+std::shared_ptr<Card> CardListModel::get_card(guint position) const {
+    if (position >= m_items.size()) {
+        return nullptr;
+    }
+    return m_items[position]->card();
+}
+
+ssize_t CardListModel::find(const std::shared_ptr<Card>& card) const {
+    return m_positions.index_of(card.get());
+}
+
+guint CardListModel::size() const { return m_items.size(); }
+
+GType CardListModel::get_item_type_vfunc() {
+    return Glib::Object::get_base_type();
+}
+
+guint CardListModel::get_n_items_vfunc() { return m_items.size(); }
+
+gpointer CardListModel::get_item_vfunc(guint position) {
+    if (position >= m_items.size()) {
+        return nullptr;
+    }
+    return m_items[position]->gobj_copy();
+}
+
+void CardListModel::on_append(std::shared_ptr<Card> card) {
+    m_items.push_back(CardObject::create(card));
+    m_positions.append(card.get());
+    items_changed(m_items.size() - 1, 0, 1);
+}
+
+void CardListModel::on_insert(std::shared_ptr<Card> card, ssize_t index) {
+    m_items.insert(std::next(m_items.begin(), index), CardObject::create(card));
+    m_positions.insert(card.get(), index);
+    items_changed(index, 0, 1);
+}
+
+void CardListModel::on_remove(std::shared_ptr<Card> card) {
+    const ssize_t index = find(card);
+    if (index == -1) {
+        return;
+    }
+
+    m_items.erase(std::next(m_items.begin(), index));
+    m_positions.erase(card.get());
+    items_changed(index, 1, 0);
+}
+
+void CardListModel::on_reorder(std::shared_ptr<Card> next,
+                               std::shared_ptr<Card> sibling,
+                               ReorderingType type) {
+    if (type == ReorderingType::INVALID) {
+        return;
+    }
+
+    // The container put the card right next to its sibling
+    const ssize_t old_i = find(next);
+    const bool moved = type == ReorderingType::AFTER
+                           ? m_positions.move_after(next.get(), sibling.get())
+                           : m_positions.move_before(next.get(), sibling.get());
+    const ssize_t new_i = find(next);
+    if (!moved || old_i == new_i) {
+        return;
+    }
+
+    auto item = m_items[old_i];
+    m_items.erase(std::next(m_items.begin(), old_i));
+    m_items.insert(std::next(m_items.begin(), new_i), item);
+
+    const guint first = std::min(old_i, new_i);
+    const guint n_changed = std::max(old_i, new_i) - first + 1;
+    items_changed(first, n_changed, n_changed);
+}
+
+void CardListModel::on_move(std::shared_ptr<Card> card,
+                            ItemContainer<Card>* from, ssize_t from_index,
+                            ItemContainer<Card>* to, ssize_t to_index) {
+    // The model mirrors the container, so positions are taken as they are
+    ItemContainer<Card>* container = &m_cardlist->container();
+    if (from == container && to == container) {
+        auto item = m_items[from_index];
+        m_items.erase(std::next(m_items.begin(), from_index));
+        m_items.insert(std::next(m_items.begin(), to_index), item);
+        m_positions.erase(card.get());
+        m_positions.insert(card.get(), to_index);
+
+        const guint first = std::min(from_index, to_index);
+        const guint n_changed = std::max(from_index, to_index) - first + 1;
+        items_changed(first, n_changed, n_changed);
+    } else if (from == container) {
+        m_items.erase(std::next(m_items.begin(), from_index));
+        m_positions.erase(card.get());
+        items_changed(from_index, 1, 0);
+    } else if (to == container) {
+        m_items.insert(std::next(m_items.begin(), to_index),
+                       CardObject::create(card));
+        m_positions.insert(card.get(), to_index);
+        items_changed(to_index, 0, 1);
+    }
+}
+}  // namespace ui
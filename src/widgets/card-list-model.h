@@ -0,0 +1,78 @@
+#pragma once
+
+#include <core/cardlist.h>
+#include <core/position-index.h>
+#include <giomm/listmodel.h>
+#include <glibmm/object.h>
+
+#include <memory>
+#include <vector>
+
+namespace ui {
+
+/**
+ * @brief Glib::Object wrapper around a Card so it can be handed out by a
+ * Gio::ListModel
+ */
+class CardObject : public Glib::Object {
+public:
+    static Glib::RefPtr<CardObject> create(const std::shared_ptr<Card>& card);
+
+    const std::shared_ptr<Card>& card() const;
+
+protected:
+    CardObject(const std::shared_ptr<Card>& card);
+
+    std::shared_ptr<Card> m_card;
+};
+
+/**
+ * @brief Gio::ListModel adapter over the cards of a CardList.
+ *
+ * @details The model mirrors the cardlist container and follows its append,
+ * insert, remove, reorder and move signals, so list views built on top of it
+ * only create widgets for the rows that are actually visible. The position of
+ * every card is indexed, so looking a card up does not depend on the length
+ * of the list.
+ */
+class CardListModel : public Glib::Object, public Gio::ListModel {
+public:
+    static Glib::RefPtr<CardListModel> create(
+        const std::shared_ptr<CardList>& cardlist);
+
+    /**
+     * @brief Returns the card at the given position, or nullptr if the
+     * position is out of range
+     */
+    std::shared_ptr<Card> get_card(guint position) const;
+
+    /**
+     * @brief Returns the position of the card in the model, or -1 if the card
+     * is not part of it
+     */
+    ssize_t find(const std::shared_ptr<Card>& card) const;
+
+    guint size() const;
+
+protected:
+    CardListModel(const std::shared_ptr<CardList>& cardlist);
+
+    GType get_item_type_vfunc() override;
+    guint get_n_items_vfunc() override;
+    gpointer get_item_vfunc(guint position) override;
+
+    void on_append(std::shared_ptr<Card> card);
+    void on_insert(std::shared_ptr<Card> card, ssize_t index);
+    void on_remove(std::shared_ptr<Card> card);
+    void on_reorder(std::shared_ptr<Card> next, std::shared_ptr<Card> sibling,
+                    ReorderingType type);
+    void on_move(std::shared_ptr<Card> card, ItemContainer<Card>* from,
+                 ssize_t from_index, ItemContainer<Card>* to,
+                 ssize_t to_index);
+
+    std::shared_ptr<CardList> m_cardlist;
+    std::vector<Glib::RefPtr<CardObject>> m_items;
+    PositionIndex<Card*> m_positions;
+    std::vector<sigc::scoped_connection> m_cnns;
+};
+}  // namespace ui
@@ -5,9 +5,12 @@
 #include <spdlog/spdlog.h>
 #include <window.h>
 
+#include <functional>
 #include <unordered_map>
 
 #include "cardlist-widget.h"
+#include "cover-paintable.h"
+#include "gtkmm/version.h"
 
 extern "C" {
 static void card_class_init(void* g_class, void* data) {
@@ -96,17 +99,7 @@ const std::unordered_map<CoverColor, Gdk::RGBA> CardWidget::CARD_COLORS = {
     {CoverColor::BLUE, Gdk::RGBA{"rgb(26, 95, 180)"}},
     {CoverColor::PURPLE, Gdk::RGBA{"rgb(32, 9, 65)"}}};
 
-std::map<CardWidget*, std::vector<CardWidget::CardPopover*>>
-    CardWidget::CardPopover::registered_card_popovers{};
-
-CardWidget::CardPopover::CardPopover(CardWidget* card_widget)
-    : Gtk::PopoverMenu{}, m_card_widget{card_widget} {
-    if (!registered_card_popovers.contains(card_widget)) {
-        registered_card_popovers[card_widget] = std::vector<CardPopover*>{this};
-    } else {
-        registered_card_popovers[card_widget].push_back(this);
-    }
-
+CardPopover::CardPopover() : Gtk::PopoverMenu{} {
     set_has_arrow(false);
     set_position(Gtk::PositionType::BOTTOM);
 
@@ -115,18 +108,23 @@ CardWidget::CardPopover::CardPopover(CardWidget* card_widget)
 
     const std::array<ButtonAction, 3> button_actions = {
         ButtonAction{"rename", _("Rename"),
-                     [this, card_widget] {
-                         card_widget->on_rename();
+                     [this] {
+                         if (m_card_widget) m_card_widget->on_rename();
                          this->popdown();
                      }},
         ButtonAction{"card-details", _("Card Details"),
-                     [this, card_widget] {
-                         card_widget->open_card_dialog();
+                     [this] {
+                         if (m_card_widget) m_card_widget->open_card_dialog();
                          this->popdown();
                      }},
-        ButtonAction{"remove", _("Remove"), [this, card_widget] {
+        ButtonAction{"remove", _("Remove"), [this] {
                          this->popdown();
-                         card_widget->remove_from_parent();
+
+                         // The card may be destroyed along with the popover's
+                         // parent
+                         CardWidget* card_widget = m_card_widget;
+                         detach();
+                         if (card_widget) card_widget->remove_from_parent();
                      }}};
 
     auto menu_model = Gio::Menu::create();
@@ -149,13 +147,13 @@ CardWidget::CardPopover::CardPopover(CardWidget* card_widget)
 
     Gtk::CheckButton* prev = nullptr;
 
-    for (const auto& [color_id, color] : CARD_COLORS) {
+    for (const auto& [color_id, color] : CardWidget::CARD_COLORS) {
         auto checkbutton = Gtk::make_managed<Gtk::CheckButton>();
 
         checkbutton->set_tooltip_text(label_for_color(color_id));
         sigc::connection color_setting_cnn =
             checkbutton->signal_toggled().connect(
-                color_setting_thunk(card_widget, checkbutton, color_id));
+                color_setting_thunk(checkbutton, color_id));
         if (color_id != CoverColor::UNSET) {
             checkbutton->add_css_class(cover_color_css(color_id));
             checkbutton->add_css_class("accent-color-btn");
@@ -176,15 +174,42 @@ CardWidget::CardPopover::CardPopover(CardWidget* card_widget)
     add_child(*frame, "colors");
 }
 
-CardWidget::CardPopover::~CardPopover() {
-    std::erase(registered_card_popovers[m_card_widget], this);
-    if (registered_card_popovers[m_card_widget].empty()) {
-        registered_card_popovers.erase(m_card_widget);
+CardPopover::~CardPopover() { detach(); }
+
+void CardPopover::attach(CardWidget& card, Gtk::MenuButton* menu_button) {
+    if (m_card_widget == &card && get_parent() &&
+        get_parent() == (menu_button ? static_cast<Gtk::Widget*>(menu_button)
+                                     : &card.popover_parent())) {
+        return;
+    }
+
+    detach();
+    m_card_widget = &card;
+    card.m_card_popover = this;
+    if (menu_button) {
+        menu_button->set_popover(*this);
+    } else {
+        set_parent(card.popover_parent());
+    }
+
+    set_selected_color(rgba_to_cover_color(card.get_cover_color()), false);
+}
+
+void CardPopover::detach() {
+    // Whoever we were attached to may be gone already, in which case GTK has
+    // unparented us
+    if (auto menu_button = dynamic_cast<Gtk::MenuButton*>(get_parent())) {
+        menu_button->unset_popover();
+    } else if (get_parent()) {
+        unparent();
+    }
+    if (m_card_widget) {
+        m_card_widget->m_card_popover = nullptr;
     }
+    m_card_widget = nullptr;
 }
 
-void CardWidget::CardPopover::set_selected_color(CoverColor color,
-                                                 bool trigger) {
+void CardPopover::set_selected_color(CoverColor color, bool trigger) {
     auto color_checkbutton = std::get<0>(m_color_radio_button_map[color]);
     auto checkbutton_cnn = std::get<1>(m_color_radio_button_map[color]);
     if (!trigger) {
@@ -193,22 +218,14 @@ void CardWidget::CardPopover::set_selected_color(CoverColor color,
         checkbutton_cnn.unblock();
     } else {
         color_checkbutton->set_active();
-
-        // Update all related popovers to this popover but do not trigger their
-        // signal
-        for (auto sibling : registered_card_popovers[m_card_widget]) {
-            if (sibling != this) {
-                sibling->set_selected_color(color, false);
-            }
-        }
     }
 }
 
-std::function<void()> CardWidget::CardPopover::color_setting_thunk(
-    CardWidget* card, Gtk::CheckButton* checkbutton, CoverColor color) {
-    return std::function<void()>([card, checkbutton, color]() {
-        if (checkbutton->get_active()) {
-            card->set_cover_color(CARD_COLORS.at(color));
+std::function<void()> CardPopover::color_setting_thunk(
+    Gtk::CheckButton* checkbutton, CoverColor color) {
+    return std::function<void()>([this, checkbutton, color]() {
+        if (checkbutton->get_active() && m_card_widget) {
+            m_card_widget->set_cover_color(CardWidget::CARD_COLORS.at(color));
         }
     });
 }
@@ -225,40 +242,140 @@ const std::array<std::string, 3> CardWidget::TASKS_LABEL_CSS_CLASSES = {
     "complete-tasks-indicator-incomplete",
 };
 
-// TODO: There is still work to be done
-// * Re-invent popovers implementation
+const std::array<CardWidget::Shortcut, 9> CardWidget::SHORTCUTS = {
+    {{"<Control>N",
+      [](CardWidget& card) {
+          auto card_widget = card.m_parent->add_card(_("New Card"), &card);
+          if (card_widget) {
+              card_widget->grab_focus();
+          }
+          return true;
+      }},
+     {"<Control>D",
+      [](CardWidget& card) {
+          card.open_card_dialog();
+          return true;
+      }},
+     {"<Control>R",
+      [](CardWidget& card) {
+          card.on_rename();
+          return true;
+      }},
+     {"<Control>Delete",
+      [](CardWidget& card) {
+          card.remove_from_parent();
+          return true;
+      }},
+     {"<Control>Up",
+      [](CardWidget& card) {
+          CardWidget* previous_card = card.m_parent->prev_card(card);
+          if (previous_card) {
+              card.m_parent->reorder(*previous_card, card);
+          } else {
+              card.error_bell();
+          }
+          return true;
+      }},
+     {"<Control>Down",
+      [](CardWidget& card) {
+          CardWidget* next_card = card.m_parent->next_card(card);
+          if (next_card) {
+              card.m_parent->reorder(card, *next_card);
+          } else {
+              card.error_bell();
+          }
+          return true;
+      }},
+     {"<Control>Left",
+      [](CardWidget& card) {
+          CardlistWidget* prev_parent = static_cast<CardlistWidget*>(
+              card.m_parent->get_prev_sibling());
+          if (prev_parent) {
+              prev_parent->receive(card);
+          } else {
+              card.error_bell();
+          }
+          return true;
+      }},
+     {"<Control>Right",
+      [](CardWidget& card) {
+          Widget* next_parent = card.m_parent->get_next_sibling();
+          if (!G_TYPE_CHECK_INSTANCE_TYPE(next_parent->gobj(),
+                                          Gtk::Button::get_type())) {
+              static_cast<CardlistWidget*>(next_parent)->receive(card);
+          } else {
+              card.error_bell();
+          }
+          return true;
+      }},
+     {"Menu|<Shift>F10", [](CardWidget& card) {
+          card.popup_card_popover(
+              Gdk::Rectangle(0, 0, card.get_width(), card.get_height()));
+          return true;
+      }}}};
+
+namespace {
+CardRenderMode card_render_mode = CardRenderMode::WIDGETS;
+
+// Metrics of drawn cards, matching the widget tree's margins and spacings
+constexpr int CARD_WIDTH = 240;
+constexpr int DRAWN_MARGIN = 4;
+constexpr int DRAWN_SPACING = 4;
+constexpr int DRAWN_INFO_SPACING = 8;
+constexpr int DRAWN_PILL_PADDING = 4;
+constexpr int DRAWN_PILL_RADIUS = 4;
+constexpr int DRAWN_ICON_SIZE = 16;
+
+void snapshot_translated(const Glib::RefPtr<Gtk::Snapshot>& snapshot, int x,
+                         int y, const std::function<void()>& append) {
+    graphene_point_t offset = GRAPHENE_POINT_INIT(float(x), float(y));
+    snapshot->save();
+    gtk_snapshot_translate(snapshot->gobj(), &offset);
+    append();
+    snapshot->restore();
+}
+
+void append_rounded_color(const Glib::RefPtr<Gtk::Snapshot>& snapshot,
+                          const Gdk::RGBA& color, const Gdk::Rectangle& area,
+                          float radius) {
+    graphene_rect_t bounds = GRAPHENE_RECT_INIT(
+        float(area.get_x()), float(area.get_y()), float(area.get_width()),
+        float(area.get_height()));
+    GskRoundedRect outline;
+    gsk_rounded_rect_init_from_rect(&outline, &bounds, radius);
+
+    gtk_snapshot_push_rounded_clip(snapshot->gobj(), &outline);
+    snapshot->append_color(color, area);
+    snapshot->pop();
+}
+
+Glib::RefPtr<Gtk::IconPaintable> notes_icon(Gtk::Widget& widget) {
+    static Glib::RefPtr<Gtk::IconPaintable> icon;
+    static int icon_scale = 0;
+    if (!icon || icon_scale != widget.get_scale_factor()) {
+        icon_scale = widget.get_scale_factor();
+        icon = Gtk::IconTheme::get_for_display(widget.get_display())
+                   ->lookup_icon("document-text-symbolic", DRAWN_ICON_SIZE,
+                                 icon_scale);
+    }
+    return icon;
+}
+}  // namespace
+
 CardWidget::CardWidget(const std::string& title, Gdk::RGBA cover_color,
                        Glib::Date deadline, bool complete, bool show_notes_icon,
                        int n_tasks, int n_tasks_complete)
     : Glib::ObjectBase{"CardWidget"},
       CardInit{},
       BaseItem{Gtk::Orientation::VERTICAL, 0},
-      m_parent{nullptr},
-      m_root{Gtk::Orientation::VERTICAL},
-      m_card_cover_revealer{},
-      m_card_entry_revealer{},
-      m_card_cover_picture{},
-      m_card_label{},
-      m_completion_label{},
-      m_deadline_label{},
-      m_card_entry{},
-      m_card_menu_button{},
-      m_fixed_card_popover{this},
-      m_mouse_card_popover{this},
-      m_key_ctrl{Gtk::EventControllerKey::create()},
-      m_click_ctrl{Gtk::GestureClick::create()},
-      m_focus_ctrl{Gtk::EventControllerFocus::create()},
-      m_complete{complete} {
-    setup_widgets();
+      m_complete{complete},
+      m_parent{nullptr} {
+    set_render_mode(default_render_mode());
 
     // CardWidget Setup
     set_title(title);
     if (cover_color != Gdk::RGBA{}) {
         __set_cover_color(cover_color);
-        m_fixed_card_popover.set_selected_color(
-            rgba_to_cover_color(cover_color), false);
-        m_mouse_card_popover.set_selected_color(
-            rgba_to_cover_color(cover_color), false);
     }
 
     if (deadline.valid()) {
@@ -270,152 +387,94 @@ CardWidget::CardWidget(const std::string& title, Gdk::RGBA cover_color,
     }
 
     if (show_notes_icon) {
-        m_notes_icon.set_visible();
+        set_notes_icon_visible();
+    }
+}
+
+CardWidget::~CardWidget() { release_card_popover(); }
+
+void CardWidget::set_default_render_mode(CardRenderMode mode) {
+    card_render_mode = mode;
+}
+
+CardRenderMode CardWidget::default_render_mode() { return card_render_mode; }
+
+void CardWidget::reset(const std::string& title, Gdk::RGBA cover_color,
+                       Glib::Date deadline, bool complete, bool show_notes_icon,
+                       int n_tasks, int n_tasks_complete) {
+    release_card_popover();
+    set_render_mode(default_render_mode());
+    off_rename();
+    m_title = title;
+    display_title();
+
+    if (cover_color != Gdk::RGBA{}) {
+        __set_cover_color(cover_color);
+    } else {
+        __clear_cover_color();
     }
 
-    m_focus_ctrl->signal_leave().connect(
-        sigc::mem_fun(*this, &CardWidget::off_rename));
-    m_card_entry.add_controller(m_focus_ctrl);
+    m_date = Glib::Date{};
+    set_deadline_label(deadline, complete);
 
-    m_card_cover_revealer.property_child_revealed().signal_changed().connect(
-        [this]() {
-            if (!m_card_cover_revealer.get_child_revealed())
-                this->m_card_cover_picture.set_paintable(nullptr);
-        });
+    if (n_tasks > 0 && n_tasks_complete <= n_tasks) {
+        set_completion_label(n_tasks, n_tasks_complete);
+    } else {
+        set_completion_label(0, 0);
+    }
 
-    m_deadline_label.property_label().signal_changed().connect(
-        sigc::mem_fun(*this, &CardWidget::update_deadline_label));
+    set_notes_icon_visible(show_notes_icon);
+}
 
-    using CardShortcut =
-        std::pair<const char*,
-                  std::function<bool(Gtk::Widget&, const Glib::VariantBase&)>>;
+void CardWidget::set_render_mode(CardRenderMode mode) {
+    if (m_widgets || m_title_layout) {
+        if (mode == get_render_mode()) return;
+        off_rename();
 
-    const std::array<CardShortcut, 9> card_shortcuts = {
-        {{"<Control>N",
-          [this](Gtk::Widget&, const Glib::VariantBase&) {
-              auto card_widget = Gtk::make_managed<CardWidget>(_("New Card"));
-              m_parent->insert_after(*card_widget, *this);
-              card_widget->grab_focus();
-              return true;
-          }},
-         {"<Control>D",
-          [this](Gtk::Widget&, const Glib::VariantBase&) {
-              this->open_card_dialog();
-              return true;
-          }},
-         {"<Control>R",
-          [this](Gtk::Widget&, const Glib::VariantBase&) {
-              this->on_rename();
-              return true;
-          }},
-         {"<Control>Delete",
-          [this](Gtk::Widget&, const Glib::VariantBase&) {
-              this->remove_from_parent();
-              return true;
-          }},
-         {"<Control>Up",
-          [this](Gtk::Widget&, const Glib::VariantBase&) {
-              CardWidget* previous_card =
-                  static_cast<CardWidget*>(this->get_prev_sibling());
-              if (previous_card) {
-                  this->m_parent->reorder(*previous_card, *this);
-              } else {
-                  this->error_bell();
-              }
-              return true;
-          }},
-         {"<Control>Down",
-          [this](Gtk::Widget&, const Glib::VariantBase&) {
-              Widget* next = this->get_next_sibling();
-              if (!G_TYPE_CHECK_INSTANCE_TYPE(next->gobj(),
-                                              Gtk::Button::get_type())) {
-                  this->m_parent->reorder(*this,
-                                          *static_cast<CardWidget*>(next));
-              } else {
-                  this->error_bell();
-              }
-              return true;
-          }},
-         {"<Control>Left",
-          [this](Gtk::Widget&, const Glib::VariantBase&) {
-              CardlistWidget* prev_parent = static_cast<CardlistWidget*>(
-                  this->m_parent->get_prev_sibling());
-              if (prev_parent) {
-                  prev_parent->receive(*this);
-              } else {
-                  this->error_bell();
-              }
-              return true;
-          }},
-         {"<Control>Right",
-          [this](Gtk::Widget&, const Glib::VariantBase&) {
-              Widget* next_parent = this->m_parent->get_next_sibling();
-              if (!G_TYPE_CHECK_INSTANCE_TYPE(next_parent->gobj(),
-                                              Gtk::Button::get_type())) {
-                  static_cast<CardlistWidget*>(next_parent)->receive(*this);
-              } else {
-                  this->error_bell();
-              }
-              return true;
-          }},
-         {"Menu|<Shift>F10", [this](Gtk::Widget& m, const Glib::VariantBase&) {
-              this->m_mouse_card_popover.popup();
-              return true;
-          }}}};
-
-    auto shortcut_controller = Gtk::ShortcutController::create();
-    shortcut_controller->set_scope(Gtk::ShortcutScope::LOCAL);
-
-    for (const auto& [keybinding, callback] : card_shortcuts) {
-        shortcut_controller->add_shortcut(Gtk::Shortcut::create(
-            Gtk::ShortcutTrigger::parse_string(keybinding),
-            Gtk::CallbackAction::create(callback)));
-    }
-    this->add_controller(shortcut_controller);
-
-    m_key_ctrl->signal_key_released().connect(
-        [this](guint keyval, guint keycode, Gdk::ModifierType state) {
-            if (m_card_entry_revealer.get_child_revealed()) {
-                switch (keyval) {
-                    case GDK_KEY_Return:
-                    case GDK_KEY_KP_Enter: {
-                        this->on_confirm_changes();
-                        this->off_rename();
-                        break;
-                    }
-                    case GDK_KEY_Escape: {
-                        this->off_rename();
-                        break;
-                    }
-                }
-            }
-        });
+        // The popover may be parented to widgets about to be replaced
+        release_card_popover();
+    }
 
-    m_click_ctrl->set_button(0);
-    m_click_ctrl->signal_released().connect(
-        [this](int n_pressed, double x, double y) {
-            auto clicked = this->m_click_ctrl->get_current_button();
-            if (clicked == GDK_BUTTON_SECONDARY && n_pressed >= 1) {
-                this->m_mouse_card_popover.set_pointing_to(
-                    Gdk::Rectangle(x, y, 0, 0));
-                this->m_mouse_card_popover.popup();
-            } else if (n_pressed >= 1 &&
-                       !m_card_entry_revealer.get_child_revealed() &&
-                       clicked == GDK_BUTTON_PRIMARY) {
-                this->on_rename();
-            }
-        });
+    if (mode == CardRenderMode::WIDGETS) {
+        if (m_rename_entry) {
+            m_rename_entry->unparent();
+            m_rename_entry.reset();
+        }
+        m_title_layout.reset();
+        m_completion_layout.reset();
+        m_deadline_layout.reset();
+
+        set_layout_manager(Gtk::BoxLayout::create(Gtk::Orientation::VERTICAL));
+        m_widgets = std::make_unique<WidgetTree>();
+        setup_widgets();
+    } else {
+        if (m_widgets) {
+            m_widgets->root.unparent();
+            m_widgets.reset();
+        }
+
+        // Without a layout manager, measuring and allocating is left to our
+        // own vfuncs
+        set_layout_manager({});
+        setup_layouts();
+    }
 
-    m_card_entry.add_controller(m_key_ctrl);
-    add_controller(m_click_ctrl);
-    setup_drag_and_drop();
+    display_title();
+    display_cover();
+    display_deadline();
+    display_completion();
+    set_notes_icon_visible(m_show_notes_icon);
+}
+
+CardRenderMode CardWidget::get_render_mode() const {
+    return m_widgets ? CardRenderMode::WIDGETS : CardRenderMode::DRAWN;
 }
 
 void CardWidget::set_title(const std::string& label) {
-    const std::string old_name = m_card_label.get_label();
+    const std::string old_name = m_title;
 
-    m_card_label.set_label(label);
-    m_card_entry.set_text(label);
+    m_title = label;
+    display_title();
 
     m_name_changed_signal.emit(old_name, label);
 }
@@ -426,6 +485,14 @@ void CardWidget::set_cardlist(CardlistWidget* new_parent) {
     }
 }
 
+void CardWidget::detach() { m_parent = nullptr; }
+
+void CardWidget::release_card_popover() {
+    if (m_card_popover) {
+        m_card_popover->detach();
+    }
+}
+
 void CardWidget::set_cover_color(Gdk::RGBA color) {
     const Gdk::RGBA old_color = m_color;
 
@@ -440,31 +507,29 @@ void CardWidget::set_cover_color(Gdk::RGBA color) {
 
 void CardWidget::set_deadline_label(const Glib::Date& new_date, bool complete) {
     if (new_date.valid()) {
-        m_deadline_label.set_visible();
-        m_deadline_label.set_label(_("Due: ") +
-                                   new_date.format_string("%d %b, %Y"));
+        m_deadline_text = _("Due: ") + new_date.format_string("%d %b, %Y");
         m_date = new_date;
         m_complete = complete;
-        update_deadline_label();
     } else {
-        m_deadline_label.set_visible(false);
+        m_deadline_text.clear();
         m_complete = false;
     }
+    display_deadline();
 }
 
 void CardWidget::set_completion_label(int n_tasks, int n_tasks_complete) {
-    if (n_tasks) {
-        m_completion_label.set_visible(true);
-        m_completion_label.set_label(
-            std::format("{}/{}", n_tasks_complete, n_tasks));
-        update_completion_label(n_tasks, n_tasks_complete);
-    } else {
-        m_completion_label.set_visible(false);
-    }
+    m_n_tasks = n_tasks;
+    m_n_tasks_complete = n_tasks_complete;
+    display_completion();
 }
 
 void CardWidget::set_notes_icon_visible(bool visible) {
-    m_notes_icon.set_visible(visible);
+    m_show_notes_icon = visible;
+    if (m_widgets) {
+        m_widgets->notes_icon.set_visible(visible);
+    } else {
+        queue_resize();
+    }
 }
 
 void CardWidget::set_complete(bool complete) {
@@ -489,17 +554,24 @@ void CardWidget::update_deadline_label() {
     else
         css_class = "due-date";
 
+    m_deadline_css = css_class;
+    if (!m_widgets) {
+        queue_draw();
+        return;
+    }
+
+    Gtk::Label& deadline_label = m_widgets->deadline_label;
     for (const auto& css : DATE_LABEL_CSS_CLASSES) {
-        if (m_deadline_label.has_css_class(css)) {
+        if (deadline_label.has_css_class(css)) {
             if (css_class == css) return;  // Has already been set
 
-            m_deadline_label.remove_css_class(css);
+            deadline_label.remove_css_class(css);
         }
     }
-    m_deadline_label.add_css_class(css_class);
+    deadline_label.add_css_class(css_class);
 }
 
-std::string CardWidget::get_title() const { return m_card_label.get_label(); }
+std::string CardWidget::get_title() const { return m_title; }
 
 Gdk::RGBA CardWidget::get_cover_color() const { return m_color; }
 
@@ -523,86 +595,47 @@ CardWidget::signal_card_received() {
     return m_card_received_signal;
 }
 
-void CardWidget::setup_drag_and_drop() {
-    // DragSource Settings
-    auto drag_source_c = Gtk::DragSource::create();
-    drag_source_c->set_actions(Gdk::DragAction::MOVE);
-    drag_source_c->signal_prepare().connect(
-        [this, drag_source_c](double x, double y) {
-            Glib::Value<CardWidget*> value_new_cardptr;
-            value_new_cardptr.init(Glib::Value<CardWidget*>::value_type());
-            value_new_cardptr.set(this);
-            auto card_icon = Gtk::WidgetPaintable::create(*this);
-            drag_source_c->set_icon(card_icon, x, y);
-
-            return Gdk::ContentProvider::create(value_new_cardptr);
-        },
-        false);
-    drag_source_c->signal_drag_begin().connect(
-        [this](const Glib::RefPtr<Gdk::Drag>& drag_ref) {
-            this->m_parent->board.set_scroll();
-        },
-        false);
-    drag_source_c->signal_drag_cancel().connect(
-        [this](const Glib::RefPtr<Gdk::Drag>& drag_ref,
-               Gdk::DragCancelReason reason) {
-            this->m_parent->board.set_scroll(false);
+bool CardWidget::on_rename_key(guint keyval) {
+    if (!is_renaming()) {
+        return false;
+    }
+
+    switch (keyval) {
+        case GDK_KEY_Return:
+        case GDK_KEY_KP_Enter: {
+            this->on_confirm_changes();
+            this->off_rename();
             return true;
-        },
-        false);
-    drag_source_c->signal_drag_end().connect(
-        [this](const Glib::RefPtr<Gdk::Drag>& drag_ref, bool s) {
-            this->m_parent->board.set_scroll(false);
-        });
-    add_controller(drag_source_c);
-
-    // DropTarget Settings
-    auto drop_target_c = Gtk::DropTarget::create(
-        Glib::Value<CardWidget*>::value_type(), Gdk::DragAction::MOVE);
-    drop_target_c->signal_drop().connect(
-        [this](const Glib::ValueBase& value, double x, double y) {
-            this->m_parent->board.set_scroll(false);
-            if (G_VALUE_HOLDS(value.gobj(),
-                              Glib::Value<CardWidget*>::value_type())) {
-                Glib::Value<CardWidget*> dropped_value;
-                dropped_value.init(value.gobj());
-                auto dropped_card_widget = dropped_value.get();
-
-                if (dropped_card_widget == this) {
-                    spdlog::warn(
-                        "[CardWidget.dnd] (\"{}\") has been dropped on "
-                        "itself",
-                        get_title());
-                    return true;
-                }
-
-                if (dropped_card_widget->parent() == this->m_parent) {
-                    this->m_parent->reorder(*dropped_card_widget, *this);
-                } else {
-                    // auto dropped_parent = dropped_card_widget->parent();
-                    // dropped_card_widget->reference();
-
-                    // dropped_parent->signal_card_removed().block();
-                    // dropped_parent->remove(*dropped_card_widget);
-                    // dropped_parent->signal_card_removed().unblock();
-
-                    // m_parent->signal_card_added().block();
-                    // m_parent->insert_after(*dropped_card_widget, *this);
-                    // m_parent->signal_card_added().unblock();
-                    // m_card_received_signal.emit(dropped_card_widget,
-                    //                             dropped_parent);
-
-                    // dropped_card_widget->set_cardlist(this->m_parent);
-
-                    this->m_parent->receive_after(*dropped_card_widget, *this);
-                }
-
-                return true;
-            }
-            return false;
-        },
-        false);
-    add_controller(drop_target_c);
+        }
+        case GDK_KEY_Escape: {
+            this->off_rename();
+            return true;
+        }
+    }
+    return false;
+}
+
+void CardWidget::on_click(guint button, int n_pressed, double x, double y) {
+    if (button == GDK_BUTTON_SECONDARY && n_pressed >= 1) {
+        this->popup_card_popover(Gdk::Rectangle(x, y, 0, 0));
+    } else if (n_pressed >= 1 && !is_renaming() &&
+               button == GDK_BUTTON_PRIMARY) {
+        this->on_rename();
+    }
+}
+
+void CardWidget::on_card_dropped(CardWidget& dropped_card_widget) {
+    if (&dropped_card_widget == this) {
+        spdlog::warn("[CardWidget.dnd] (\"{}\") has been dropped on itself",
+                     get_title());
+        return;
+    }
+
+    if (dropped_card_widget.parent() == this->m_parent) {
+        this->m_parent->reorder(dropped_card_widget, *this);
+    } else {
+        this->m_parent->receive_after(dropped_card_widget, *this);
+    }
 }
 
 void CardWidget::open_card_dialog() {
@@ -616,27 +649,118 @@ void CardWidget::open_card_dialog() {
     parent_window.card_dialog().open(parent_window, this);
 }
 
+Gtk::Widget& CardWidget::popover_parent() {
+    if (m_widgets) {
+        return m_widgets->root;
+    }
+    return *this;
+}
+
+Gtk::Entry& CardWidget::rename_entry() {
+    if (m_widgets) {
+        return m_widgets->card_entry;
+    }
+
+    if (!m_rename_entry) {
+        m_rename_entry = std::make_unique<Gtk::Entry>();
+        m_rename_entry->set_parent(*this);
+    }
+    return *m_rename_entry;
+}
+
+bool CardWidget::is_renaming() const {
+    if (m_widgets) {
+        return m_widgets->card_entry_revealer.get_child_revealed();
+    }
+    return m_rename_entry && m_rename_entry->get_visible();
+}
+
+void CardWidget::drop_rename_entry() {
+    if (m_rename_entry && !m_rename_entry->get_visible()) {
+        m_rename_entry->unparent();
+        m_rename_entry.reset();
+    }
+}
+
+CardPopover& CardWidget::card_popover() {
+    return static_cast<ProgressWindow*>(get_root())->card_popover();
+}
+
+void CardWidget::popup_card_popover(const Gdk::Rectangle& pointing_to) {
+    CardPopover& popover = card_popover();
+    popover.attach(*this);
+    popover.set_pointing_to(pointing_to);
+    popover.popup();
+}
+
 void CardWidget::on_rename() {
-    // FIXME: Adding and removing the control focus fixes the bug where we
-    // cannot rename a card through its menu options. Every time the user
-    // (before this workaround) hit the rename button, the card would
-    // quickly enter and leave rename mode, not allowing changes at all.
-    m_card_entry.remove_controller(m_focus_ctrl);
-    m_card_entry_revealer.set_reveal_child(true);
-    m_card_label.set_visible(false);
-    m_card_entry.grab_focus();
-    m_card_entry.add_controller(m_focus_ctrl);
+    Gtk::Entry& entry = rename_entry();
+
+    // The focus controller is only created once the card is first renamed
+    if (!m_focus_ctrl) {
+        m_focus_ctrl = Gtk::EventControllerFocus::create();
+        m_focus_ctrl->signal_leave().connect(
+            sigc::mem_fun(*this, &CardWidget::off_rename));
+    } else if (m_focus_ctrl->get_widget()) {
+        // FIXME: Adding and removing the control focus fixes the bug where we
+        // cannot rename a card through its menu options. Every time the user
+        // (before this workaround) hit the rename button, the card would
+        // quickly enter and leave rename mode, not allowing changes at all.
+        m_focus_ctrl->get_widget()->remove_controller(m_focus_ctrl);
+    }
+
+    if (m_widgets) {
+        m_widgets->card_entry_revealer.set_reveal_child(true);
+        m_widgets->card_label.set_visible(false);
+    } else {
+        entry.set_text(m_title);
+        entry.set_visible();
+        queue_resize();
+    }
+    entry.grab_focus();
+    entry.add_controller(m_focus_ctrl);
 }
 
 void CardWidget::off_rename() {
-    m_card_label.set_visible();
-    m_card_entry_revealer.set_reveal_child(false);
+    if (m_widgets) {
+        m_widgets->card_label.set_visible();
+        m_widgets->card_entry_revealer.set_reveal_child(false);
+        return;
+    }
+
+    if (!is_renaming()) {
+        return;
+    }
+
+    // Keep the keyboard focus on the card when renaming is confirmed or
+    // cancelled from the entry
+    auto root = get_root();
+    Gtk::Widget* focus = root ? root->get_focus() : nullptr;
+    if (focus && (focus == m_rename_entry.get() ||
+                  focus->is_ancestor(*m_rename_entry))) {
+        grab_focus();
+    }
+
+    m_rename_entry->set_visible(false);
+    queue_resize();
+
+    // This may run from the entry's own focus controller, so the entry is only
+    // destroyed once the event has been handled
+    Glib::signal_idle().connect_once(
+        sigc::mem_fun(*this, &CardWidget::drop_rename_entry));
 }
 
 void CardWidget::on_confirm_changes() {
-    if (m_card_entry.get_text().compare(m_card_label.get_label()) != 0) {
+    const Gtk::Entry* entry =
+        m_widgets ? &m_widgets->card_entry : m_rename_entry.get();
+    if (!entry) {
+        return;
+    }
+
+    if (entry->get_text().compare(m_title) != 0) {
         const std::string old = get_title();
-        m_card_label.set_label(m_card_entry.get_text());
+        m_title = entry->get_text();
+        display_title();
 
         m_name_changed_signal.emit(old, get_title());
     }
@@ -654,60 +778,322 @@ void CardWidget::update_completion_label(int n_tasks, int n_tasks_complete) {
         css_class = "complete-tasks-indicator-almost";
     }
 
-    if (m_completion_label.has_css_class(css_class)) {
+    m_completion_css = css_class;
+    if (!m_widgets) {
+        queue_draw();
+        return;
+    }
+
+    Gtk::Label& completion_label = m_widgets->completion_label;
+    if (completion_label.has_css_class(css_class)) {
         return;
     }
 
     for (const auto& css : TASKS_LABEL_CSS_CLASSES) {
-        if (m_completion_label.has_css_class(css)) {
-            m_completion_label.remove_css_class(css);
+        if (completion_label.has_css_class(css)) {
+            completion_label.remove_css_class(css);
         }
     }
 
-    m_completion_label.add_css_class(css_class);
+    completion_label.add_css_class(css_class);
 }
 
 void CardWidget::__set_cover_color(const Gdk::RGBA& color) {
-    auto color_frame_pixbuf = Gdk::Pixbuf::create(
-        Gdk::Colorspace::RGB, false, 8, CardlistWidget::CARDLIST_MAX_WIDTH, 30);
-    color_frame_pixbuf->fill(
-        (((unsigned char)(color.get_red() * 255.0)) << 24) |
-        (((unsigned char)(color.get_green() * 255.0)) << 16) |
-        (((unsigned char)(color.get_blue() * 255.0)) << 8) |
-        ((unsigned char)(color.get_alpha())));
-
-    m_card_cover_picture.set_paintable(
-        Gdk::Texture::create_for_pixbuf(color_frame_pixbuf));
-    m_card_cover_revealer.set_reveal_child(true);
-
     m_color = color;
+    display_cover();
 }
 
 void CardWidget::__clear_cover_color() {
-    m_card_cover_revealer.set_reveal_child(false);
-    m_card_cover_picture.set_paintable(nullptr);
-
     m_color = Gdk::RGBA{};
+    display_cover();
+}
+
+void CardWidget::display_title() {
+    if (m_widgets) {
+        m_widgets->card_label.set_label(m_title);
+        m_widgets->card_entry.set_text(m_title);
+    } else {
+        m_title_layout->set_text(m_title);
+        queue_resize();
+    }
+}
+
+void CardWidget::display_cover() {
+    if (!m_widgets) {
+        queue_resize();
+        return;
+    }
+
+    if (m_color != Gdk::RGBA{}) {
+        m_widgets->card_cover_picture.set_paintable(
+            CoverPaintable::get(m_color));
+        m_widgets->card_cover_revealer.set_reveal_child(true);
+    } else {
+        m_widgets->card_cover_revealer.set_reveal_child(false);
+        m_widgets->card_cover_picture.set_paintable(nullptr);
+    }
+}
+
+void CardWidget::display_deadline() {
+    if (m_widgets) {
+        m_widgets->deadline_label.set_visible(!m_deadline_text.empty());
+        if (!m_deadline_text.empty()) {
+            m_widgets->deadline_label.set_label(m_deadline_text);
+        }
+    } else {
+        m_deadline_layout->set_text(m_deadline_text);
+        queue_resize();
+    }
+
+    if (!m_deadline_text.empty()) {
+        update_deadline_label();
+    }
+}
+
+void CardWidget::display_completion() {
+    if (m_widgets) {
+        m_widgets->completion_label.set_visible(m_n_tasks);
+        if (m_n_tasks) {
+            m_widgets->completion_label.set_label(
+                std::format("{}/{}", m_n_tasks_complete, m_n_tasks));
+        }
+    } else {
+        m_completion_layout->set_text(
+            m_n_tasks ? std::format("{}/{}", m_n_tasks_complete, m_n_tasks)
+                      : "");
+        queue_resize();
+    }
+
+    if (m_n_tasks) {
+        update_completion_label(m_n_tasks, m_n_tasks_complete);
+    }
+}
+
+void CardWidget::cleanup() {
+    if (m_widgets) {
+        m_widgets->root.unparent();
+    }
+    if (m_rename_entry) {
+        m_rename_entry->unparent();
+    }
 }
 
-void CardWidget::cleanup() { m_root.unparent(); }
+CardWidget::DrawnGeometry CardWidget::drawn_geometry(int width) const {
+    DrawnGeometry geometry;
+    int y = DRAWN_MARGIN;
+    if (m_color != Gdk::RGBA{}) {
+        y += CoverPaintable::COVER_HEIGHT + DRAWN_SPACING;
+    }
+
+    const int text_width = std::max(width - 2 * DRAWN_MARGIN, 1);
+    m_title_layout->set_width(text_width * PANGO_SCALE);
+    int title_width, title_height;
+    m_title_layout->get_pixel_size(title_width, title_height);
+
+    if (is_renaming()) {
+        int minimum, natural, ignore;
+        m_rename_entry->measure(Gtk::Orientation::VERTICAL, text_width,
+                                minimum, natural, ignore, ignore);
+        title_height = std::max(title_height, natural);
+    }
+    geometry.title = Gdk::Rectangle{DRAWN_MARGIN, y, text_width, title_height};
+    y += title_height;
+
+    if (m_n_tasks || !m_deadline_text.empty() || m_show_notes_icon) {
+        int info_width, text_height;
+        m_completion_layout->get_pixel_size(info_width, text_height);
+        y += DRAWN_SPACING;
+        geometry.info_y = y;
+        geometry.info_height =
+            std::max(text_height, DRAWN_ICON_SIZE) + 2 * DRAWN_PILL_PADDING;
+        y += geometry.info_height;
+    }
+
+    geometry.height = y + DRAWN_MARGIN;
+    return geometry;
+}
+
+Gdk::RGBA CardWidget::info_color(const std::string& css_class) {
+    // Named colors used by the info labels' style classes in style.css, and
+    // the Adwaita values used if they cannot be looked up
+    static const std::unordered_map<std::string,
+                                    std::pair<const char*, const char*>>
+        INFO_COLORS = {
+            {"due-date", {"insensitive_bg_color", "rgba(128, 128, 128, 0.2)"}},
+            {"notes-icon",
+             {"insensitive_bg_color", "rgba(128, 128, 128, 0.2)"}},
+            {"past-due-date", {"error_color", "rgb(192, 28, 40)"}},
+            {"due-date-complete", {"success_color", "rgb(38, 162, 105)"}},
+            {"complete-tasks-indicator-complete",
+             {"success_color", "rgb(38, 162, 105)"}},
+            {"complete-tasks-indicator-almost",
+             {"warning_color", "rgb(229, 165, 10)"}},
+            {"complete-tasks-indicator-incomplete",
+             {"error_color", "rgb(192, 28, 40)"}}};
+
+    auto it = INFO_COLORS.find(css_class);
+    if (it == INFO_COLORS.end()) {
+        return Gdk::RGBA{};
+    }
+
+    const auto& [name, fallback] = it->second;
+    Gdk::RGBA color;
+    G_GNUC_BEGIN_IGNORE_DEPRECATIONS
+    if (get_style_context()->lookup_color(name, color)) {
+        return color;
+    }
+    G_GNUC_END_IGNORE_DEPRECATIONS
+    return Gdk::RGBA{fallback};
+}
+
+void CardWidget::measure_vfunc(Gtk::Orientation orientation, int for_size,
+                               int& minimum, int& natural,
+                               int& minimum_baseline,
+                               int& natural_baseline) const {
+    if (m_widgets) {
+        BaseItem::measure_vfunc(orientation, for_size, minimum, natural,
+                                minimum_baseline, natural_baseline);
+        return;
+    }
+
+    minimum_baseline = -1;
+    natural_baseline = -1;
+    if (orientation == Gtk::Orientation::HORIZONTAL) {
+        minimum = natural = CARD_WIDTH;
+    } else {
+        minimum = natural =
+            drawn_geometry(for_size > 0 ? for_size : CARD_WIDTH).height;
+    }
+}
+
+void CardWidget::size_allocate_vfunc(int width, int height, int baseline) {
+    if (m_widgets) {
+        BaseItem::size_allocate_vfunc(width, height, baseline);
+        return;
+    }
+
+    // The card popover is parented to drawn cards
+    for (Gtk::Widget* child = get_first_child(); child;
+         child = child->get_next_sibling()) {
+        if (auto popover = dynamic_cast<Gtk::Popover*>(child)) {
+            popover->present();
+        }
+    }
+
+    if (is_renaming()) {
+        const DrawnGeometry geometry = drawn_geometry(width);
+        m_rename_entry->size_allocate(geometry.title, -1);
+    }
+}
+
+void CardWidget::snapshot_vfunc(const Glib::RefPtr<Gtk::Snapshot>& snapshot) {
+    if (m_widgets) {
+        BaseItem::snapshot_vfunc(snapshot);
+        return;
+    }
+
+    const int width = get_width();
+    const DrawnGeometry geometry = drawn_geometry(width);
+#if GTKMM_CHECK_VERSION(4, 10, 0)
+    const Gdk::RGBA text_color = get_color();
+#else
+    G_GNUC_BEGIN_IGNORE_DEPRECATIONS
+    const Gdk::RGBA text_color = get_style_context()->get_color();
+    G_GNUC_END_IGNORE_DEPRECATIONS
+#endif
+
+    if (m_color != Gdk::RGBA{}) {
+        snapshot_translated(snapshot, DRAWN_MARGIN, DRAWN_MARGIN, [&] {
+            CoverPaintable::get(m_color)->snapshot(
+                snapshot, width - 2 * DRAWN_MARGIN,
+                CoverPaintable::COVER_HEIGHT);
+        });
+    }
+
+    if (is_renaming()) {
+        snapshot_child(*m_rename_entry, snapshot);
+    } else {
+        snapshot_translated(
+            snapshot, geometry.title.get_x(), geometry.title.get_y(),
+            [&] { snapshot->append_layout(m_title_layout, text_color); });
+    }
+
+    // Info labels, drawn as pills
+    int x = DRAWN_MARGIN;
+    auto append_pill = [&](int content_width, const std::string& css_class,
+                           std::function<void()> append_content) {
+        const int pill_width = content_width + 2 * DRAWN_PILL_PADDING;
+        append_rounded_color(
+            snapshot, info_color(css_class),
+            Gdk::Rectangle{x, geometry.info_y, pill_width,
+                           geometry.info_height},
+            DRAWN_PILL_RADIUS);
+        snapshot_translated(snapshot, x + DRAWN_PILL_PADDING,
+                            geometry.info_y + DRAWN_PILL_PADDING,
+                            append_content);
+        x += pill_width + DRAWN_INFO_SPACING;
+    };
+
+    for (const auto& [layout, css_class] :
+         {std::pair{m_completion_layout, m_completion_css},
+          std::pair{m_deadline_layout, m_deadline_css}}) {
+        if (layout->get_text().empty()) {
+            continue;
+        }
+
+        int text_width, text_height;
+        layout->get_pixel_size(text_width, text_height);
+        append_pill(text_width, css_class, [&] {
+            snapshot->append_layout(layout, text_color);
+        });
+    }
+
+    if (m_show_notes_icon) {
+        auto icon = notes_icon(*this);
+        append_pill(DRAWN_ICON_SIZE, "notes-icon", [&] {
+#if GTK_CHECK_VERSION(4, 6, 0)
+            GdkRGBA colors[] = {*text_color.gobj()};
+            gtk_symbolic_paintable_snapshot_symbolic(
+                GTK_SYMBOLIC_PAINTABLE(icon->gobj()), snapshot->gobj(),
+                DRAWN_ICON_SIZE, DRAWN_ICON_SIZE, colors, 1);
+#else
+            icon->snapshot(snapshot, DRAWN_ICON_SIZE, DRAWN_ICON_SIZE);
+#endif
+        });
+    }
+}
+
+void CardWidget::setup_layouts() {
+    m_title_layout = create_pango_layout("");
+    m_title_layout->set_wrap(Pango::WrapMode::WORD_CHAR);
+    m_completion_layout = create_pango_layout("");
+    m_deadline_layout = create_pango_layout("");
+}
 
 void CardWidget::setup_widgets() {
-    m_root.set_spacing(4);
-    m_root.set_size_request(240, -1);
+    Gtk::Box& root = m_widgets->root;
+    root.set_spacing(4);
+    root.set_size_request(CARD_WIDTH, -1);
 
     // Card's cover
-    m_root.append(m_card_cover_revealer);
-    m_card_cover_revealer.set_child(m_card_cover_picture);
-    m_card_cover_picture.set_content_fit(Gtk::ContentFit::COVER);
-    m_card_cover_picture.add_css_class("card-cover");
-    m_card_cover_picture.set_size_request(-1, 50);
+    Gtk::Revealer& cover_revealer = m_widgets->card_cover_revealer;
+    Gtk::Picture& cover_picture = m_widgets->card_cover_picture;
+    root.append(cover_revealer);
+    cover_revealer.set_child(cover_picture);
+    cover_picture.set_content_fit(Gtk::ContentFit::COVER);
+    cover_picture.add_css_class("card-cover");
+    cover_picture.set_size_request(-1, 50);
+    cover_revealer.property_child_revealed().signal_changed().connect(
+        [&cover_revealer, &cover_picture]() {
+            if (!cover_revealer.get_child_revealed())
+                cover_picture.set_paintable(nullptr);
+        });
 
     // Card Body
     Gtk::Box& card_body = *Gtk::make_managed<Gtk::Box>();
     card_body.set_margin(4);
     card_body.set_spacing(10);
-    m_root.append(card_body);
+    root.append(card_body);
 
     // inner box
     Gtk::Box& card_data_box =
@@ -715,51 +1101,56 @@ void CardWidget::setup_widgets() {
     card_data_box.set_spacing(4);
     card_data_box.set_valign(Gtk::Align::CENTER);
 
+    Gtk::Label& card_label = m_widgets->card_label;
     Gtk::Box& card_label_box =
         *Gtk::make_managed<Gtk::Box>(Gtk::Orientation::VERTICAL);
-    card_label_box.append(m_card_label);
-    m_card_label.set_halign(Gtk::Align::START);
-    m_card_label.set_hexpand();
-    m_card_label.set_label(Glib::locale_to_utf8(_("New Card")));
-    m_card_label.set_wrap();
-    m_card_label.set_natural_wrap_mode(Gtk::NaturalWrapMode::WORD);
-    m_card_label.set_wrap_mode(Pango::WrapMode::WORD_CHAR);
-
-    card_label_box.append(m_card_entry_revealer);
-    m_card_entry_revealer.set_child(m_card_entry);
-    m_card_entry.set_hexpand();
+    card_label_box.append(card_label);
+    card_label.set_halign(Gtk::Align::START);
+    card_label.set_hexpand();
+    card_label.set_label(Glib::locale_to_utf8(_("New Card")));
+    card_label.set_wrap();
+    card_label.set_natural_wrap_mode(Gtk::NaturalWrapMode::WORD);
+    card_label.set_wrap_mode(Pango::WrapMode::WORD_CHAR);
+
+    card_label_box.append(m_widgets->card_entry_revealer);
+    m_widgets->card_entry_revealer.set_child(m_widgets->card_entry);
+    m_widgets->card_entry.set_hexpand();
     card_data_box.append(card_label_box);
 
     Gtk::Box& card_info_box = *Gtk::make_managed<Gtk::Box>();
     card_info_box.set_spacing(8);
 
-    card_info_box.append(m_completion_label);
-    m_completion_label.set_visible(false);
+    card_info_box.append(m_widgets->completion_label);
+    m_widgets->completion_label.set_visible(false);
 
-    card_info_box.append(m_deadline_label);
-    m_deadline_label.set_visible(false);
+    card_info_box.append(m_widgets->deadline_label);
+    m_widgets->deadline_label.set_visible(false);
+    m_widgets->deadline_label.property_label().signal_changed().connect(
+        sigc::mem_fun(*this, &CardWidget::update_deadline_label));
 
-    m_notes_icon.set_from_icon_name("document-text-symbolic");
-    m_notes_icon.add_css_class("notes-icon");
-    card_info_box.append(m_notes_icon);
-    m_notes_icon.set_visible(false);
+    Gtk::Image& notes_icon = m_widgets->notes_icon;
+    notes_icon.set_from_icon_name("document-text-symbolic");
+    notes_icon.add_css_class("notes-icon");
+    card_info_box.append(notes_icon);
+    notes_icon.set_visible(false);
 
     card_data_box.append(card_info_box);
 
     card_body.append(card_data_box);
 
-    m_card_menu_button.set_halign(Gtk::Align::CENTER);
-    m_card_menu_button.set_has_frame(false);
-    m_card_menu_button.set_icon_name("view-more-horizontal-symbolic");
-    m_card_menu_button.set_can_focus(false);
-    m_card_menu_button.set_popover(m_fixed_card_popover);
-
-    m_mouse_card_popover.set_parent(m_root);
+    Gtk::MenuButton& card_menu_button = m_widgets->card_menu_button;
+    card_menu_button.set_halign(Gtk::Align::CENTER);
+    card_menu_button.set_has_frame(false);
+    card_menu_button.set_icon_name("view-more-horizontal-symbolic");
+    card_menu_button.set_can_focus(false);
+    card_menu_button.set_create_popup_func([this, &card_menu_button]() {
+        card_popover().attach(*this, &card_menu_button);
+    });
 
-    m_card_menu_button.set_tooltip_text(_("Card Options"));
-    m_card_menu_button.set_valign(Gtk::Align::CENTER);
-    card_body.append(m_card_menu_button);
+    card_menu_button.set_tooltip_text(_("Card Options"));
+    card_menu_button.set_valign(Gtk::Align::CENTER);
+    card_body.append(card_menu_button);
 
-    m_root.insert_at_end(*this);
+    root.insert_at_end(*this);
 }
 }  // namespace ui
@@ -3,6 +3,8 @@
 #include <core/card.h>
 #include <gtkmm.h>
 
+#include <memory>
+
 #include "base-item.h"
 #include "cardlist-widget.h"
 #include "glibmm/extraclassinit.h"
@@ -26,6 +28,85 @@ public:
  */
 enum class CoverColor { UNSET, BLUE, RED, ORANGE, GREEN, YELLOW, PURPLE };
 
+/**
+ * @brief Returns the translated name of a cover color
+ */
+std::string label_for_color(CoverColor color);
+
+/**
+ * @brief How a CardWidget is rendered
+ *
+ * - WIDGETS: the card is made of child widgets (labels, revealers, entry and
+ * menu button)
+ * - DRAWN: the card has no child widgets and draws its contents itself. An
+ * entry is only created while the card is renamed
+ */
+enum class CardRenderMode { WIDGETS, DRAWN };
+
+class CardWidget;
+
+/** @brief Implements the card's popover menu
+ *
+ * The current implemented options are:
+ * - Rename card
+ * - Card Details
+ * - A colour selection radiobutton group
+ * - Delete card
+ *
+ * A single instance is shared by every card of a window (see
+ * ProgressWindow::card_popover). It is retargeted to a card right before being
+ * shown for it.
+ */
+class CardPopover : public Gtk::PopoverMenu {
+public:
+    CardPopover();
+
+    ~CardPopover() override;
+
+    /**
+     * @brief Makes the popover act on the given card.
+     *
+     * @param card The card the popover's options apply to.
+     * @param menu_button When set, the popover becomes this button's popover.
+     * Otherwise it is parented to the card itself, to be shown next to the
+     * pointer.
+     */
+    void attach(CardWidget& card, Gtk::MenuButton* menu_button = nullptr);
+
+    /**
+     * @brief Selects the radio button corresponding to the given color.
+     *
+     * If trigger is false, the color's radio button is activated silently
+     * (the signal handler is temporarily blocked).
+     *
+     * @param color   The color to select.
+     * @param trigger Whether to emit the color-change signal.
+     */
+    void set_selected_color(CoverColor color, bool trigger = true);
+
+    /**
+     * @brief Takes the popover out of whatever card it was attached to
+     */
+    void detach();
+
+protected:
+
+    /**
+     * @brief Helper method for creating a color setting closure to set the
+     * color of the attached card widget.
+     *
+     * @param checkbutton The radio button selecting the color.
+     * @param color The color to set.
+     * @return A closure that sets the color of the card widget.
+     */
+    std::function<void()> color_setting_thunk(Gtk::CheckButton* checkbutton,
+                                              CoverColor color);
+
+    CardWidget* m_card_widget = nullptr;
+    std::map<CoverColor, std::tuple<Gtk::CheckButton*, sigc::connection>>
+        m_color_radio_button_map;
+};
+
 /**
  * @brief Widget that represents a single card.
  */
@@ -37,6 +118,21 @@ public:
 
     const static std::unordered_map<CoverColor, Gdk::RGBA> CARD_COLORS;
 
+    using Shortcut = std::pair<const char*, std::function<bool(CardWidget&)>>;
+
+    /**
+     * @brief Keyboard shortcuts acting on a card. They are not installed on
+     * every card: the card's CardlistWidget dispatches them to its focused card
+     */
+    const static std::array<Shortcut, 9> SHORTCUTS;
+
+    /**
+     * @brief Sets the render mode of cards created or reset from now on
+     */
+    static void set_default_render_mode(CardRenderMode mode);
+
+    static CardRenderMode default_render_mode();
+
     /**
      * @brief Constructs a CardWidget object.
      *
@@ -60,6 +156,27 @@ public:
                bool show_notes_icon = false, int n_tasks = 0,
                int n_tasks_complete = 0);
 
+    ~CardWidget() override;
+
+    /**
+     * @brief Makes the widget represent another card. Unlike the individual
+     * setters, no change signals are emitted.
+     *
+     * @details Parameters have the same meaning as in the constructor. This
+     * is used by virtualized cardlists, where widgets are recycled across rows
+     */
+    void reset(const std::string& title, Gdk::RGBA cover_color = {},
+               Glib::Date deadline = {}, bool complete = false,
+               bool show_notes_icon = false, int n_tasks = 0,
+               int n_tasks_complete = 0);
+
+    /**
+     * @brief Switches the card to another render mode. Renaming is cancelled
+     */
+    void set_render_mode(CardRenderMode mode);
+
+    CardRenderMode get_render_mode() const;
+
     /**
      * @brief Sets the title of the card.
      *
@@ -74,6 +191,18 @@ public:
      */
     void set_cardlist(ui::CardlistWidget* new_parent);
 
+    /**
+     * @brief Forgets the cardlist this card belonged to, so a recycled widget
+     * can be appended to another cardlist.
+     */
+    void detach();
+
+    /**
+     * @brief Takes the window's card popover out of this card, if it is
+     * acting on it. Called before the widget stops representing its card
+     */
+    void release_card_popover();
+
     /**
      * @brief Sets this card cover's color.
      *
@@ -136,74 +265,45 @@ public:
     sigc::signal<void()>& signal_card_dialog_closed();
 
 protected:
-    /** @brief Implements the card's popover menu
-     *
-     * The current implemented options are:
-     * - Rename card
-     * - Card Details
-     * - A colour selection radiobutton group
-     * - Delete card
-     */
-    class CardPopover : public Gtk::PopoverMenu {
-    public:
-        /**
-         * @brief Constructor for CardPopover class.
-         *
-         * @param card The card widget to set the color for.
-         */
-        CardPopover(CardWidget* card);
-
-        ~CardPopover() override;
-
-        /**
-         * @brief Selects the radio button corresponding to the given color.
-         *
-         * If trigger is true, this method activates the color’s radio button
-         * and emits the related color-change signal. It also updates all
-         * sibling popovers associated with the same CardWidget by setting their
-         * selected color without emitting additional signals.
-         *
-         * If trigger is false, the color’s radio button is activated silently
-         * (the signal handler is temporarily blocked), and only this popover is
-         * updated.
-         *
-         * @param color   The color to select.
-         * @param trigger Whether to emit the color-change signal.
-         */
-
-        void set_selected_color(CoverColor color, bool trigger = true);
-
-    protected:
-        static std::map<CardWidget*, std::vector<CardPopover*>>
-            registered_card_popovers;
-
-        /**
-         * @brief Helper method for creating a color setting closure to set the
-         * color of the card widget.
-         *
-         * @param card The card widget to set the color for.
-         * @param color The color to set.
-         * @return A closure that sets the color of the card widget.
-         */
-        std::function<void()> color_setting_thunk(CardWidget* card,
-                                                  Gtk::CheckButton* checkbutton,
-                                                  CoverColor color);
-        CardWidget* m_card_widget;
-        std::map<CoverColor, std::tuple<Gtk::CheckButton*, sigc::connection>>
-            m_color_radio_button_map;
+    friend class CardPopover;
+    friend class CardlistWidget;
+
+    /**
+     * @brief Child widgets of a card rendered as CardRenderMode::WIDGETS
+     */
+    struct WidgetTree {
+        Gtk::Box root{Gtk::Orientation::VERTICAL};
+        Gtk::Revealer card_cover_revealer, card_entry_revealer;
+        Gtk::Picture card_cover_picture;
+        Gtk::Label card_label, completion_label, deadline_label;
+        Gtk::Image notes_icon;
+        Gtk::Entry card_entry;
+        Gtk::MenuButton card_menu_button;
     };
 
-    friend class CardPopover;
+    /**
+     * @brief Positions of a drawn card's contents, relative to the card
+     */
+    struct DrawnGeometry {
+        Gdk::Rectangle title;
+        int info_y = 0, info_height = 0;
+        int height = 0;
+    };
+
+    // Widgets, only set in CardRenderMode::WIDGETS
+    std::unique_ptr<WidgetTree> m_widgets;
 
-    // Widgets
-    Gtk::Box m_root;
-    Gtk::Revealer m_card_cover_revealer, m_card_entry_revealer;
-    Gtk::Picture m_card_cover_picture;
-    Gtk::Label m_card_label, m_completion_label, m_deadline_label;
-    Gtk::Image m_notes_icon;
-    Gtk::Entry m_card_entry;
-    Gtk::MenuButton m_card_menu_button;
-    CardPopover m_fixed_card_popover, m_mouse_card_popover;
+    // CardRenderMode::DRAWN context. Layouts are kept across frames and only
+    // updated when the text they display changes
+    Glib::RefPtr<Pango::Layout> m_title_layout, m_completion_layout,
+        m_deadline_layout;
+    std::unique_ptr<Gtk::Entry> m_rename_entry;
+
+    // Displayed card
+    std::string m_title, m_deadline_text;
+    std::string m_deadline_css, m_completion_css;
+    int m_n_tasks = 0, m_n_tasks_complete = 0;
+    bool m_show_notes_icon = false;
 
     // Signals
     sigc::signal<void(std::string, std::string)> m_name_changed_signal;
@@ -212,19 +312,72 @@ protected:
     // incoming_card, sibling, incoming_parent
     sigc::signal<void(CardWidget*, CardlistWidget*)> m_card_received_signal;
 
-    // Controllers
+    // Controllers. Input on cards is handled by their CardlistWidget, only the
+    // entry's focus controller lives on the card, and only once it is renamed
     Glib::RefPtr<Gtk::EventControllerFocus> m_focus_ctrl;
-    Glib::RefPtr<Gtk::EventControllerKey> m_key_ctrl;
-    Glib::RefPtr<Gtk::GestureClick> m_click_ctrl;
 
     Glib::Date m_date;
     Gdk::RGBA m_color;
     bool m_complete;
     ui::CardlistWidget* m_parent;
 
-    void setup_drag_and_drop();
+    // Set while the shared card popover acts on this card
+    CardPopover* m_card_popover = nullptr;
+
     void open_card_dialog();
 
+    /**
+     * @brief Returns the widget the card popover is parented to when it is
+     * shown next to the pointer
+     */
+    Gtk::Widget& popover_parent();
+
+    /**
+     * @brief Returns the entry used to rename the card. In
+     * CardRenderMode::DRAWN the entry is created if needed
+     */
+    Gtk::Entry& rename_entry();
+
+    bool is_renaming() const;
+
+    /**
+     * @brief Destroys the entry of a drawn card once renaming is over
+     */
+    void drop_rename_entry();
+
+    /**
+     * @brief Handles a key released while the card is focused. Confirms or
+     * cancels renaming
+     *
+     * @return true if the key has been handled
+     */
+    bool on_rename_key(guint keyval);
+
+    /**
+     * @brief Handles a click released on the card. A secondary click shows the
+     * card popover and a primary click starts renaming
+     *
+     * @param x, y position of the click, relative to the card
+     */
+    void on_click(guint button, int n_pressed, double x, double y);
+
+    /**
+     * @brief Handles another card being dropped on this one. Cards of the same
+     * cardlist are reordered, others are moved next to this card
+     */
+    void on_card_dropped(CardWidget& dropped_card_widget);
+
+    /**
+     * @brief Returns the card popover shared within this card's window
+     */
+    CardPopover& card_popover();
+
+    /**
+     * @brief Shows the shared card popover for this card, pointing at the
+     * given area
+     */
+    void popup_card_popover(const Gdk::Rectangle& pointing_to);
+
     /**
      * @brief Enables renaming of the card.
      */
@@ -251,8 +404,28 @@ protected:
 
     void cleanup() override;
 
+    // CardRenderMode::DRAWN rendering
+    DrawnGeometry drawn_geometry(int width) const;
+    Gdk::RGBA info_color(const std::string& css_class);
+    void measure_vfunc(Gtk::Orientation orientation, int for_size, int& minimum,
+                       int& natural, int& minimum_baseline,
+                       int& natural_baseline) const override;
+    void size_allocate_vfunc(int width, int height, int baseline) override;
+    void snapshot_vfunc(const Glib::RefPtr<Gtk::Snapshot>& snapshot) override;
+
 private:
     void setup_widgets();
+    void setup_layouts();
+
+    /**
+     * @brief Shows the card's current title, cover and labels in the current
+     * render mode
+     */
+    void display_title();
+    void display_cover();
+    void display_deadline();
+    void display_completion();
+
     void __set_cover_color(const Gdk::RGBA& color);
     void __clear_cover_color();
 };
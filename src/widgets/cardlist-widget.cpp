@@ -3,6 +3,8 @@
 #include <glibmm/i18n.h>
 #include <spdlog/spdlog.h>
 
+#include <map>
+
 #include "board-widget.h"
 #include "card-widget.h"
 
@@ -61,10 +63,8 @@ CardlistWidget::CardlistWidget(BoardWidget& board, const std::string& name)
 
     m_add_card_button.set_valign(Gtk::Align::CENTER);
     m_add_card_button.set_hexpand(true);
-    m_add_card_button.signal_clicked().connect([this]() {
-        CardWidget* card = Gtk::make_managed<CardWidget>(_("New Card"));
-        append(*card);
-    });
+    m_add_card_button.signal_clicked().connect(
+        [this]() { add_card(_("New Card")); });
     m_root.append(m_add_card_button);
 
     m_header.insert_at_start(*this);
@@ -133,21 +133,60 @@ CardlistWidget::CardlistWidget(BoardWidget& board, const std::string& name)
     auto shortcut_controller = Gtk::ShortcutController::create();
     shortcut_controller->set_scope(Gtk::ShortcutScope::LOCAL);
 
+    // Cards have no controllers of their own: their shortcuts are dispatched
+    // here to the focused card, which takes precedence over the cardlist
+    // shortcuts bound to the same keys
+    std::map<std::string, std::pair<CardWidget::Shortcut::second_type,
+                                    CardListShortcut::second_type>>
+        shortcuts;
+    for (const auto& [keybinding, callback] : CardWidget::SHORTCUTS) {
+        shortcuts[keybinding].first = callback;
+    }
     for (const auto& [keybinding, callback] : cardlist_shortcuts) {
+        shortcuts[keybinding].second = callback;
+    }
+
+    for (const auto& [keybinding, callbacks] : shortcuts) {
         shortcut_controller->add_shortcut(Gtk::Shortcut::create(
             Gtk::ShortcutTrigger::parse_string(keybinding),
-            Gtk::CallbackAction::create(callback)));
+            Gtk::CallbackAction::create(
+                [this, callbacks](Gtk::Widget& widget,
+                                  const Glib::VariantBase& args) {
+                    CardWidget* card = this->focused_card();
+                    if (card && callbacks.first) {
+                        return callbacks.first(*card);
+                    }
+                    return callbacks.second && callbacks.second(widget, args);
+                })));
     }
 
     add_controller(shortcut_controller);
 
+    auto key_controller = Gtk::EventControllerKey::create();
+    key_controller->signal_key_released().connect(
+        [this](guint keyval, guint keycode, Gdk::ModifierType state) {
+            CardWidget* card = this->focused_card();
+            if (card) {
+                card->on_rename_key(keyval);
+            }
+        });
+    add_controller(key_controller);
+
     auto gesture_click = Gtk::GestureClick::create();
 
     gesture_click->set_button(0);
     gesture_click->signal_released().connect(
         [this, gesture_click](int n_pressed, double x, double y) {
-            if (n_pressed == 1 &&
-                gesture_click->get_current_button() == GDK_BUTTON_SECONDARY) {
+            const guint button = gesture_click->get_current_button();
+            CardWidget* card = this->card_at(x, y);
+            if (card) {
+                double card_x, card_y;
+                this->translate_coordinates(*card, x, y, card_x, card_y);
+                card->on_click(button, n_pressed, card_x, card_y);
+                return;
+            }
+
+            if (n_pressed == 1 && button == GDK_BUTTON_SECONDARY) {
                 this->m_popover.set_pointing_to(Gdk::Rectangle(x, y, 0, 0));
                 m_popover.popup();
             }
@@ -162,22 +201,182 @@ void CardlistWidget::set_title(const std::string& name) {
     m_name_changed_signal.emit(old_name, m_name);
 }
 
+void CardlistWidget::reset(const std::string& title) {
+    if (m_list_view) {
+        // Rows unbound while the list view goes away are not announced
+        m_virtual_cards.clear();
+        m_virtual_widgets.clear();
+        m_scr_window.set_child(m_root);
+        m_add_card_button.unparent();
+        m_add_card_button.set_margin_top(0);
+        m_root.append(m_add_card_button);
+        m_list_view = nullptr;
+        m_selection = nullptr;
+        m_model = nullptr;
+    }
+
+    release_cards();
+
+    // The new cardlist has no cards to restore yet
+    m_dormant_signal.block();
+    set_dormant(false);
+    m_dormant_signal.unblock();
+    set_sensitive(true);
+    set_opacity(1);
+    remove_css_class("cardlist-to-drop");
+
+    m_name = title;
+    m_header.set_label(title);
+}
+
+void CardlistWidget::set_model(const Glib::RefPtr<CardListModel>& model) {
+    if (m_model || !model) {
+        return;
+    }
+
+    // From now on card widgets are handed out by the list view
+    for (Gtk::Widget* child = m_root.get_first_child(); child;) {
+        Gtk::Widget* next_child = child->get_next_sibling();
+        if (child != &m_add_card_button) {
+            auto card = static_cast<CardWidget*>(child);
+            m_card_unbind_signal.emit(card);
+            m_root.remove(*card);
+        }
+        child = next_child;
+    }
+    m_card_positions.clear();
+
+    m_model = model;
+    setup_list_view();
+}
+
+bool CardlistWidget::is_virtualized() const { return bool(m_model); }
+
+void CardlistWidget::set_dormant(bool dormant) {
+    if (m_dormant == dormant) {
+        return;
+    }
+
+    m_dormant = dormant;
+    m_scr_window.set_visible(!dormant);
+    m_add_card_button.set_visible(!dormant);
+
+    // Dropping the model unbinds every row, so off-screen columns do not keep
+    // card widgets around
+    if (m_list_view) {
+        m_list_view->set_model(dormant ? nullptr : m_selection);
+    }
+
+    m_dormant_signal.emit(dormant);
+}
+
+bool CardlistWidget::is_dormant() const { return m_dormant; }
+
+std::vector<CardWidget*> CardlistWidget::cards() const {
+    return m_card_positions.items();
+}
+
+void CardlistWidget::release_cards() {
+    if (m_model) {
+        return;
+    }
+
+    for (Gtk::Widget* child = m_root.get_first_child();
+         child != &m_add_card_button; child = m_root.get_first_child()) {
+        m_root.remove(*child);
+    }
+    m_card_positions.clear();
+}
+
+void CardlistWidget::restore_card(CardWidget& card) {
+    if (!card.parent() && !m_model) {
+        card.set_cardlist(this);
+        m_root.append(card);
+        m_root.reorder_child_after(m_add_card_button, card);
+        m_card_positions.append(&card);
+    }
+}
+
+CardWidget* CardlistWidget::add_card(const std::string& title,
+                                     CardWidget* sibling) {
+    if (m_model) {
+        int index = -1;
+        if (sibling && m_virtual_cards.contains(sibling)) {
+            index = m_model->find(m_virtual_cards[sibling]);
+        }
+        m_card_request_signal.emit(title, index);
+        return nullptr;
+    }
+
+    auto card = Gtk::make_managed<CardWidget>(title);
+    if (sibling) {
+        insert_after(*card, *sibling);
+    } else {
+        append(*card);
+    }
+    return card;
+}
+
+CardWidget* CardlistWidget::prev_card(CardWidget& card) {
+    if (!m_model) {
+        return static_cast<CardWidget*>(card.get_prev_sibling());
+    }
+
+    if (!m_virtual_cards.contains(&card)) {
+        return nullptr;
+    }
+
+    const ssize_t card_i = m_model->find(m_virtual_cards[&card]);
+    return card_i > 0 ? virtual_card_at(card_i - 1) : nullptr;
+}
+
+CardWidget* CardlistWidget::next_card(CardWidget& card) {
+    if (!m_model) {
+        Gtk::Widget* next = card.get_next_sibling();
+        if (!next || next == &m_add_card_button) {
+            return nullptr;
+        }
+        return static_cast<CardWidget*>(next);
+    }
+
+    if (!m_virtual_cards.contains(&card)) {
+        return nullptr;
+    }
+
+    const ssize_t card_i = m_model->find(m_virtual_cards[&card]);
+    return card_i != -1 ? virtual_card_at(card_i + 1) : nullptr;
+}
+
 void CardlistWidget::reorder(CardWidget& next, CardWidget& sibling) {
-    ssize_t next_i = -1;
-    ssize_t sibling_i = -1;
-
-    ssize_t c_i = 0;
-    for (Gtk::Widget* cur_card = m_root.get_first_child(); cur_card;
-         cur_card = cur_card->get_next_sibling()) {
-        if (&next == cur_card) {
-            next_i = c_i;
-        } else if (&sibling == cur_card) {
-            sibling_i = c_i;
+    if (m_model) {
+        if (!m_virtual_cards.contains(&next) ||
+            !m_virtual_cards.contains(&sibling)) {
+            return;
+        }
+
+        // The rows are moved by the model once the cardlist is reordered
+        std::shared_ptr<Card> moved = m_virtual_cards[&next];
+        const ssize_t next_i = m_model->find(moved);
+        const ssize_t sibling_i = m_model->find(m_virtual_cards[&sibling]);
+        if (next_i == -1 || sibling_i == -1 || next_i == sibling_i) {
+            return;
+        }
+
+        m_card_reorder_signal.emit(&next, &sibling, next_i > sibling_i);
+
+#if GTKMM_CHECK_VERSION(4, 12, 0)
+        const ssize_t moved_i = m_model->find(moved);
+        if (moved_i != -1) {
+            m_list_view->scroll_to(moved_i, Gtk::ListScrollFlags::FOCUS);
         }
-        c_i++;
+#endif
+        return;
     }
 
-    if ((next_i == -1) || (sibling_i == -1)) {
+    const ssize_t next_i = m_card_positions.index_of(&next);
+    const ssize_t sibling_i = m_card_positions.index_of(&sibling);
+
+    if ((next_i == -1) || (sibling_i == -1) || (&next == &sibling)) {
         return;
     }
 
@@ -200,10 +399,24 @@ void CardlistWidget::reorder(CardWidget& next, CardWidget& sibling) {
         }
     }
 
+    if (up) {
+        m_card_positions.move_before(&next, &sibling);
+    } else {
+        m_card_positions.move_after(&next, &sibling);
+    }
+
     m_card_reorder_signal.emit(&next, &sibling, up);
 }
 
 void CardlistWidget::remove(CardWidget& card) {
+    if (m_model) {
+        // The row goes away once the card is removed from the model
+        if (is_child(card)) {
+            m_card_remove_signal.emit(&card);
+        }
+        return;
+    }
+
     // Focus should be passed to the immediate sibling
     Gtk::Widget* next_card = card.get_next_sibling();
     Gtk::Widget* prev_card = card.get_prev_sibling();
@@ -216,26 +429,26 @@ void CardlistWidget::remove(CardWidget& card) {
     }
 
     m_card_remove_signal.emit(&card);
+    m_card_positions.erase(&card);
     m_root.remove(card);
 }
 
 void CardlistWidget::append(CardWidget& card) {
-    if (!card.parent()) {
+    if (!card.parent() && !m_model) {
         card.set_cardlist(this);
         m_root.append(card);
         m_root.reorder_child_after(m_add_card_button, card);
+        m_card_positions.append(&card);
 
         m_card_add_signal.emit(&card, -1);
     }
 }
 
 void CardlistWidget::insert_after(CardWidget& card, CardWidget& sibling) {
-    if (!card.parent() && sibling.parent() == this) {
-        ssize_t index = 0;
-        for (Gtk::Widget* card = m_root.get_first_child(); card != &sibling;
-             card = card->get_next_sibling())
-            index++;
+    if (!card.parent() && sibling.parent() == this && !m_model) {
+        const ssize_t index = m_card_positions.index_of(&sibling);
         m_root.insert_child_after(card, sibling);
+        m_card_positions.insert_after(&card, &sibling);
         card.set_cardlist(this);
 
         m_card_add_signal.emit(&card, index);
@@ -243,7 +456,9 @@ void CardlistWidget::insert_after(CardWidget& card, CardWidget& sibling) {
 }
 
 void CardlistWidget::receive(CardWidget& card) {
-    if (card.parent()) {
+    if (card.parent() && (m_model || card.parent()->is_virtualized())) {
+        receive_virtual(card, nullptr);
+    } else if (card.parent()) {
         CardlistWidget* old_parent = card.parent();
         card.reference();
         card.parent()->signal_card_removed().block();
@@ -252,6 +467,7 @@ void CardlistWidget::receive(CardWidget& card) {
         card.set_cardlist(this);
         m_root.append(card);
         m_root.reorder_child_after(m_add_card_button, card);
+        m_card_positions.append(&card);
 
         card.parent()->signal_card_removed().unblock();
         card.unreference();
@@ -261,7 +477,10 @@ void CardlistWidget::receive(CardWidget& card) {
 }
 
 void CardlistWidget::receive_after(CardWidget& card, CardWidget& sibling) {
-    if (card.parent() && sibling.parent() == this) {
+    if (card.parent() && sibling.parent() == this &&
+        (m_model || card.parent()->is_virtualized())) {
+        receive_virtual(card, &sibling);
+    } else if (card.parent() && sibling.parent() == this) {
         CardlistWidget* old_parent = card.parent();
         card.reference();
         card.parent()->signal_card_removed().block();
@@ -270,6 +489,7 @@ void CardlistWidget::receive_after(CardWidget& card, CardWidget& sibling) {
         card.set_cardlist(this);
         m_root.append(card);
         m_root.reorder_child_after(card, sibling);
+        m_card_positions.insert_after(&card, &sibling);
 
         card.parent()->signal_card_removed().unblock();
         card.unreference();
@@ -281,13 +501,11 @@ void CardlistWidget::receive_after(CardWidget& card, CardWidget& sibling) {
 const std::string& CardlistWidget::get_name() const { return m_name; }
 
 bool CardlistWidget::is_child(CardWidget& card) {
-    for (Gtk::Widget* cur_card = m_root.get_first_child(); cur_card;
-         cur_card = cur_card->get_next_sibling()) {
-        if (cur_card == &card) {
-            return true;
-        }
+    if (m_model) {
+        return m_virtual_cards.contains(&card);
     }
-    return false;
+
+    return m_card_positions.contains(&card);
 }
 
 sigc::signal<void(std::string, std::string)>&
@@ -312,7 +530,172 @@ CardlistWidget::signal_card_received() {
     return m_card_received_signal;
 }
 
+sigc::signal<void(CardWidget*, std::shared_ptr<Card>)>&
+CardlistWidget::signal_card_bound() {
+    return m_card_bind_signal;
+}
+
+sigc::signal<void(CardWidget*)>& CardlistWidget::signal_card_unbound() {
+    return m_card_unbind_signal;
+}
+
+sigc::signal<void(std::string, int)>& CardlistWidget::signal_card_requested() {
+    return m_card_request_signal;
+}
+
+sigc::signal<void(bool)>& CardlistWidget::signal_dormant() {
+    return m_dormant_signal;
+}
+
+void CardlistWidget::receive_virtual(CardWidget& card, CardWidget* sibling) {
+    CardlistWidget* old_parent = card.parent();
+    if (old_parent == this || !old_parent->is_child(card)) {
+        return;
+    }
+
+    std::shared_ptr<Card> moved =
+        old_parent->m_model ? old_parent->m_virtual_cards[&card] : nullptr;
+
+    // Receivers move the card between both cardlists. Virtualized ends follow
+    // that through their models
+    m_card_received_signal.emit(&card, old_parent, sibling);
+
+    if (!old_parent->m_model) {
+        old_parent->m_card_unbind_signal.emit(&card);
+        old_parent->m_card_positions.erase(&card);
+        old_parent->m_root.remove(card);
+    }
+
+    if (!m_model && moved) {
+        auto card_widget = Gtk::make_managed<CardWidget>(moved->get_name());
+        card_widget->set_cardlist(this);
+        if (sibling) {
+            m_root.insert_child_after(*card_widget, *sibling);
+            m_card_positions.insert_after(card_widget, sibling);
+        } else {
+            m_root.append(*card_widget);
+            m_root.reorder_child_after(m_add_card_button, *card_widget);
+            m_card_positions.append(card_widget);
+        }
+        m_card_bind_signal.emit(card_widget, moved);
+    }
+}
+
+CardWidget* CardlistWidget::virtual_card_at(ssize_t position) const {
+    const std::shared_ptr<Card> card = m_model->get_card(position);
+    if (!card) {
+        return nullptr;
+    }
+    auto row = m_virtual_widgets.find(card.get());
+    return row != m_virtual_widgets.end() ? row->second : nullptr;
+}
+
+void CardlistWidget::setup_list_view() {
+    auto factory = Gtk::SignalListItemFactory::create();
+    factory->signal_setup().connect(
+        [this](const Glib::RefPtr<Gtk::ListItem>& list_item) {
+            auto card = Gtk::make_managed<CardWidget>("");
+            card->set_cardlist(this);
+
+            // The gap between cards belongs to the card, so rows of cards
+            // hidden by a filter take no space
+            card->set_margin_bottom(15);
+            list_item->set_activatable(false);
+            list_item->set_selectable(false);
+            list_item->set_child(*card);
+        });
+    factory->signal_bind().connect(
+        [this](const Glib::RefPtr<Gtk::ListItem>& list_item) {
+            auto card = static_cast<CardWidget*>(list_item->get_child());
+            auto card_object =
+                std::dynamic_pointer_cast<CardObject>(list_item->get_item());
+            if (card && card_object) {
+                m_virtual_cards[card] = card_object->card();
+                m_virtual_widgets[card_object->card().get()] = card;
+                m_card_bind_signal.emit(card, card_object->card());
+            }
+        });
+    factory->signal_unbind().connect(
+        [this](const Glib::RefPtr<Gtk::ListItem>& list_item) {
+            auto card = static_cast<CardWidget*>(list_item->get_child());
+            auto bound = card ? m_virtual_cards.find(card)
+                              : m_virtual_cards.end();
+            if (bound == m_virtual_cards.end()) {
+                return;
+            }
+
+            auto row = m_virtual_widgets.find(bound->second.get());
+            if (row != m_virtual_widgets.end() && row->second == card) {
+                m_virtual_widgets.erase(row);
+            }
+            m_virtual_cards.erase(bound);
+            m_card_unbind_signal.emit(card);
+        });
+
+    m_selection = Gtk::NoSelection::create(m_model);
+    m_list_view = Gtk::make_managed<Gtk::ListView>(
+        m_dormant ? nullptr : m_selection, factory);
+    m_list_view->add_css_class("cardlist-view");
+    m_list_view->set_vexpand();
+    m_scr_window.set_child(*m_list_view);
+
+    // The add button can no longer live among the cards
+    m_root.remove(m_add_card_button);
+    m_add_card_button.set_margin_top(15);
+    m_add_card_button.insert_after(*this, m_scr_window);
+
+    spdlog::get("app")->debug(
+        "[CardlistWidget.set_model] Card list (\"{}\") is now virtualized "
+        "({} cards)",
+        get_name(), m_model->size());
+}
+
 void CardlistWidget::setup_drag_and_drop() {
+    // Cards are dragged through a single source covering the cardlist's cards
+    auto card_drag_source = Gtk::DragSource::create();
+    card_drag_source->set_actions(Gdk::DragAction::MOVE);
+    card_drag_source->signal_prepare().connect(
+        [this, card_drag_source](
+            double x, double y) -> Glib::RefPtr<Gdk::ContentProvider> {
+            double cardlist_x, cardlist_y;
+            m_scr_window.translate_coordinates(*this, x, y, cardlist_x,
+                                               cardlist_y);
+            CardWidget* card = this->card_at(cardlist_x, cardlist_y);
+            if (!card) {
+                return nullptr;
+            }
+
+            double card_x, card_y;
+            this->translate_coordinates(*card, cardlist_x, cardlist_y, card_x,
+                                        card_y);
+
+            Glib::Value<CardWidget*> value_new_cardptr;
+            value_new_cardptr.init(Glib::Value<CardWidget*>::value_type());
+            value_new_cardptr.set(card);
+            auto card_icon = Gtk::WidgetPaintable::create(*card);
+            card_drag_source->set_icon(card_icon, card_x, card_y);
+
+            return Gdk::ContentProvider::create(value_new_cardptr);
+        },
+        false);
+    card_drag_source->signal_drag_begin().connect(
+        [this](const Glib::RefPtr<Gdk::Drag>& drag_ref) {
+            this->board.set_scroll();
+        },
+        false);
+    card_drag_source->signal_drag_cancel().connect(
+        [this](const Glib::RefPtr<Gdk::Drag>& drag_ref,
+               Gdk::DragCancelReason reason) {
+            this->board.set_scroll(false);
+            return true;
+        },
+        false);
+    card_drag_source->signal_drag_end().connect(
+        [this](const Glib::RefPtr<Gdk::Drag>& drag_ref, bool s) {
+            this->board.set_scroll(false);
+        });
+    m_scr_window.add_controller(card_drag_source);
+
     auto drag_source_c = Gtk::DragSource::create();
     drag_source_c->signal_prepare().connect(
         [this, drag_source_c](double x, double y) {
@@ -391,7 +774,10 @@ void CardlistWidget::setup_drag_and_drop() {
                 dropped_value.init(value.gobj());
 
                 auto dropped_card = dropped_value.get();
-                if (!this->is_child(*dropped_card)) {
+                CardWidget* card = this->card_at(x, y);
+                if (card) {
+                    card->on_card_dropped(*dropped_card);
+                } else if (!this->is_child(*dropped_card)) {
                     receive(*dropped_card);
                 }
 
@@ -404,9 +790,39 @@ void CardlistWidget::setup_drag_and_drop() {
     add_controller(drop_target_card);
 }
 
+CardWidget* CardlistWidget::card_at(double x, double y) {
+    for (Gtk::Widget* widget = pick(x, y); widget && widget != this;
+         widget = widget->get_parent()) {
+        auto card = dynamic_cast<CardWidget*>(widget);
+        if (card) {
+            return card->parent() == this ? card : nullptr;
+        }
+    }
+    return nullptr;
+}
+
+CardWidget* CardlistWidget::focused_card() {
+    auto root = get_root();
+    if (!root) {
+        return nullptr;
+    }
+
+    for (Gtk::Widget* widget = root->get_focus(); widget && widget != this;
+         widget = widget->get_parent()) {
+        auto card = dynamic_cast<CardWidget*>(widget);
+        if (card) {
+            return card->parent() == this ? card : nullptr;
+        }
+    }
+    return nullptr;
+}
+
 void CardlistWidget::cleanup() {
     m_header.unparent();
     m_popover.unparent();
     m_scr_window.unparent();
+    if (m_add_card_button.get_parent() == this) {
+        m_add_card_button.unparent();
+    }
 }
 }  // namespace ui
@@ -1,10 +1,12 @@
 #pragma once
 
+#include <core/position-index.h>
 #include <glibmm/extraclassinit.h>
 #include <gtkmm.h>
 
 #include "base-item.h"
 #include "board-widget.h"
+#include "card-list-model.h"
 #include "card-widget.h"
 #include "editable-label-header.h"
 
@@ -24,11 +26,25 @@ public:
 
 /**
  * @brief Cardlist Widget
+ *
+ * @details A cardlist widget works in one of two modes. By default, every card
+ * is a child widget of the cardlist. Once a model is set (see set_model), the
+ * cards are rendered by a Gtk::ListView instead, which only keeps widgets for
+ * the visible rows and rebinds them as the user scrolls. In that mode, card
+ * widgets are owned by the list view: they are announced through
+ * signal_card_bound and signal_card_unbound and all structural changes are
+ * expected to be made on the model's cardlist.
  */
 class CardlistWidget : public CardlistInit, public BaseItem {
 public:
     static constexpr int CARDLIST_MAX_WIDTH = 240;
 
+    /**
+     * @brief Number of cards above which a cardlist should be rendered through
+     * a list model
+     */
+    static constexpr size_t VIRTUALIZATION_THRESHOLD = 150;
+
     /**
      * @brief CardlistWidget constructor
      *
@@ -40,6 +56,86 @@ public:
 
     void set_title(const std::string& title);
 
+    /**
+     * @brief Brings the cardlist back to a freshly constructed state, with no
+     * cards and the given title, without emitting any signal. Used to reuse
+     * the widget for another cardlist
+     */
+    void reset(const std::string& title);
+
+    /**
+     * @brief Switches the cardlist to virtualized rendering.
+     *
+     * @details Every card widget currently held by the cardlist is announced
+     * as unbound and dropped. This method has no effect if a model has already
+     * been set.
+     *
+     * @param model cards to be rendered
+     */
+    void set_model(const Glib::RefPtr<CardListModel>& model);
+
+    bool is_virtualized() const;
+
+    /**
+     * @brief Releases or restores the cardlist's contents.
+     *
+     * @details A dormant cardlist only shows its header. Its cards are neither
+     * measured nor drawn, and virtualized cardlists hand their row widgets back
+     * to the list view. Other cardlists announce the change through
+     * signal_dormant, so their card widgets can be released (see
+     * release_cards) and rebuilt once they wake up. The cardlist keeps its
+     * width, so neighbouring cardlists do not move when it wakes up.
+     */
+    void set_dormant(bool dormant = true);
+
+    bool is_dormant() const;
+
+    /**
+     * @brief Returns the card widgets in order. Virtualized cardlists have
+     * none
+     */
+    std::vector<CardWidget*> cards() const;
+
+    /**
+     * @brief Takes every card widget out of the cardlist without emitting any
+     * signal. Managed card widgets are destroyed, so they must not be used
+     * afterwards. Does nothing on virtualized cardlists
+     */
+    void release_cards();
+
+    /**
+     * @brief Adds a card widget to the end of the cardlist without emitting
+     * any signal. Used to give a cardlist back the cards it released
+     */
+    void restore_card(CardWidget& card);
+
+    /**
+     * @brief Creates a new card after the sibling card, or at the end of the
+     * cardlist if no sibling is given.
+     *
+     * @details On virtualized cardlists no widget is created here. The request
+     * is forwarded through signal_card_requested and the new row shows up once
+     * the card is added to the model.
+     *
+     * @return the new card widget, or nullptr on virtualized cardlists
+     */
+    CardWidget* add_card(const std::string& title,
+                         CardWidget* sibling = nullptr);
+
+    /**
+     * @brief Returns the card widget displayed right before the given card, or
+     * nullptr if there is none (or it is not realized on virtualized
+     * cardlists)
+     */
+    CardWidget* prev_card(CardWidget& card);
+
+    /**
+     * @brief Returns the card widget displayed right after the given card, or
+     * nullptr if there is none (or it is not realized on virtualized
+     * cardlists)
+     */
+    CardWidget* next_card(CardWidget& card);
+
     /**
      * @brief Reorders card widget "next" after card widget "sibling".
      *
@@ -52,7 +148,8 @@ public:
 
     /**
      * @brief Adds a card widget to the end of the cardlist widget. This method
-     * will not do anything if the card has a parent
+     * will not do anything if the card has a parent or if the cardlist is
+     * virtualized
      *
      * @param card card widget
      */
@@ -84,11 +181,36 @@ public:
     sigc::signal<void(CardWidget*, CardWidget*, bool)>& signal_card_reorder();
     sigc::signal<void(CardWidget*, CardlistWidget*, CardWidget*)>&
     signal_card_received();
+    sigc::signal<void(CardWidget*, std::shared_ptr<Card>)>& signal_card_bound();
+    sigc::signal<void(CardWidget*)>& signal_card_unbound();
+    sigc::signal<void(std::string, int)>& signal_card_requested();
+    sigc::signal<void(bool)>& signal_dormant();
 
     BoardWidget& board;
 
 protected:
     void setup_drag_and_drop();
+    void setup_list_view();
+
+    /**
+     * @brief Returns this cardlist's card found at the given position, relative
+     * to the cardlist, if there is any
+     */
+    CardWidget* card_at(double x, double y);
+
+    /**
+     * @brief Returns this cardlist's card holding the keyboard focus, if there
+     * is any
+     */
+    CardWidget* focused_card();
+
+    /**
+     * @brief Moves a card from another cardlist into this one when either of
+     * them is virtualized. The data move is left to the received signal
+     * handlers, only the widgets of non-virtualized ends are adjusted here
+     */
+    void receive_virtual(CardWidget& card, CardWidget* sibling);
+
     void cleanup() override;
 
     // Widgets
@@ -116,7 +238,37 @@ protected:
     sigc::signal<void(CardWidget*, CardlistWidget*, CardWidget*)>
         m_card_received_signal;
 
+    // Virtualized mode signals. void(card_widget, card) is emitted when a
+    // widget starts representing a card, void(card_widget) when it stops, and
+    // void(title, sibling_index) when the user asks for a new card
+    sigc::signal<void(CardWidget*, std::shared_ptr<Card>)> m_card_bind_signal;
+    sigc::signal<void(CardWidget*)> m_card_unbind_signal;
+    sigc::signal<void(std::string, int)> m_card_request_signal;
+
+    // void(dormant), emitted once the cardlist fell asleep or woke up
+    sigc::signal<void(bool)> m_dormant_signal;
+
     // Data
     std::string m_name;
+
+    // Positions of the card widgets, kept in sync with m_root's children while
+    // the cardlist is not virtualized
+    PositionIndex<CardWidget*> m_card_positions;
+
+    // Virtualized mode
+    Glib::RefPtr<CardListModel> m_model;
+    Glib::RefPtr<Gtk::NoSelection> m_selection;
+    Gtk::ListView* m_list_view = nullptr;
+    bool m_dormant = false;
+    std::unordered_map<CardWidget*, std::shared_ptr<Card>> m_virtual_cards;
+
+    // Row bound to each card, the reverse of m_virtual_cards
+    std::unordered_map<Card*, CardWidget*> m_virtual_widgets;
+
+    /**
+     * @brief Returns the row bound to the card at a position of the model, or
+     * nullptr if that row is not bound
+     */
+    CardWidget* virtual_card_at(ssize_t position) const;
 };
 }  // namespace ui
@@ -0,0 +1,64 @@
+#include "cover-paintable.h"
+
+#include <gtkmm/snapshot.h>
+
+#include <cmath>
+#include <unordered_map>
+
+#include "cardlist-widget.h"
+
+namespace ui {
+
+namespace {
+std::unordered_map<guint32, Glib::RefPtr<CoverPaintable>>& cover_cache() {
+    static std::unordered_map<guint32, Glib::RefPtr<CoverPaintable>> cache;
+    return cache;
+}
+}  // namespace
+
+Glib::RefPtr<CoverPaintable> CoverPaintable::get(const Gdk::RGBA& color) {
+    const guint32 key = (guint32(color.get_red_u() >> 8) << 24) |
+                        (guint32(color.get_green_u() >> 8) << 16) |
+                        (guint32(color.get_blue_u() >> 8) << 8) | 0xFF;
+
+    auto& cache = cover_cache();
+    auto it = cache.find(key);
+    if (it == cache.end()) {
+        it = cache
+                 .emplace(key, Glib::make_refptr_for_instance<CoverPaintable>(
+                                   new CoverPaintable{color}))
+                 .first;
+    }
+    return it->second;
+}
+
+size_t CoverPaintable::cache_size() { return cover_cache().size(); }
+
+CoverPaintable::CoverPaintable(const Gdk::RGBA& color)
+    : Glib::ObjectBase{typeid(CoverPaintable)},
+      Glib::Object{},
+      Gdk::Paintable{},
+      m_color{color} {
+    m_color.set_alpha(1);
+}
+
+void CoverPaintable::snapshot_vfunc(const Glib::RefPtr<Gdk::Snapshot>& snapshot,
+                                    double width, double height) {
+    auto gtk_snapshot = std::dynamic_pointer_cast<Gtk::Snapshot>(snapshot);
+    if (gtk_snapshot) {
+        gtk_snapshot->append_color(
+            m_color, Gdk::Rectangle{0, 0, int(std::ceil(width)),
+                                    int(std::ceil(height))});
+    }
+}
+
+Gdk::Paintable::Flags CoverPaintable::get_flags_vfunc() const {
+    return Flags::STATIC_SIZE | Flags::STATIC_CONTENTS;
+}
+
+int CoverPaintable::get_intrinsic_width_vfunc() const {
+    return CardlistWidget::CARDLIST_MAX_WIDTH;
+}
+
+int CoverPaintable::get_intrinsic_height_vfunc() const { return COVER_HEIGHT; }
+}  // namespace ui
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <gdkmm/paintable.h>
+#include <gdkmm/rgba.h>
+#include <glibmm/object.h>
+
+namespace ui {
+
+/**
+ * @brief Solid color paintable used as a card's cover.
+ *
+ * @details Covers are drawn straight into the snapshot instead of being backed
+ * by a bitmap, and instances are shared process-wide: every card with the same
+ * cover color displays the same object.
+ */
+class CoverPaintable : public Glib::Object, public Gdk::Paintable {
+public:
+    static constexpr int COVER_HEIGHT = 30;
+
+    /**
+     * @brief Returns the shared cover for the given color. Covers are opaque,
+     * the color's alpha channel is ignored
+     */
+    static Glib::RefPtr<CoverPaintable> get(const Gdk::RGBA& color);
+
+    /**
+     * @brief Number of distinct covers created so far
+     */
+    static size_t cache_size();
+
+protected:
+    CoverPaintable(const Gdk::RGBA& color);
+
+    void snapshot_vfunc(const Glib::RefPtr<Gdk::Snapshot>& snapshot,
+                        double width, double height) override;
+    Flags get_flags_vfunc() const override;
+    int get_intrinsic_width_vfunc() const override;
+    int get_intrinsic_height_vfunc() const override;
+
+    Gdk::RGBA m_color;
+};
+}  // namespace ui
@@ -0,0 +1,200 @@
+#include "task-list-model.h"
+
+#include <algorithm>
+
+namespace ui {
+
+Glib::RefPtr<TaskObject> TaskObject::create(
+    const std::shared_ptr<Task>& task) {
+    return Glib::make_refptr_for_instance<TaskObject>(new TaskObject{task});
+}
+
+TaskObject::TaskObject(const std::shared_ptr<Task>& task)
+    : Glib::Object{}, m_task{task} {}
+
+const std::shared_ptr<Task>& TaskObject::task() const { return m_task; }
+
+Glib::RefPtr<TaskListModel> TaskListModel::create(
+    const std::shared_ptr<Card>& card) {
+    return Glib::make_refptr_for_instance<TaskListModel>(
+        new TaskListModel{card});
+}
+
+TaskListModel::TaskListModel(const std::shared_ptr<Card>& card)
+    : Glib::ObjectBase{typeid(TaskListModel)},
+      Glib::Object{},
+      Gio::ListModel{},
+      m_card{card} {
+    auto& container = m_card->container();
+    m_tasks = container.get_data();
+    m_items.resize(m_tasks.size());
+    for (const auto& task : m_tasks) {
+        m_positions.append(task.get());
+        track(task);
+    }
+
+    m_cnns.push_back(container.signal_append().connect(
+        sigc::mem_fun(*this, &TaskListModel::on_append)));
+    m_cnns.push_back(container.signal_insert().connect(
+        sigc::mem_fun(*this, &TaskListModel::on_insert)));
+    m_cnns.push_back(container.signal_remove().connect(
+        sigc::mem_fun(*this, &TaskListModel::on_remove)));
+    m_cnns.push_back(container.signal_reorder().connect(
+        sigc::mem_fun(*this, &TaskListModel::on_reorder)));
+    m_cnns.push_back(container.signal_move().connect(
+        sigc::mem_fun(*this, &TaskListModel::on_move)));
+}
+
+std::shared_ptr<Task> TaskListModel::get_task(guint position) const {
+    if (position >= m_tasks.size()) {
+        return nullptr;
+    }
+    return m_tasks[position];
+}
+
+ssize_t TaskListModel::find(const std::shared_ptr<Task>& task) const {
+    return m_positions.index_of(task.get());
+}
+
+guint TaskListModel::size() const { return m_tasks.size(); }
+
+guint TaskListModel::n_done() const { return m_n_done; }
+
+GType TaskListModel::get_item_type_vfunc() {
+    return Glib::Object::get_base_type();
+}
+
+guint TaskListModel::get_n_items_vfunc() { return m_tasks.size(); }
+
+gpointer TaskListModel::get_item_vfunc(guint position) {
+    if (position >= m_tasks.size()) {
+        return nullptr;
+    }
+
+    // List views compare rows by identity, so a wrapper is kept once created
+    if (!m_items[position]) {
+        m_items[position] = TaskObject::create(m_tasks[position]);
+    }
+    return m_items[position]->gobj_copy();
+}
+
+void TaskListModel::on_append(std::shared_ptr<Task> task) {
+    m_tasks.push_back(task);
+    m_items.emplace_back();
+    m_positions.append(task.get());
+    track(task);
+    items_changed(m_tasks.size() - 1, 0, 1);
+}
+
+void TaskListModel::on_insert(std::shared_ptr<Task> task, ssize_t index) {
+    m_tasks.insert(std::next(m_tasks.begin(), index), task);
+    m_items.insert(std::next(m_items.begin(), index), nullptr);
+    m_positions.insert(task.get(), index);
+    track(task);
+    items_changed(index, 0, 1);
+}
+
+void TaskListModel::on_remove(std::shared_ptr<Task> task) {
+    const ssize_t index = find(task);
+    if (index == -1) {
+        return;
+    }
+
+    m_tasks.erase(std::next(m_tasks.begin(), index));
+    m_items.erase(std::next(m_items.begin(), index));
+    m_positions.erase(task.get());
+    untrack(task);
+    items_changed(index, 1, 0);
+}
+
+void TaskListModel::on_reorder(std::shared_ptr<Task> next,
+                               std::shared_ptr<Task> sibling,
+                               ReorderingType type) {
+    if (type == ReorderingType::INVALID) {
+        return;
+    }
+
+    // The container put the task right next to its sibling
+    const ssize_t old_i = find(next);
+    const bool moved = type == ReorderingType::AFTER
+                           ? m_positions.move_after(next.get(), sibling.get())
+                           : m_positions.move_before(next.get(), sibling.get());
+    const ssize_t new_i = find(next);
+    if (!moved || old_i == new_i) {
+        return;
+    }
+
+    auto item = m_items[old_i];
+    m_tasks.erase(std::next(m_tasks.begin(), old_i));
+    m_tasks.insert(std::next(m_tasks.begin(), new_i), next);
+    m_items.erase(std::next(m_items.begin(), old_i));
+    m_items.insert(std::next(m_items.begin(), new_i), item);
+
+    const guint first = std::min(old_i, new_i);
+    const guint n_changed = std::max(old_i, new_i) - first + 1;
+    items_changed(first, n_changed, n_changed);
+}
+
+void TaskListModel::on_move(std::shared_ptr<Task> task,
+                            ItemContainer<Task>* from, ssize_t from_index,
+                            ItemContainer<Task>* to, ssize_t to_index) {
+    // The model mirrors the container, so positions are taken as they are
+    ItemContainer<Task>* container = &m_card->container();
+    if (from == container && to == container) {
+        auto item = m_items[from_index];
+        m_tasks.erase(std::next(m_tasks.begin(), from_index));
+        m_tasks.insert(std::next(m_tasks.begin(), to_index), task);
+        m_items.erase(std::next(m_items.begin(), from_index));
+        m_items.insert(std::next(m_items.begin(), to_index), item);
+        m_positions.erase(task.get());
+        m_positions.insert(task.get(), to_index);
+
+        const guint first = std::min(from_index, to_index);
+        const guint n_changed = std::max(from_index, to_index) - first + 1;
+        items_changed(first, n_changed, n_changed);
+    } else if (from == container) {
+        m_tasks.erase(std::next(m_tasks.begin(), from_index));
+        m_items.erase(std::next(m_items.begin(), from_index));
+        m_positions.erase(task.get());
+        untrack(task);
+        items_changed(from_index, 1, 0);
+    } else if (to == container) {
+        m_tasks.insert(std::next(m_tasks.begin(), to_index), task);
+        m_items.insert(std::next(m_items.begin(), to_index), nullptr);
+        m_positions.insert(task.get(), to_index);
+        track(task);
+        items_changed(to_index, 0, 1);
+    }
+}
+
+void TaskListModel::track(const std::shared_ptr<Task>& task) {
+    Tracked& tracked = m_tracked[task.get()];
+    tracked.done = task->get_done();
+    m_n_done += tracked.done;
+
+    // Tasks may be set to the state they already have
+    Task* task_ptr = task.get();
+    tracked.cnn = sigc::scoped_connection{
+        task->signal_done().connect([this, task_ptr](bool done) {
+            Tracked& entry = m_tracked.at(task_ptr);
+            if (entry.done == done) {
+                return;
+            }
+
+            entry.done = done;
+            if (done) {
+                m_n_done++;
+            } else {
+                m_n_done--;
+            }
+        })};
+}
+
+void TaskListModel::untrack(const std::shared_ptr<Task>& task) {
+    auto it = m_tracked.find(task.get());
+    if (it != m_tracked.end()) {
+        m_n_done -= it->second.done;
+        m_tracked.erase(it);
+    }
+}
+}  // namespace ui
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <core/card.h>
+#include <core/position-index.h>
+#include <giomm/listmodel.h>
+#include <glibmm/object.h>
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace ui {
+
+/**
+ * @brief Glib::Object wrapper around a Task so it can be handed out by a
+ * Gio::ListModel
+ */
+class TaskObject : public Glib::Object {
+public:
+    static Glib::RefPtr<TaskObject> create(const std::shared_ptr<Task>& task);
+
+    const std::shared_ptr<Task>& task() const;
+
+protected:
+    TaskObject(const std::shared_ptr<Task>& task);
+
+    std::shared_ptr<Task> m_task;
+};
+
+/**
+ * @brief Gio::ListModel adapter over the tasks of a Card.
+ *
+ * @details The model follows the card's container signals. Wrapper objects are
+ * only created for the rows a list view asks for, so building a model only
+ * copies the card's task pointers and indexes them. Positions are kept in a
+ * PositionIndex and done tasks are counted as they change, so neither find
+ * nor n_done walk the checklist.
+ */
+class TaskListModel : public Glib::Object, public Gio::ListModel {
+public:
+    static Glib::RefPtr<TaskListModel> create(
+        const std::shared_ptr<Card>& card);
+
+    /**
+     * @brief Returns the task at the given position, or nullptr if the
+     * position is out of range
+     */
+    std::shared_ptr<Task> get_task(guint position) const;
+
+    /**
+     * @brief Returns the position of the task in the model, or -1 if the task
+     * is not part of it. O(log n)
+     */
+    ssize_t find(const std::shared_ptr<Task>& task) const;
+
+    guint size() const;
+
+    /**
+     * @brief Returns how many of the model's tasks are done
+     */
+    guint n_done() const;
+
+protected:
+    TaskListModel(const std::shared_ptr<Card>& card);
+
+    GType get_item_type_vfunc() override;
+    guint get_n_items_vfunc() override;
+    gpointer get_item_vfunc(guint position) override;
+
+    void on_append(std::shared_ptr<Task> task);
+    void on_insert(std::shared_ptr<Task> task, ssize_t index);
+    void on_remove(std::shared_ptr<Task> task);
+    void on_reorder(std::shared_ptr<Task> next, std::shared_ptr<Task> sibling,
+                    ReorderingType type);
+    void on_move(std::shared_ptr<Task> task, ItemContainer<Task>* from,
+                 ssize_t from_index, ItemContainer<Task>* to,
+                 ssize_t to_index);
+
+    /**
+     * @brief Starts (or stops) counting a task of the model in n_done
+     */
+    void track(const std::shared_ptr<Task>& task);
+    void untrack(const std::shared_ptr<Task>& task);
+
+    struct Tracked {
+        bool done = false;
+        sigc::scoped_connection cnn;
+    };
+
+    std::shared_ptr<Card> m_card;
+    std::vector<std::shared_ptr<Task>> m_tasks;
+    PositionIndex<Task*> m_positions;
+
+    // Done state of every task as last counted
+    std::unordered_map<Task*, Tracked> m_tracked;
+    guint m_n_done = 0;
+
+    // Wrappers of the rows requested so far, nullptr for the others
+    std::vector<Glib::RefPtr<TaskObject>> m_items;
+    std::vector<sigc::scoped_connection> m_cnns;
+};
+}  // namespace ui
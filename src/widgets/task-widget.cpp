@@ -152,11 +152,8 @@ TaskWidget::TaskWidget(CardDialog& card_details_dialog, const std::string& name,
               return true;
           }},
          {"<Control>N",
-          [&card_details_dialog, this](Gtk::Widget&, const Glib::VariantBase&) {
-              auto new_task =
-                  Gtk::make_managed<TaskWidget>(m_card_dialog, _("New Task"));
-              card_details_dialog.insert_after(*new_task, *this);
-              new_task->grab_focus();
+          [this](Gtk::Widget&, const Glib::VariantBase&) {
+              m_card_dialog.add_task(_("New Task"), this);
               return true;
           }},
          {"<Control>Delete",
@@ -171,10 +168,9 @@ TaskWidget::TaskWidget(CardDialog& card_details_dialog, const std::string& name,
           }},
          {"<Control>Up",
           [this](Gtk::Widget&, const Glib::VariantBase&) {
-              Gtk::Widget* previous = this->get_prev_sibling();
-              if (previous) {
-                  TaskWidget& prev_task = *static_cast<TaskWidget*>(previous);
-                  this->m_card_dialog.reorder(prev_task, *this);
+              // The moved task keeps the focus, so it is the one reordered
+              if (TaskWidget* previous = m_card_dialog.prev_task(*this)) {
+                  this->m_card_dialog.reorder(*this, *previous);
               } else {
                   this->error_bell();
               }
@@ -182,11 +178,8 @@ TaskWidget::TaskWidget(CardDialog& card_details_dialog, const std::string& name,
           }},
          {"<Control>Down",
           [this](Gtk::Widget&, const Glib::VariantBase&) {
-              Gtk::Widget* next = this->get_next_sibling();
-              if (!G_TYPE_CHECK_INSTANCE_TYPE(next->gobj(),
-                                              Gtk::Button::get_type())) {
-                  TaskWidget& next_task = *static_cast<TaskWidget*>(next);
-                  this->m_card_dialog.reorder(*this, next_task);
+              if (TaskWidget* next = m_card_dialog.next_task(*this)) {
+                  this->m_card_dialog.reorder(*this, *next);
               } else {
                   this->error_bell();
               }
@@ -227,6 +220,27 @@ TaskWidget::TaskWidget(CardDialog& card_details_dialog, const std::string& name,
     setup_drag_and_drop();
 }
 
+void TaskWidget::reset(const std::string& title, bool complete) {
+    m_name_changed_signal.clear();
+    m_complete_changed_signal.clear();
+
+    m_card_widget = m_card_dialog.card_widget();
+    m_title = title;
+    m_entry_revealer.set_reveal_child(false);
+    m_label.set_visible(true);
+    set_opacity(1);
+
+    // No one is listening anymore, the toggled handler only updates the label
+    m_checkbutton.set_active(complete);
+    if (complete) {
+        add_css_class("complete-task");
+        m_label.set_markup(std::format("<s>{}</s>", title));
+    } else {
+        remove_css_class("complete-task");
+        m_label.set_label(title);
+    }
+}
+
 void TaskWidget::set_title(const std::string& title) {
     if (!title.empty()) {
         const std::string old_title = m_title;
@@ -298,9 +312,7 @@ void TaskWidget::on_checkbox() {
 
 void TaskWidget::on_convert() {
     auto cardlist_widget = const_cast<CardlistWidget*>(m_card_widget->parent());
-    auto task_as_card = Gtk::make_managed<CardWidget>(m_title);
-
-    cardlist_widget->insert_after(*task_as_card, *m_card_widget);
+    cardlist_widget->add_card(m_title, m_card_widget);
     m_card_dialog.remove_task(*this);
 }
 
@@ -36,6 +36,13 @@ public:
     TaskWidget(CardDialog& card_details_dialog, const std::string& title,
                bool complete = false);
 
+    /**
+     * @brief Makes the widget represent another task of the card currently
+     * opened in the card dialog. Every connection made to the widget's signals
+     * is dropped
+     */
+    void reset(const std::string& title, bool complete = false);
+
     void set_title(const std::string& title);
     void set_complete(bool complete = true);
 
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <gtkmm.h>
+
+#include <functional>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ui {
+
+/**
+ * @brief Keeps widgets alive across board sessions so they can be rebound to
+ * other model objects instead of being rebuilt.
+ *
+ * @details Widgets created by the pool are not managed: the pool owns them for
+ * its whole lifetime and they survive being removed from their parents.
+ * Callers are expected to reset an acquired widget before using it. Widgets
+ * that were not created by the pool are ignored by release.
+ *
+ * Released widgets are only destroyed by trim(), which brings them down to the
+ * pool's limit.
+ */
+template <typename T>
+class WidgetPool {
+public:
+    /**
+     * @param factory creates a new widget whenever no released one is
+     * available
+     * @param max_free largest number of released widgets kept by trim()
+     */
+    WidgetPool(std::function<T*()> factory,
+               size_t max_free = std::numeric_limits<size_t>::max())
+        : m_factory{factory}, m_max_free{max_free} {}
+
+    ~WidgetPool() {
+        for (auto& [widget, owned] : m_widgets) {
+            if (widget->get_parent()) {
+                widget->unparent();
+            }
+        }
+    }
+
+    /**
+     * @brief Returns a released widget, or a new one if there is none left.
+     * Reused widgets are taken out of their previous parent
+     */
+    T* acquire() {
+        if (m_free.empty()) {
+            T* widget = m_factory();
+            m_widgets.emplace(widget, std::unique_ptr<T>{widget});
+            m_in_use[widget] = true;
+            m_created++;
+            return widget;
+        }
+
+        T* widget = m_free.back();
+        m_free.pop_back();
+        m_in_use[widget] = true;
+        if (widget->get_parent()) {
+            widget->unparent();
+        }
+        m_reused++;
+        return widget;
+    }
+
+    /**
+     * @brief Hands a widget back to the pool. The widget may still be
+     * parented, it is only taken out of its parent once acquired again
+     */
+    void release(T* widget) {
+        auto it = m_in_use.find(widget);
+        if (it != m_in_use.end() && it->second) {
+            it->second = false;
+            m_free.push_back(widget);
+        }
+    }
+
+    /**
+     * @brief Destroys the released widgets beyond the pool's limit, so the
+     * widgets of a large session are not kept for the rest of the process.
+     * They are taken out of their parents first
+     *
+     * @return the number of destroyed widgets
+     */
+    size_t trim() {
+        size_t n_destroyed = 0;
+        while (m_free.size() > m_max_free) {
+            T* widget = m_free.back();
+            m_free.pop_back();
+            m_in_use.erase(widget);
+            if (widget->get_parent()) {
+                widget->unparent();
+            }
+            m_widgets.erase(widget);
+            n_destroyed++;
+        }
+        return n_destroyed;
+    }
+
+    /**
+     * @brief Returns the number of widgets owned by the pool, in use or not
+     */
+    size_t size() const { return m_widgets.size(); }
+
+    /**
+     * @brief Returns how many widgets have been created and reused since the
+     * last call
+     */
+    std::pair<size_t, size_t> take_counts() {
+        auto counts = std::make_pair(m_created, m_reused);
+        m_created = m_reused = 0;
+        return counts;
+    }
+
+protected:
+    std::function<T*()> m_factory;
+    const size_t m_max_free;
+    std::unordered_map<T*, std::unique_ptr<T>> m_widgets;
+    std::vector<T*> m_free;
+    std::unordered_map<T*, bool> m_in_use;
+    size_t m_created = 0, m_reused = 0;
+};
+}  // namespace ui
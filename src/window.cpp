@@ -8,6 +8,8 @@
 #include <glibmm/i18n.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/spdlog.h>
+#include <utils.h>
+#include <widgets/card-filter-popover.h>
 #include <widgets/card-widget.h>
 
 #include <format>
@@ -26,10 +28,13 @@ ProgressWindow::ProgressWindow(BaseObjectType* cobject,
       board_delete_button{b->get_widget<Gtk::Button>("delete-button")},
       cancel_delete_button{b->get_widget<Gtk::Button>("cancel-delete-button")},
       app_stack_p{b->get_widget<Gtk::Stack>("app-stack")},
-      boards_grid_p{b->get_widget<Gtk::FlowBox>("boards-grid")},
+      boards_grid_p{b->get_widget<Gtk::GridView>("boards-grid")},
       board_grid_menu_p{b->get_object<Gio::MenuModel>("board-grid-menu")},
       board_menu_p{b->get_object<Gio::MenuModel>("board-menu")},
       app_menu_button_p{b->get_widget<Gtk::MenuButton>("app-menu-button")},
+      m_filter_button{b->get_widget<Gtk::MenuButton>("filter-button")},
+      m_board_stats_label{b->get_widget<Gtk::Label>("board-stats-label")},
+      m_card_filter_popover{new CardFilterPopover{}},
       m_spinner{b->get_widget<Gtk::Spinner>("spinner")},
       m_spinner_revealer{b->get_widget<Gtk::Revealer>("spinner-revealer")},
       adw_style_manager{
@@ -45,6 +50,7 @@ ProgressWindow::ProgressWindow(BaseObjectType* cobject,
       edit_board{PreferencesBoardDialog::create(board_widget)},
       sh_window{b->get_widget<Gtk::ShortcutsWindow>("progress-shortcuts")} {
     app_stack_p->set_visible_child("board-grid-page");
+    m_filter_button->set_popover(*m_card_filter_popover);
 
     m_context = new AppContext{*this, board_widget, m_manager};
     Gtk::StyleProvider::add_provider_for_display(
@@ -55,21 +61,7 @@ ProgressWindow::ProgressWindow(BaseObjectType* cobject,
     // AdwApplicationWindow, not a GtkApplicationWindow
     this->signal_close_request().connect(
         sigc::mem_fun(*this, &ProgressWindow::on_close), true);
-    boards_grid_p->signal_selected_children_changed().connect(
-        sigc::track_object(
-            [this]() {
-                const int size =
-                    this->boards_grid_p->get_selected_children().size();
-                if (size > 0) {
-                    std::string selected_text = ngettext(
-                        "{} board selected", "{} boards selected", size);
-                    set_title(std::vformat(selected_text,
-                                           std::make_format_args(size)));
-                } else {
-                    set_title(_("No board has been selected yet"));
-                }
-            },
-            *this));
+    setup_boards_grid();
 
     board_delete_button->signal_clicked().connect(
         sigc::mem_fun(*this, &ProgressWindow::delete_selected_boards));
@@ -131,8 +123,9 @@ ProgressWindow::ProgressWindow(BaseObjectType* cobject,
                        }},
         WindowShortcut{"<Control>H",
                        [this](Gtk::Widget&, const Glib::VariantBase&) {
-                           if (app_stack_p->get_visible_child_name() ==
-                               "board-page") {
+                           const Glib::ustring page =
+                               app_stack_p->get_visible_child_name();
+                           if (page == "board-page" || page == "agenda-page") {
                                this->on_main_menu();
                            }
                            return true;
@@ -161,20 +154,6 @@ ProgressWindow::ProgressWindow(BaseObjectType* cobject,
         [this]() { create_board->open(*this); });
     setup_menu_button();
 
-    boards_grid_p->set_sort_func([](Gtk::FlowBoxChild* child1,
-                                    Gtk::FlowBoxChild* child2) {
-        ui::BoardCardButton* bcb1 = (ui::BoardCardButton*)child1->get_child();
-        ui::BoardCardButton* bcb2 = (ui::BoardCardButton*)child2->get_child();
-
-        if (*bcb1 > *bcb2) {
-            return -1;
-        } else if (*bcb1 < *bcb2) {
-            return 1;
-        } else {
-            return 0;
-        }
-    });
-
     m_manager.signal_add_board().connect(
         sigc::mem_fun(*this, &ProgressWindow::add_board_handler));
     m_manager.signal_remove_board().connect(
@@ -184,53 +163,23 @@ ProgressWindow::ProgressWindow(BaseObjectType* cobject,
 
     sh_window->set_application(this->get_application());
 
-    // The default behaviour of Gtk::FlowBox whenever an user tries to navigate
-    // through the container using the arrow keys is to select the next child in
-    // the container. If the user wants to navigate through container using only
-    // the keyboard arrows, they would have to press and hold the Ctrl key,which
-    // is not comfortable. To work around this issue, we override the default
-    // key controller event
-    auto board_grid_controller = Gtk::EventControllerKey::create();
-    board_grid_controller->set_propagation_phase(
-        Gtk::PropagationPhase::CAPTURE);
-    board_grid_controller->signal_key_pressed().connect(
-        [this](guint keyval, guint keycode, Gdk::ModifierType state) {
-            // If the user is holding Ctrl, Shift, or Alt, let GTK handle it
-            // normally
-            if (((state == Gdk::ModifierType::SHIFT_MASK) ||
-                 (state == Gdk::ModifierType::CONTROL_MASK) ||
-                 (state == Gdk::ModifierType::ALT_MASK))) {
-                return false;
-            }
-
-            Gtk::DirectionType dir;
-            switch (keyval) {
-                case GDK_KEY_Left:
-                    dir = Gtk::DirectionType::LEFT;
-                    break;
-                case GDK_KEY_Right:
-                    dir = Gtk::DirectionType::RIGHT;
-                    break;
-                case GDK_KEY_Up:
-                    dir = Gtk::DirectionType::UP;
-                    break;
-                case GDK_KEY_Down:
-                    dir = Gtk::DirectionType::DOWN;
-                    break;
-                default:
-                    return false;
-            }
-            boards_grid_p->child_focus(dir);
-            return true;
-        },
-        false);
-    boards_grid_p->add_controller(board_grid_controller);
-
     app_stack_p->add(board_widget, "board-page");
+    app_stack_p->add(m_agenda_view, "agenda-page");
+    m_agenda_view.signal_board_activated().connect(
+        sigc::mem_fun(*this, &ProgressWindow::open_board));
+    m_indexed_dispatcher.connect(
+        sigc::mem_fun(*this, &ProgressWindow::on_boards_indexed));
+    m_indexed_cnn = m_manager.signal_indexed().connect(
+        [this]() { m_indexed_dispatcher.emit(); });
 }
 
 ProgressWindow::~ProgressWindow() {
     delete m_context;
+    if (m_card_popover) {
+        m_card_popover->detach();
+        m_card_popover->unreference();
+    }
+    delete m_card_filter_popover;
 
     delete create_board;
     delete edit_board;
@@ -240,71 +189,33 @@ ProgressWindow::~ProgressWindow() {
 
 void ProgressWindow::add_board_handler(LocalBoard board_entry) {
     add_local_board_entry(board_entry);
-    boards_grid_p->invalidate_sort();
 }
 
-// FIXME: We could actually keep track of the boardcardbuttons added instead of
-// searching linearly. This may be optmised to an amortised O(1)
-
-#if GTKMM_CHECK_VERSION(4, 14, 0)
-void ProgressWindow::remove_board_handler(LocalBoard board_entry) {
-    for (Widget* fb_child : boards_grid_p->get_children()) {
-        BoardCardButton* cur = static_cast<BoardCardButton*>(
-            static_cast<Gtk::FlowBoxChild*>(fb_child)->get_child());
-
-        if (cur->get_board() == board_entry.board) {
-            boards_grid_p->remove(*cur);
-        }
-    }
-}
-#else
 void ProgressWindow::remove_board_handler(LocalBoard board_entry) {
-    for (BoardCardButton* entry_button : entry_buttons) {
-        if (entry_button->get_board() == board_entry.board) {
-            boards_grid_p->remove(*entry_button);
-        }
-    }
+    m_boards_model->remove(board_entry.board);
 }
-#endif
 
 void ProgressWindow::save_board_handler(LocalBoard board) {
-    boards_grid_p->invalidate_sort();
+    // Saving refreshes the board's modification time, so it is moved to the
+    // front of the overview
+    m_boards_model->update(board.board);
 }
 
 void ProgressWindow::add_local_board_entry(LocalBoard board_entry) {
-    auto board_card_button = Gtk::make_managed<BoardCardButton>(board_entry);
-    auto fb_child_p = Gtk::make_managed<Gtk::FlowBoxChild>();
-    fb_child_p->set_child(*board_card_button);
-    fb_child_p->set_valign(Gtk::Align::CENTER);
-    fb_child_p->set_halign(Gtk::Align::CENTER);
-    fb_child_p->set_focusable(false);
-    boards_grid_p->append(*fb_child_p);
-    board_card_button->signal_clicked().connect(
-        [this, board_entry, board_card_button, fb_child_p]() {
-            if (!this->on_delete_mode) {
-                app_stack_p->set_visible_child(
-                    "loading-page", Gtk::StackTransitionType::CROSSFADE);
-                add_board_button_p->set_sensitive(false);
-                app_menu_button_p->set_sensitive(false);
-
-                this->m_context->open_session(board_entry.filename);
-            } else {
-                if (fb_child_p->is_selected()) {
-                    boards_grid_p->unselect_child(*fb_child_p);
-                } else {
-                    boards_grid_p->select_child(*fb_child_p);
-                }
-            }
-        });
+    m_boards_model->insert(board_entry);
+}
 
-#if not GTKMM_CHECK_VERSION(4, 14, 0)
-    entry_buttons.push_back(board_card_button);
-#endif
+void ProgressWindow::load_local_boards() {
+    m_loading_boards = true;
+    queue_board_page();
+
+    for (const std::string& folder : m_manager.local_folders()) {
+        watch_board_folder(folder);
+    }
 }
 
 void ProgressWindow::on_delete_board_mode() {
     on_delete_mode = true;
-    boards_grid_p->set_selection_mode(Gtk::SelectionMode::MULTIPLE);
 
     set_title(_("No board has been selected yet"));
 
@@ -321,7 +232,7 @@ void ProgressWindow::on_delete_board_mode() {
 
 void ProgressWindow::off_delete_board_mode() {
     on_delete_mode = false;
-    boards_grid_p->set_selection_mode(Gtk::SelectionMode::NONE);
+    m_boards_selection->unselect_all();
 
     cancel_delete_button_revealer->set_reveal_child(false);
     delete_button_revealer->set_reveal_child(false);
@@ -344,7 +255,10 @@ void ProgressWindow::on_main_menu() {
     sh_window->property_view_name().set_value("board-grid-view");
     app_menu_button_p->set_menu_model(board_grid_menu_p);
     home_button_p->set_visible(false);
+    m_filter_button->set_visible(false);
+    m_board_stats_label->set_visible(false);
     add_board_button_p->set_visible();
+    app_menu_button_p->set_visible();
 
     add_board_button_p->set_sensitive();
     app_menu_button_p->set_sensitive();
@@ -356,22 +270,70 @@ void ProgressWindow::on_board_view() {
     sh_window->property_view_name().set_value("board-view");
     app_menu_button_p->set_menu_model(board_menu_p);
     home_button_p->set_visible();
+    m_filter_button->set_visible();
+    m_board_stats_label->set_visible();
     add_board_button_p->set_visible(false);
+    app_menu_button_p->set_visible();
 
     add_board_button_p->set_sensitive(true);
     app_menu_button_p->set_sensitive(true);
 }
 
-// FIXME: This super inefficient because we're running at almost O(n²)
+void ProgressWindow::on_agenda_view() {
+    update_agenda();
+
+    app_stack_p->set_visible_child("agenda-page");
+    home_button_p->set_visible();
+    add_board_button_p->set_visible(false);
+    app_menu_button_p->set_visible(false);
+    set_title(_("Agenda"));
+}
+
+void ProgressWindow::update_agenda() {
+    const Date today = local_today();
+    const auto start = std::chrono::steady_clock::now();
+    m_agenda_view.set_agenda(
+        m_manager.agenda(today, AgendaView::UPCOMING_DAYS), today);
+    m_agenda_view.set_indexing(!m_manager.agenda_ready());
+    spdlog::get("app")->debug(
+        "[ProgressWindow.update_agenda] Agenda shown in {}us",
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count());
+}
+
+void ProgressWindow::on_boards_indexed() {
+    if (app_stack_p->get_visible_child_name() == "agenda-page") {
+        update_agenda();
+    }
+}
+
+void ProgressWindow::open_board(const std::string& filename) {
+    app_stack_p->set_visible_child("loading-page",
+                                   Gtk::StackTransitionType::CROSSFADE);
+    home_button_p->set_visible(false);
+    add_board_button_p->set_visible();
+    app_menu_button_p->set_visible();
+    add_board_button_p->set_sensitive(false);
+    app_menu_button_p->set_sensitive(false);
+
+    m_context->open_session(filename);
+}
+
 void ProgressWindow::delete_selected_boards() {
-    auto selected_children = boards_grid_p->get_selected_children();
-    for (auto& child : selected_children) {
-        ui::BoardCardButton* cur_child =
-            (ui::BoardCardButton*)child->get_child();
-        m_manager.local_remove(cur_child->get_board());
+    // Positions change as boards are removed, so the boards are collected
+    // first
+    auto selection = m_boards_selection->get_selection();
+    std::vector<std::shared_ptr<Board>> selected_boards;
+    for (guint64 i = 0; i < selection->get_size(); i++) {
+        selected_boards.push_back(
+            m_boards_model->get_board(selection->get_nth(i)));
     }
 
     off_delete_board_mode();
+    for (const auto& board : selected_boards) {
+        m_manager.local_remove(board);
+    }
 }
 
 void ProgressWindow::set_spinner_visible(bool visible) {
@@ -379,6 +341,19 @@ void ProgressWindow::set_spinner_visible(bool visible) {
     m_spinner->set_spinning(visible);
 }
 
+void ProgressWindow::set_load_progress(double fraction) {
+    if (fraction < 1) {
+        const int percentage = fraction * 100;
+        set_spinner_visible();
+        m_spinner->set_tooltip_text(
+            std::vformat(_("Loading board ({}%)"),
+                         std::make_format_args(percentage)));
+    } else {
+        set_spinner_visible(false);
+        m_spinner->set_tooltip_text("");
+    }
+}
+
 void ProgressWindow::show_about_dialog() {
     adw_show_about_dialog(
         GTK_WIDGET(this->gobj()), "application-name", "Progress",
@@ -396,6 +371,34 @@ void ProgressWindow::show_shortcuts_dialog() { sh_window->set_visible(); }
 
 CardDialog& ProgressWindow::card_dialog() { return m_card_dialog; }
 
+CardPopover& ProgressWindow::card_popover() {
+    if (!m_card_popover) {
+        // Cards hand the popover over to each other, so it is kept alive
+        // while no card holds it
+        m_card_popover = Gtk::make_managed<CardPopover>();
+        m_card_popover->reference();
+    }
+    return *m_card_popover;
+}
+
+CardFilterPopover& ProgressWindow::card_filter_popover() {
+    return *m_card_filter_popover;
+}
+
+void ProgressWindow::set_board_stats(
+    const CardStats& stats,
+    const std::vector<std::pair<std::string, CardStats>>& cardlists) {
+    m_board_stats_label->set_markup(card_stats_markup(stats));
+
+    std::string details;
+    for (const auto& [name, cardlist_stats] : cardlists) {
+        details += std::format("{}<b>{}</b>\n{}", details.empty() ? "" : "\n",
+                               Glib::Markup::escape_text(name).raw(),
+                               card_stats_markup(cardlist_stats));
+    }
+    m_board_stats_label->set_tooltip_markup(details);
+}
+
 void ProgressWindow::setup_menu_button() {
     auto action_group = Gio::SimpleActionGroup::create();
     action_group->add_action(
@@ -407,10 +410,165 @@ void ProgressWindow::setup_menu_button() {
         "delete", sigc::mem_fun(*this, &ProgressWindow::on_delete_board_mode));
     action_group->add_action("preferences",
                              [this]() { edit_board->open(*this); });
+    action_group->add_action(
+        "agenda", sigc::mem_fun(*this, &ProgressWindow::on_agenda_view));
 
     app_menu_button_p->insert_action_group("win", action_group);
 }
 
+void ProgressWindow::setup_boards_grid() {
+    m_boards_model = BoardListModel::create();
+    m_boards_selection = Gtk::MultiSelection::create(m_boards_model);
+    m_boards_selection->signal_selection_changed().connect(
+        [this](guint, guint) {
+            if (!on_delete_mode) {
+                return;
+            }
+
+            const int size = m_boards_selection->get_selection()->get_size();
+            if (size > 0) {
+                std::string selected_text = ngettext(
+                    "{} board selected", "{} boards selected", size);
+                set_title(
+                    std::vformat(selected_text, std::make_format_args(size)));
+            } else {
+                set_title(_("No board has been selected yet"));
+            }
+        });
+
+    auto factory = Gtk::SignalListItemFactory::create();
+    factory->signal_setup().connect(
+        [this](const Glib::RefPtr<Gtk::ListItem>& list_item) {
+            // Boards are only selected through their buttons, in delete mode
+            list_item->set_activatable(false);
+            list_item->set_selectable(false);
+
+            auto board_card_button = Gtk::make_managed<BoardCardButton>();
+            board_card_button->signal_clicked().connect(
+                [this, board_card_button, list_item = list_item.get()]() {
+                    const LocalBoard& board_entry =
+                        board_card_button->get_local_board();
+                    if (!board_entry.board) {
+                        return;
+                    }
+
+                    if (!this->on_delete_mode) {
+                        open_board(board_entry.filename);
+                    } else if (list_item->get_selected()) {
+                        m_boards_selection->unselect_item(
+                            list_item->get_position());
+                    } else {
+                        m_boards_selection->select_item(
+                            list_item->get_position(), false);
+                    }
+                });
+            list_item->set_child(*board_card_button);
+        });
+    factory->signal_bind().connect(
+        [this](const Glib::RefPtr<Gtk::ListItem>& list_item) {
+            auto board_card_button =
+                static_cast<BoardCardButton*>(list_item->get_child());
+            auto board_object =
+                std::dynamic_pointer_cast<BoardObject>(list_item->get_item());
+            if (board_card_button && board_object) {
+                board_card_button->set_local_board(
+                    board_object->local_board());
+                board_card_button->set_stats(m_manager.local_stats(
+                    board_object->local_board(), local_today()));
+            }
+        });
+    factory->signal_unbind().connect(
+        [](const Glib::RefPtr<Gtk::ListItem>& list_item) {
+            if (auto board_card_button =
+                    static_cast<BoardCardButton*>(list_item->get_child())) {
+                board_card_button->unset_local_board();
+            }
+        });
+
+    boards_grid_p->set_factory(factory);
+    boards_grid_p->set_model(m_boards_selection);
+
+    // Scrolling and new rows may leave too few boards below the visible ones
+    auto vadjustment = boards_grid_p->get_vadjustment();
+    vadjustment->signal_value_changed().connect(
+        sigc::mem_fun(*this, &ProgressWindow::queue_board_page));
+    vadjustment->signal_changed().connect(
+        sigc::mem_fun(*this, &ProgressWindow::queue_board_page));
+}
+
+void ProgressWindow::queue_board_page() {
+    if (!m_loading_boards || m_board_page_cnn.connected()) {
+        return;
+    }
+
+    m_board_page_cnn = Glib::signal_idle().connect(
+        sigc::mem_fun(*this, &ProgressWindow::load_board_page));
+}
+
+bool ProgressWindow::load_board_page() {
+    auto vadjustment = boards_grid_p->get_vadjustment();
+    const double below = vadjustment->get_upper() -
+                         (vadjustment->get_value() +
+                          vadjustment->get_page_size());
+    if (vadjustment->get_page_size() > 0 &&
+        below > vadjustment->get_page_size()) {
+        return false;
+    }
+
+    auto page = m_manager.local_next_page(BOARDS_PAGE_SIZE);
+    if (page.empty()) {
+        m_loading_boards = false;
+        spdlog::get("app")->debug(
+            "[ProgressWindow.load_board_page] All {} local boards are shown",
+            m_boards_model->size());
+        return false;
+    }
+
+    m_boards_model->insert(page);
+    return false;
+}
+
+void ProgressWindow::watch_board_folder(const std::string& folder) {
+    auto monitor = Gio::File::create_for_path(folder)->monitor_directory(
+        Gio::FileMonitorFlags::WATCH_MOVES);
+    monitor->signal_changed().connect(
+        [this](const Glib::RefPtr<Gio::File>& file,
+               const Glib::RefPtr<Gio::File>& other_file,
+               Gio::FileMonitor::Event event) {
+            using Event = Gio::FileMonitor::Event;
+            const auto report = [this](const Glib::RefPtr<Gio::File>& file) {
+                if (file && file->get_basename().ends_with(".xml")) {
+                    m_manager.local_changed(file->get_path());
+                }
+            };
+
+            switch (event) {
+                case Event::CREATED:
+                    if (file->get_basename().size() ==
+                            BoardManager::SHARD_PREFIX_LENGTH &&
+                        file->query_file_type() == Gio::FileType::DIRECTORY) {
+                        watch_board_folder(file->get_path());
+                    }
+                    break;
+                // Boards are written in several steps, only the last one is
+                // reported
+                case Event::CHANGES_DONE_HINT:
+                case Event::DELETED:
+                case Event::MOVED_IN:
+                case Event::MOVED_OUT:
+                    report(file);
+                    break;
+                case Event::RENAMED:
+                    report(file);
+                    report(other_file);
+                    break;
+                default:
+                    break;
+            }
+        });
+    m_board_monitors.push_back(monitor);
+}
+
 void ProgressWindow::load_appropriate_style() {
     if (adw_style_manager_get_dark(adw_style_manager)) {
         css_provider->load_from_resource(ProgressWindow::STYLE_DARK_CSS);
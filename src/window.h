@@ -2,7 +2,9 @@
 
 #include <adwaita.h>
 #include <gtkmm.h>
+#include <widgets/agenda-view.h>
 #include <widgets/board-card-button.h>
+#include <widgets/board-list-model.h>
 #include <widgets/board-widget.h>
 
 #include "core/board-manager.h"
@@ -14,6 +16,8 @@ class AppContext;
 namespace ui {
 
 class BoardWidget;
+class CardFilterPopover;
+class CardPopover;
 class CreateBoardDialog;
 class PreferencesBoardDialog;
 
@@ -34,6 +38,11 @@ public:
     static constexpr const char* CREATE_BOARD_DIALOG =
         "/io/github/smolblackcat/Progress/create-board-dialog.ui";
 
+    /**
+     * @brief Number of local boards read at a time for the board overview
+     */
+    static constexpr size_t BOARDS_PAGE_SIZE = 48;
+
     /**
      * @brief Constructs a ProgressWindow object.
      *
@@ -61,6 +70,13 @@ public:
      */
     void add_local_board_entry(LocalBoard board_entry);
 
+    /**
+     * @brief Shows the local boards in the overview. Boards are read page by
+     * page as the overview is scrolled towards its end. Board files changed
+     * from then on are reported to the board manager
+     */
+    void load_local_boards();
+
     /**
      * @brief Enters deletion mode, where the user will select all boards to be
      * deleted.
@@ -82,6 +98,17 @@ public:
      */
     void on_board_view();
 
+    /**
+     * @brief Changes the application view to the agenda of every board. The
+     * agenda is read from the boards' due date summaries
+     */
+    void on_agenda_view();
+
+    /**
+     * @brief Shows the loading page and opens the board in filename
+     */
+    void open_board(const std::string& filename);
+
     /**
      * @brief Deletes all selected boards if window is in delete mode.
      */
@@ -93,11 +120,40 @@ public:
      */
     void set_spinner_visible(bool visible = true);
 
+    /**
+     * @brief Reports how much of the current board has been loaded through
+     * the window's spinner. The spinner is hidden once fraction reaches 1
+     *
+     * @param fraction loaded fraction, between 0 and 1
+     */
+    void set_load_progress(double fraction);
+
     void show_about_dialog();
     void show_shortcuts_dialog();
 
     CardDialog& card_dialog();
 
+    /**
+     * @brief Returns the popover menu shared by every card in this window. It
+     * is created on first use
+     */
+    CardPopover& card_popover();
+
+    /**
+     * @brief Returns the popover filtering the cards of the open board
+     */
+    CardFilterPopover& card_filter_popover();
+
+    /**
+     * @brief Shows the statistics of the open board in the header bar
+     *
+     * @param cardlists name and statistics of every list of the board, shown
+     * when hovering the board's statistics
+     */
+    void set_board_stats(
+        const CardStats& stats,
+        const std::vector<std::pair<std::string, CardStats>>& cardlists);
+
 protected:
     BoardManager& m_manager;
     AppContext* m_context;
@@ -111,6 +167,7 @@ protected:
     // Widgets
     AdwStyleManager* adw_style_manager;
     ui::BoardWidget board_widget;
+    ui::AgendaView m_agenda_view;
     Gtk::ShortcutsWindow* sh_window;
     Gtk::Button *home_button_p, *add_board_button_p, *board_delete_button,
         *cancel_delete_button;
@@ -118,22 +175,65 @@ protected:
         *m_spinner_revealer;
     Gtk::Spinner* m_spinner;
     Gtk::Stack* app_stack_p;
-    Gtk::FlowBox* boards_grid_p;
+    Gtk::GridView* boards_grid_p;
+    Glib::RefPtr<BoardListModel> m_boards_model;
+    Glib::RefPtr<Gtk::MultiSelection> m_boards_selection;
+    sigc::connection m_board_page_cnn;
+    bool m_loading_boards = false;
+    std::vector<Glib::RefPtr<Gio::FileMonitor>> m_board_monitors;
     Glib::RefPtr<Gio::MenuModel> board_grid_menu_p, board_menu_p;
-    Gtk::MenuButton* app_menu_button_p;
+    Gtk::MenuButton *app_menu_button_p, *m_filter_button;
+    Gtk::Label* m_board_stats_label;
 
-#if not GTKMM_CHECK_VERSION(4, 14, 0)
-    std::vector<BoardCardButton*> entry_buttons;
-#endif
+    // Forwards the manager's signal_indexed() from its loading thread
+    Glib::Dispatcher m_indexed_dispatcher;
+    sigc::scoped_connection m_indexed_cnn;
 
     BoardDialog *create_board, *edit_board;
     CardDialog m_card_dialog;
+    CardPopover* m_card_popover = nullptr;
+    CardFilterPopover* m_card_filter_popover;
 
     /**
      * @brief Sets up the menu button.
      */
     void setup_menu_button();
 
+    /**
+     * @brief Sets up the board overview. Board buttons are only created for
+     * the visible boards and are reused while scrolling
+     */
+    void setup_boards_grid();
+
+    /**
+     * @brief Schedules the reading of the next page of local boards
+     */
+    void queue_board_page();
+
+    /**
+     * @brief Adds the next page of local boards to the overview, unless there
+     * is already a screen of boards below the visible ones
+     */
+    bool load_board_page();
+
+    /**
+     * @brief Reports the board files changed in folder to the board manager,
+     * along with those of the shard folders created in it
+     */
+    void watch_board_folder(const std::string& folder);
+
+    /**
+     * @brief Fills the agenda view from the due date summaries. Until every
+     * board is indexed the view shows that due dates are still being read
+     */
+    void update_agenda();
+
+    /**
+     * @brief Refreshes the agenda, if shown, once the loading thread has
+     * indexed every queued board
+     */
+    void on_boards_indexed();
+
     /**
      * @brief Loads the appropriate style based on the settings.
      */
@@ -0,0 +1,273 @@
+#define CATCH_CONFIG_MAIN
+
+#include <core/agenda-index.h>
+#include <core/board-manager.h>
+#include <core/file-stamp.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#include "test-dir.h"
+
+namespace fs = std::filesystem;
+namespace cr = std::chrono;
+
+namespace {
+const Date TODAY = cr::year{2024} / cr::March / 10;
+
+Date days_from_today(int n) {
+    return Date{cr::sys_days{TODAY} + cr::days{n}};
+}
+
+/**
+ * @brief Builds a board with a list holding one card per due date. Cards due
+ * before TODAY - 5 are complete
+ */
+std::shared_ptr<Board> make_board(const std::string& name,
+                                  const std::vector<int>& due_days) {
+    auto board = Board::create(name, "rgb(0,0,140)");
+    auto cardlist = CardList::create("To do");
+    auto undated = Card::create("Undated");
+    cardlist->container().append(undated);
+    for (const int days : due_days) {
+        auto card = Card::create(std::format("{} {}", name, days),
+                                 days_from_today(days), days < -5);
+        cardlist->container().append(card);
+    }
+    board->container().append(cardlist);
+    return board;
+}
+
+std::vector<std::string> card_names(const std::vector<AgendaEntry>& entries) {
+    std::vector<std::string> names;
+    for (const AgendaEntry& entry : entries) {
+        names.push_back(entry.card_name);
+    }
+    return names;
+}
+
+void wait_agenda_ready(const BoardManager& manager) {
+    while (!manager.agenda_ready()) {
+        std::this_thread::sleep_for(cr::milliseconds{1});
+    }
+}
+}  // namespace
+
+TEST_CASE("Dated cards are grouped by due date", "[AgendaIndex]") {
+    const std::string dir = test_dir("agenda-index", "queries");
+    AgendaIndex index;
+    index.update(dir + "home.xml", *make_board("Home", {-10, -1, 0, 3, 9}));
+    index.update(dir + "work.xml", *make_board("Work", {-2, 0, 1, 7}));
+    CHECK(index.n_boards() == 2);
+    CHECK(index.n_cards() == 9);
+
+    SECTION("Overdue, today and upcoming cards") {
+        const Agenda agenda = index.agenda(TODAY);
+        CHECK(card_names(agenda.overdue) ==
+              std::vector<std::string>{"Work -2", "Home -1"});
+        CHECK(card_names(agenda.today) ==
+              std::vector<std::string>{"Home 0", "Work 0"});
+        CHECK(card_names(agenda.upcoming) ==
+              std::vector<std::string>{"Work 1", "Home 3", "Work 7"});
+
+        REQUIRE(!agenda.overdue.empty());
+        CHECK(agenda.overdue[0].board_name == "Work");
+        CHECK(agenda.overdue[0].filename == dir + "work.xml");
+        CHECK(agenda.overdue[0].due == days_from_today(-2));
+        CHECK_FALSE(agenda.overdue[0].complete);
+    }
+
+    SECTION("Upcoming cards are limited to the given days") {
+        CHECK(index.agenda(TODAY, 0).upcoming.empty());
+        CHECK(index.agenda(TODAY, 3).upcoming.size() == 2);
+        CHECK(index.agenda(TODAY, 30).upcoming.size() == 4);
+    }
+
+    SECTION("Complete cards are never overdue") {
+        index.update(dir + "home.xml", *make_board("Home", {-10, -6}));
+        CHECK(index.agenda(TODAY).overdue.size() == 1);
+        CHECK(index.agenda(days_from_today(-6)).today.front().complete);
+        CHECK(index.agenda(days_from_today(-6), 7, false).today.empty());
+    }
+
+    SECTION("Updating a board replaces its cards") {
+        index.update(dir + "work.xml", *make_board("Office", {2}));
+        const Agenda agenda = index.agenda(TODAY);
+        CHECK(card_names(agenda.overdue) ==
+              std::vector<std::string>{"Home -1"});
+        CHECK(card_names(agenda.upcoming) ==
+              std::vector<std::string>{"Office 2", "Home 3"});
+        CHECK(agenda.upcoming[0].board_name == "Office");
+    }
+
+    SECTION("Removed boards are forgotten") {
+        index.remove(dir + "work.xml");
+        CHECK(index.agenda(TODAY).today.size() == 1);
+        CHECK_FALSE(index.contains(dir + "work.xml"));
+        CHECK_FALSE(fs::exists(AgendaIndex::agenda_filename(dir + "work.xml")));
+
+        index.remove(dir + "home.xml");
+        CHECK(index.n_cards() == 0);
+    }
+}
+
+TEST_CASE("Due date summaries are stored next to the board", "[AgendaIndex]") {
+    const std::string dir = test_dir("agenda-index", "storage");
+    const std::string filename = dir + "board.xml";
+    std::ofstream{filename} << "<board/>";
+    fs::last_write_time(filename, fs::file_time_type::clock::now() -
+                                      cr::minutes{1});
+
+    AgendaIndex index;
+    auto board = make_board("Multi\tline\\board", {-7, 0});
+    board->container().get_data()[0]->container().get_data()[1]->set_name(
+        "First line\nSecond line");
+    index.update(filename, *board);
+
+    SECTION("Stored summaries are loaded back") {
+        AgendaIndex loaded;
+        REQUIRE(loaded.load(filename));
+        CHECK(loaded.n_cards() == 2);
+
+        const Agenda agenda = loaded.agenda(days_from_today(-7));
+        REQUIRE(agenda.today.size() == 1);
+        CHECK(agenda.today[0].card_name == "First line\nSecond line");
+        CHECK(agenda.today[0].board_name == "Multi\tline\\board");
+        CHECK(agenda.today[0].complete);
+        CHECK(agenda.today[0].card_id ==
+              board->container().get_data()[0]->container().get_data()[1]
+                  ->get_id()
+                  .str());
+    }
+
+    SECTION("Summaries older than the board are not loaded") {
+        fs::last_write_time(filename, fs::file_time_type::clock::now() +
+                                          cr::minutes{1});
+        AgendaIndex loaded;
+        CHECK_FALSE(loaded.load(filename));
+        CHECK_FALSE(loaded.contains(filename));
+    }
+
+    SECTION("Boards rewritten within the same clock tick are noticed") {
+        const auto written = fs::last_write_time(filename);
+        CHECK(index.up_to_date(filename, file_stamp(filename)));
+        std::ofstream{filename} << "<board name=\"Renamed\"/>";
+        fs::last_write_time(filename, written);
+
+        CHECK_FALSE(index.up_to_date(filename, file_stamp(filename)));
+        AgendaIndex loaded;
+        CHECK_FALSE(loaded.load(filename));
+    }
+}
+
+TEST_CASE("The board manager answers agenda queries", "[BoardManager]") {
+    const std::string dir = test_dir("agenda-index", "manager");
+    std::string filename;
+    const Date today = Date{cr::floor<cr::days>(cr::system_clock::now())};
+    {
+        BoardManager manager{dir};
+        wait_agenda_ready(manager);
+        filename = manager.local_add("Holidays", "rgb(0,0,140)");
+        wait_agenda_ready(manager);
+        CHECK(manager.agenda(today).today.empty());
+
+        auto board = manager.local_open(filename);
+        REQUIRE(board);
+        auto cardlist = CardList::create("Packing");
+        auto card = Card::create("Passport", today);
+        cardlist->container().append(card);
+        board->container().append(cardlist);
+        manager.local_save(board);
+        wait_agenda_ready(manager);
+        CHECK(manager.agenda(today).today.size() == 1);
+    }
+
+    SECTION("Boards are not read to answer queries") {
+        BoardManager manager{dir};
+        wait_agenda_ready(manager);
+        const Agenda agenda = manager.agenda(today);
+        REQUIRE(agenda.today.size() == 1);
+        CHECK(agenda.today[0].card_name == "Passport");
+        CHECK(agenda.today[0].filename == filename);
+        CHECK(manager.local_boards().empty());
+    }
+
+    SECTION("Boards modified elsewhere are summarised again") {
+        std::ofstream{filename}
+            << "<board name=\"Trip\" background=\"rgb(0,0,140)\">"
+            << "<list name=\"Tickets\"><card name=\"Train\" due=\""
+            << std::format("{}", today) << "\"/></list></board>";
+        fs::last_write_time(filename, fs::file_time_type::clock::now() +
+                                          cr::minutes{1});
+
+        BoardManager manager{dir};
+        wait_agenda_ready(manager);
+        const Agenda agenda = manager.agenda(today);
+        REQUIRE(agenda.today.size() == 1);
+        CHECK(agenda.today[0].card_name == "Train");
+    }
+
+    SECTION("Boards deleted elsewhere are dropped") {
+        fs::remove(filename);
+        BoardManager manager{dir};
+        wait_agenda_ready(manager);
+        CHECK(manager.agenda(today).today.empty());
+        CHECK_FALSE(fs::exists(AgendaIndex::agenda_filename(filename)));
+    }
+}
+
+TEST_CASE("Agenda of 5,000 boards", "[.][benchmark]") {
+    constexpr size_t N_BOARDS = 5000, N_CARDS = 20;
+    const std::string dir = test_dir("agenda-index", "benchmark");
+
+    AgendaIndex index;
+    auto start = cr::steady_clock::now();
+    for (size_t i = 0; i < N_BOARDS; i++) {
+        auto board = Board::create(std::format("Board {}", i), "rgb(0,0,0)");
+        auto cardlist = CardList::create("List");
+        for (size_t c = 0; c < N_CARDS; c++) {
+            // Cards are spread over a year, most of the past ones done
+            const int days = static_cast<int>((i * N_CARDS + c) % 365) - 300;
+            auto card = Card::create("Card", days_from_today(days),
+                                     days < -10 && c % 10 != 0);
+            cardlist->container().append(card);
+        }
+        board->container().append(cardlist);
+
+        const std::string filename = std::format("{}{}.xml", dir, i);
+        std::ofstream{filename} << "<board/>";
+        fs::last_write_time(filename, fs::file_time_type::clock::now() -
+                                          cr::minutes{1});
+        index.update(filename, *board);
+    }
+    std::cout << std::format(
+        "Summarising {} boards ({} dated cards): {}ms\n", N_BOARDS,
+        index.n_cards(),
+        cr::duration_cast<cr::milliseconds>(cr::steady_clock::now() - start)
+            .count());
+
+    start = cr::steady_clock::now();
+    AgendaIndex loaded;
+    for (size_t i = 0; i < N_BOARDS; i++) {
+        loaded.load(std::format("{}{}.xml", dir, i));
+    }
+    std::cout << std::format(
+        "Loading {} summaries: {}ms\n", loaded.n_boards(),
+        cr::duration_cast<cr::milliseconds>(cr::steady_clock::now() - start)
+            .count());
+
+    start = cr::steady_clock::now();
+    const Agenda agenda = loaded.agenda(TODAY);
+    std::cout << std::format(
+        "Agenda: {} overdue, {} today, {} upcoming in {}us\n",
+        agenda.overdue.size(), agenda.today.size(), agenda.upcoming.size(),
+        cr::duration_cast<cr::microseconds>(cr::steady_clock::now() - start)
+            .count());
+    CHECK(!agenda.upcoming.empty());
+
+    fs::remove_all(dir);
+}
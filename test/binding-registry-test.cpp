@@ -0,0 +1,80 @@
+#define CATCH_CONFIG_MAIN
+
+#include <core/binding-registry.h>
+#include <core/card.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("Binding registry", "[BindingRegistry]") {
+    BindingRegistry<int, Card> registry;
+    auto card1 = Card::create("Card 1");
+    auto card2 = Card::create("Card 2");
+    sigc::signal<void()> signal;
+    int n_calls = 0;
+
+    SECTION("Bound models can be looked up") {
+        registry.bind(1, card1);
+        registry.bind(2, card2);
+
+        CHECK(registry.size() == 2);
+        CHECK(registry.model(1) == card1);
+        CHECK(registry.model(2) == card2);
+        CHECK(registry.model(3) == nullptr);
+        CHECK_FALSE(registry.contains(3));
+    }
+
+    SECTION("Unbinding disconnects the binding's connections") {
+        registry.bind(1, card1);
+        registry.bind(2, card2);
+        registry.add_connection(1, signal.connect([&n_calls]() { n_calls++; }));
+        registry.add_connection(2, signal.connect([&n_calls]() { n_calls++; }));
+        CHECK(registry.n_connections() == 2);
+
+        CHECK(registry.unbind(1));
+        CHECK_FALSE(registry.unbind(1));
+        signal.emit();
+
+        CHECK(n_calls == 1);
+        CHECK(registry.size() == 1);
+        CHECK(registry.n_connections() == 1);
+    }
+
+    SECTION("Unbinding releases the models captured by the slots") {
+        std::weak_ptr<Card> weak_card = card1;
+        registry.bind(1, card1);
+        registry.add_connection(1, signal.connect([card = card1]() {}));
+        card1 = nullptr;
+        CHECK_FALSE(weak_card.expired());
+
+        registry.unbind(1);
+        CHECK(weak_card.expired());
+    }
+
+    SECTION("Rebinding drops the previous connections") {
+        registry.bind(1, card1);
+        registry.add_connection(1, signal.connect([&n_calls]() { n_calls++; }));
+        registry.bind(1, card2);
+        signal.emit();
+
+        CHECK(n_calls == 0);
+        CHECK(registry.model(1) == card2);
+        CHECK(registry.n_connections() == 0);
+    }
+
+    SECTION("Connections for unbound keys are not kept") {
+        registry.add_connection(1, signal.connect([&n_calls]() { n_calls++; }));
+        signal.emit();
+
+        CHECK(n_calls == 0);
+        CHECK(registry.size() == 0);
+    }
+
+    SECTION("Externally disconnected connections are not counted") {
+        registry.bind(1, card1);
+        sigc::connection cnn = signal.connect([]() {});
+        registry.add_connection(1, cnn);
+        cnn.disconnect();
+
+        CHECK(registry.n_connections() == 0);
+    }
+}
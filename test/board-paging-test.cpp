@@ -0,0 +1,228 @@
+#define CATCH_CONFIG_MAIN
+
+#include <core/board-manager.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <thread>
+
+#include "test-dir.h"
+
+namespace fs = std::filesystem;
+namespace cr = std::chrono;
+
+namespace {
+void wait_loaded(const BoardManager& manager) {
+    while (!manager.loaded()) {
+        std::this_thread::sleep_for(cr::milliseconds{1});
+    }
+}
+
+/**
+ * @brief Writes n boards, the first one being the least recently modified
+ *
+ * @return the boards' filenames, in the order they were written
+ */
+std::vector<std::string> generate_boards(const std::string& dir, size_t n) {
+    BoardManager manager{dir};
+    wait_loaded(manager);
+
+    const auto now = fs::file_time_type::clock::now();
+    std::vector<std::string> filenames;
+    for (size_t i = 0; i < n; i++) {
+        const std::string filename =
+            manager.local_add(std::format("Board {}", i), "rgb(0,0,140)");
+        fs::last_write_time(filename, now - cr::minutes{n - i});
+        filenames.push_back(filename);
+    }
+    return filenames;
+}
+
+/**
+ * @brief Resident memory of this process, in KiB, or 0 where it is unknown
+ */
+size_t resident_memory() {
+    std::ifstream status{"/proc/self/status"};
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.starts_with("VmRSS:")) {
+            return std::stoul(line.substr(6));
+        }
+    }
+    return 0;
+}
+}  // namespace
+
+TEST_CASE("New boards are written to shard folders", "[BoardManager]") {
+    const std::string dir = test_dir("board-paging", "shards");
+    BoardManager manager{dir};
+    wait_loaded(manager);
+
+    const fs::path filename = manager.local_add("Board", "rgb(0,0,140)");
+    auto board = manager.local_open(filename.string());
+    REQUIRE(board);
+
+    const std::string id = board->get_id().str();
+    CHECK(fs::exists(filename));
+    CHECK(filename.parent_path().filename() ==
+          id.substr(0, BoardManager::SHARD_PREFIX_LENGTH));
+    CHECK(filename.filename() == id + ".xml");
+}
+
+TEST_CASE("Boards are enumerated page by page", "[BoardManager]") {
+    const std::string dir = test_dir("board-paging", "pages");
+    const std::vector<std::string> filenames = generate_boards(dir, 10);
+
+    BoardManager manager{dir};
+    wait_loaded(manager);
+    CHECK(manager.local_count() == 10);
+    CHECK(manager.local_boards().empty());
+
+    SECTION("Most recently modified boards come first") {
+        std::vector<std::string> enumerated;
+        for (auto page = manager.local_next_page(3); !page.empty();
+             page = manager.local_next_page(3)) {
+            CHECK(page.size() <= 3);
+            for (const LocalBoard& local_board : page) {
+                CHECK_FALSE(local_board.is_open);
+                enumerated.push_back(local_board.filename);
+            }
+        }
+
+        CHECK(enumerated ==
+              std::vector<std::string>(filenames.rbegin(), filenames.rend()));
+        CHECK(manager.local_boards().size() == 10);
+        CHECK(manager.local_count() == 10);
+    }
+
+    SECTION("Only enumerated boards are read") {
+        auto page = manager.local_next_page(4);
+        REQUIRE(page.size() == 4);
+        CHECK(page.front().board->get_name() == "Board 9");
+        CHECK(manager.local_boards().size() == 4);
+    }
+
+    SECTION("Boards can be opened before they are enumerated") {
+        std::vector<std::string> added;
+        manager.signal_add_board().connect([&added](LocalBoard local_board) {
+            added.push_back(local_board.filename);
+        });
+
+        auto board = manager.local_open(filenames.front());
+        REQUIRE(board);
+        CHECK(board->get_name() == "Board 0");
+        CHECK(manager.local_count() == 10);
+
+        // The board is announced once, so it can still be listed
+        CHECK(added == std::vector<std::string>{filenames.front()});
+        manager.local_open(filenames.front());
+        CHECK(added.size() == 1);
+
+        std::set<std::string> enumerated;
+        for (auto page = manager.local_next_page(100); !page.empty();
+             page = manager.local_next_page(100)) {
+            for (const LocalBoard& local_board : page) {
+                enumerated.insert(local_board.filename);
+            }
+        }
+        CHECK(enumerated.size() == 9);
+        CHECK_FALSE(enumerated.contains(filenames.front()));
+    }
+
+    SECTION("Boards opened on another thread are announced beforehand") {
+        std::vector<std::thread::id> announced_on;
+        manager.signal_add_board().connect([&announced_on](LocalBoard) {
+            announced_on.push_back(std::this_thread::get_id());
+        });
+
+        CHECK(manager.local_enumerate(filenames[3]));
+        CHECK_FALSE(manager.local_enumerate(filenames[3]));
+
+        std::shared_ptr<Board> board;
+        std::thread opener{
+            [&]() { board = manager.local_open(filenames[3]); }};
+        opener.join();
+        REQUIRE(board);
+        CHECK(board->get_name() == "Board 3");
+        CHECK(announced_on ==
+              std::vector<std::thread::id>{std::this_thread::get_id()});
+    }
+}
+
+TEST_CASE("Boards from older versions are found", "[BoardManager]") {
+    const std::string dir = test_dir("board-paging", "flat");
+    {
+        std::ofstream flat_board{dir + "flat.xml"};
+        flat_board << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                   << "<board name=\"Flat > Sharded\" "
+                      "background=\"rgb(0,0,140)\">\n"
+                   << "<list name=\"List\"><card name=\"Card\"/></list>\n"
+                   << "</board>\n";
+    }
+    generate_boards(dir, 2);
+
+    BoardManager manager{dir};
+    wait_loaded(manager);
+    REQUIRE(manager.local_count() == 3);
+
+    // Generated boards are given older modification times
+    auto page = manager.local_next_page(3);
+    REQUIRE(page.size() == 3);
+    CHECK(page.front().filename == dir + "flat.xml");
+    CHECK(page.front().board->get_name() == "Flat > Sharded");
+
+    auto board = manager.local_open(dir + "flat.xml");
+    REQUIRE(board);
+    CHECK(board->container().get_data().size() == 1);
+}
+
+TEST_CASE("Enumerating 10,000 boards", "[.][benchmark]") {
+    constexpr size_t N_BOARDS = 10000;
+    constexpr size_t PAGE_SIZE = 60;
+    const std::string dir = test_dir("board-paging", "benchmark");
+
+    auto start = cr::steady_clock::now();
+    generate_boards(dir, N_BOARDS);
+    std::cout << std::format(
+        "Generating {} boards: {}ms\n", N_BOARDS,
+        cr::duration_cast<cr::milliseconds>(cr::steady_clock::now() - start)
+            .count());
+
+    const size_t memory_before = resident_memory();
+    start = cr::steady_clock::now();
+    BoardManager manager{dir};
+    wait_loaded(manager);
+    const auto listed = cr::steady_clock::now();
+    auto page = manager.local_next_page(PAGE_SIZE);
+    const auto first_page = cr::steady_clock::now();
+
+    std::cout << std::format(
+        "Listing {} boards: {}ms\n"
+        "Reading the first page of {} boards: {}ms\n"
+        "Resident memory growth: {} KiB\n",
+        manager.local_count(),
+        cr::duration_cast<cr::milliseconds>(listed - start).count(),
+        page.size(),
+        cr::duration_cast<cr::milliseconds>(first_page - listed).count(),
+        resident_memory() - memory_before);
+
+    CHECK(manager.local_count() == N_BOARDS);
+    CHECK(manager.local_boards().size() == PAGE_SIZE);
+
+    start = cr::steady_clock::now();
+    size_t n_pages = 1;
+    while (!manager.local_next_page(PAGE_SIZE).empty()) {
+        n_pages++;
+    }
+    std::cout << std::format(
+        "Reading the remaining {} pages: {}ms\n", n_pages - 1,
+        cr::duration_cast<cr::milliseconds>(cr::steady_clock::now() - start)
+            .count());
+    CHECK(manager.local_boards().size() == N_BOARDS);
+
+    fs::remove_all(dir);
+}
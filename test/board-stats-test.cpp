@@ -0,0 +1,333 @@
+#define CATCH_CONFIG_MAIN
+
+#include <core/board-manager.h>
+#include <core/board-stats.h>
+
+#include <algorithm>
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <filesystem>
+#include <random>
+#include <thread>
+
+namespace fs = std::filesystem;
+namespace cr = std::chrono;
+
+namespace {
+const Date TODAY = cr::year{2024} / cr::March / 10;
+
+Date days_from_today(int n) {
+    return Date{cr::sys_days{TODAY} + cr::days{n}};
+}
+
+/**
+ * @brief Counts the cards of a list one by one, without any bookkeeping
+ */
+CardStats brute_force(CardList& cardlist, const Date& today) {
+    CardStats stats;
+    for (const auto& card : cardlist.container()) {
+        stats.n_cards++;
+        stats.n_colors[card->get_color()]++;
+
+        const Date due = card->get_due_date();
+        if (due.ok() && card->get_complete()) {
+            stats.n_complete++;
+        } else if (due.ok() && cr::sys_days{due} < cr::sys_days{today}) {
+            stats.n_overdue++;
+        }
+
+        for (const auto& task : card->container()) {
+            stats.n_tasks++;
+            stats.n_tasks_done += task->get_done();
+        }
+    }
+    return stats;
+}
+
+/**
+ * @brief Checks every list's and the board's statistics against a brute-force
+ * recount
+ */
+void check_consistent(const BoardStats& stats, Board& board,
+                      const Date& today) {
+    CardStats total;
+    for (const auto& cardlist : board.container()) {
+        const CardStats expected = brute_force(*cardlist, today);
+        REQUIRE(stats.cardlist(*cardlist) == expected);
+        total += expected;
+    }
+    REQUIRE(stats.board() == total);
+    REQUIRE(BoardStats::recount(board, today) == total);
+}
+
+void wait_loaded(const BoardManager& manager) {
+    while (!manager.agenda_ready()) {
+        std::this_thread::sleep_for(cr::milliseconds{1});
+    }
+}
+}  // namespace
+
+TEST_CASE("Board statistics follow the board", "[BoardStats]") {
+    auto board = Board::create("Board", "rgb(0,0,0)");
+    auto todo = CardList::create("To do");
+    auto done = CardList::create("Done");
+    board->container().append(todo);
+    board->container().append(done);
+
+    auto red = Card::create("Red", RED_COLOR);
+    auto overdue = Card::create("Overdue", days_from_today(-1));
+    auto complete = Card::create("Complete", days_from_today(-5), true);
+    todo->container().append(red);
+    todo->container().append(overdue);
+    done->container().append(complete);
+
+    auto task = Task::create("Task");
+    auto done_task = Task::create("Done task", true);
+    red->container().append(task);
+    red->container().append(done_task);
+
+    BoardStats stats;
+    size_t n_changes = 0;
+    sigc::scoped_connection cnn =
+        stats.signal_changed().connect([&n_changes]() { n_changes++; });
+    stats.track(board, TODAY);
+
+    CHECK(stats.board().n_cards == 3);
+    CHECK(stats.board().n_complete == 1);
+    CHECK(stats.board().n_overdue == 1);
+    CHECK(stats.board().n_tasks == 2);
+    CHECK(stats.board().n_tasks_done == 1);
+    CHECK(stats.board().n_colors ==
+          std::map<Color, size_t>{{NO_COLOR, 2}, {RED_COLOR, 1}});
+    CHECK(stats.cardlist(*todo).n_cards == 2);
+    CHECK(stats.cardlist(*done).n_complete == 1);
+
+    SECTION("Card and task changes are counted") {
+        task->set_done(true);
+        CHECK(stats.board().n_tasks_done == 2);
+        overdue->set_complete(true);
+        CHECK(stats.board().n_overdue == 0);
+        CHECK(stats.cardlist(*todo).n_complete == 1);
+        red->set_color(NO_COLOR);
+        CHECK(stats.board().n_colors ==
+              std::map<Color, size_t>{{NO_COLOR, 3}});
+        red->container().remove(done_task);
+        CHECK(stats.board().n_tasks == 1);
+        CHECK(n_changes == 5);
+        check_consistent(stats, *board, TODAY);
+    }
+
+    SECTION("Cards moved across lists are counted once") {
+        // Appended to the new list first, like a drop on another list
+        done->container().append(red);
+        CHECK(stats.board().n_cards == 3);
+        CHECK(stats.cardlist(*done).n_tasks == 2);
+        todo->container().remove(red);
+        check_consistent(stats, *board, TODAY);
+
+        // Removed from the old list first
+        todo->container().remove(overdue);
+        done->container().append(overdue);
+        check_consistent(stats, *board, TODAY);
+        CHECK(stats.cardlist(*todo).n_cards == 0);
+
+        // Moved at once, with a single signal from each list
+        n_changes = 0;
+        ItemContainer<Card>::move(overdue, done->container(),
+                                  todo->container(), 0);
+        CHECK(n_changes == 1);
+        CHECK(stats.cardlist(*todo).n_overdue == 1);
+        check_consistent(stats, *board, TODAY);
+
+        ItemContainer<Card>::move(complete, done->container(),
+                                  done->container(), 0);
+        CHECK(n_changes == 1);
+    }
+
+    SECTION("Moving to another day only changes overdue cards") {
+        stats.set_today(days_from_today(-3));
+        CHECK(stats.board().n_overdue == 0);
+        stats.set_today(days_from_today(10));
+        CHECK(stats.board().n_overdue == 1);
+        CHECK(stats.board().n_complete == 1);
+    }
+
+    SECTION("Removed lists and untracked boards are forgotten") {
+        board->container().remove(todo);
+        CHECK(stats.board().n_cards == 1);
+        CHECK(stats.cardlist(*todo).n_cards == 0);
+        red->set_color(BLUE_COLOR);
+        CHECK(stats.board().n_colors ==
+              std::map<Color, size_t>{{NO_COLOR, 1}});
+
+        stats.clear();
+        CHECK(stats.board() == CardStats{});
+    }
+}
+
+TEST_CASE("Board statistics match a recount after random edits",
+          "[BoardStats]") {
+    std::mt19937 rng{2024};
+    const auto pick = [&rng](size_t n) {
+        return std::uniform_int_distribution<size_t>{0, n - 1}(rng);
+    };
+    const std::array<Color, 4> colors = {NO_COLOR, RED_COLOR, BLUE_COLOR,
+                                         GREEN_COLOR};
+
+    auto board = Board::create("Board", "rgb(0,0,0)");
+    for (int i = 0; i < 3; i++) {
+        auto cardlist = CardList::create("List");
+        board->container().append(cardlist);
+    }
+
+    BoardStats stats;
+    stats.track(board, TODAY);
+    Date today = TODAY;
+
+    const auto random_card = [&]() -> std::shared_ptr<Card> {
+        auto& cardlists = board->container().get_data();
+        auto& cards = cardlists[pick(cardlists.size())]->container().get_data();
+        return cards.empty() ? nullptr : cards[pick(cards.size())];
+    };
+
+    for (int step = 0; step < 3000; step++) {
+        auto& cardlists = board->container().get_data();
+        auto cardlist = cardlists[pick(cardlists.size())];
+        auto card = random_card();
+
+        switch (pick(10)) {
+            case 0:
+            case 1: {
+                auto new_card = Card::create(
+                    "Card", days_from_today(int(pick(20)) - 10), pick(2),
+                    colors[pick(colors.size())]);
+                cardlist->container().append(new_card);
+                break;
+            }
+            case 2:
+                if (card) {
+                    for (const auto& owner : cardlists) {
+                        owner->container().remove(card);
+                    }
+                }
+                break;
+            case 3:
+                if (card) {
+                    // Cards are either moved at once, or dropped on their new
+                    // list before being taken out of the old one
+                    std::shared_ptr<CardList> from;
+                    for (const auto& owner : cardlists) {
+                        const auto& cards = owner->container().get_data();
+                        if (std::find(cards.begin(), cards.end(), card) !=
+                            cards.end()) {
+                            from = owner;
+                        }
+                    }
+                    if (pick(2) == 0) {
+                        ItemContainer<Card>::move(
+                            card, from->container(), cardlist->container(),
+                            ssize_t(pick(cardlist->container().size() + 1)));
+                    } else if (from != cardlist) {
+                        cardlist->container().append(card);
+                        from->container().remove(card);
+                    }
+                }
+                break;
+            case 4:
+                if (card) card->set_color(colors[pick(colors.size())]);
+                break;
+            case 5:
+                if (card) {
+                    const int days = int(pick(20)) - 10;
+                    card->set_due_date(pick(4) == 0 ? Date{}
+                                                    : days_from_today(days));
+                }
+                break;
+            case 6:
+                if (card) card->set_complete(!card->get_complete());
+                break;
+            case 7:
+                if (card) {
+                    auto task = Task::create("Task", pick(2));
+                    card->container().append(task);
+                }
+                break;
+            case 8:
+                if (card && card->container().size() > 0) {
+                    auto& tasks = card->container().get_data();
+                    auto task = tasks[pick(tasks.size())];
+                    if (pick(3) == 0) {
+                        card->container().remove(task);
+                    } else {
+                        task->set_done(!task->get_done());
+                    }
+                }
+                break;
+            case 9:
+                if (pick(10) == 0) {
+                    today = days_from_today(int(pick(10)) - 5);
+                    stats.set_today(today);
+                } else if (pick(20) == 0 && cardlists.size() > 1) {
+                    board->container().remove(cardlist);
+                } else if (pick(20) == 0) {
+                    auto new_cardlist = CardList::create("List");
+                    board->container().append(new_cardlist);
+                }
+                break;
+        }
+        check_consistent(stats, *board, today);
+    }
+    CHECK(stats.board().n_cards > 0);
+}
+
+TEST_CASE("Board statistics are stored with the board", "[BoardManager]") {
+    fs::path dir = fs::temp_directory_path() / "progress-board-stats-test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    const Date today = Date{cr::floor<cr::days>(cr::system_clock::now())};
+    const Date yesterday = Date{cr::sys_days{today} - cr::days{1}};
+    std::string filename;
+    {
+        BoardManager manager{dir.string() + "/"};
+        wait_loaded(manager);
+        filename = manager.local_add("Garden", "rgb(0,0,140)");
+
+        auto board = manager.local_open(filename);
+        REQUIRE(board);
+        auto cardlist = CardList::create("Plants");
+        auto tomatoes = Card::create("Tomatoes", yesterday, false, RED_COLOR);
+        auto basil = Card::create("Basil", GREEN_COLOR);
+        auto water = Task::create("Water", true);
+        auto prune = Task::create("Prune");
+        basil->container().append(water);
+        basil->container().append(prune);
+        cardlist->container().append(tomatoes);
+        cardlist->container().append(basil);
+        board->container().append(cardlist);
+        manager.local_save(board);
+    }
+
+    BoardManager manager{dir.string() + "/"};
+    wait_loaded(manager);
+    auto page = manager.local_next_page(10);
+    REQUIRE(page.size() == 1);
+
+    const std::optional<CardStats> stats = manager.local_stats(page[0], today);
+    REQUIRE(stats);
+    CHECK(stats->n_cards == 2);
+    CHECK(stats->n_complete == 0);
+    CHECK(stats->n_tasks == 2);
+    CHECK(stats->n_tasks_done == 1);
+    CHECK(stats->n_overdue == 1);
+    CHECK(stats->n_colors ==
+          std::map<Color, size_t>{{RED_COLOR, 1}, {GREEN_COLOR, 1}});
+
+    auto board = manager.local_open(filename);
+    REQUIRE(board);
+    CardStats recounted = BoardStats::recount(*board, today);
+    CHECK(recounted == *stats);
+
+    fs::remove_all(dir);
+}
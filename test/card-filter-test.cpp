@@ -0,0 +1,274 @@
+#define CATCH_CONFIG_MAIN
+
+#include <core/card-filter-index.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <iostream>
+#include <map>
+
+namespace cr = std::chrono;
+
+namespace {
+const Date TODAY = cr::year{2024} / cr::March / 10;
+
+Date days_from_today(int n) {
+    return Date{cr::sys_days{TODAY} + cr::days{n}};
+}
+
+CardFilter single(CardCondition condition) {
+    return CardFilter{{{condition}}};
+}
+
+/**
+ * @brief Records the last visibility reported for every card
+ */
+struct VisibilityLog {
+    VisibilityLog(CardFilterIndex& index) {
+        cnn = index.signal_visibility().connect(
+            [this](std::shared_ptr<Card> card, bool visible) {
+                last[card.get()] = visible;
+                n_changes++;
+            });
+    }
+
+    std::map<Card*, bool> last;
+    size_t n_changes = 0;
+    sigc::scoped_connection cnn;
+};
+}  // namespace
+
+TEST_CASE("Bitsets of different sizes can be combined", "[DynamicBitset]") {
+    DynamicBitset a, b;
+    a.set(3);
+    a.set(130);
+    b.set(3);
+    b.set(64);
+
+    DynamicBitset both = a;
+    both &= b;
+    CHECK(both.count() == 1);
+    CHECK(both.test(3));
+    CHECK_FALSE(both.test(130));
+
+    DynamicBitset any = b;
+    any |= a;
+    CHECK(any.count() == 3);
+
+    std::vector<size_t> bits;
+    any.for_each([&bits](size_t bit) { bits.push_back(bit); });
+    CHECK(bits == std::vector<size_t>{3, 64, 130});
+
+    a.reset(130);
+    a.reset(1000);
+    CHECK(a.count() == 1);
+}
+
+TEST_CASE("Cards are filtered by their attributes", "[CardFilterIndex]") {
+    auto board = Board::create("Board", "rgb(0,0,0)");
+    auto todo = CardList::create("To do");
+    auto done = CardList::create("Done");
+    board->container().append(todo);
+    board->container().append(done);
+
+    auto red = Card::create("Red", RED_COLOR);
+    auto blue = Card::create("Blue", BLUE_COLOR);
+    auto overdue = Card::create("Overdue", days_from_today(-1));
+    auto due_soon = Card::create("Due soon", days_from_today(2));
+    auto complete = Card::create("Complete", days_from_today(-5), true);
+    auto plain = Card::create("Plain");
+    todo->container().append(red);
+    todo->container().append(blue);
+    todo->container().append(overdue);
+    todo->container().append(due_soon);
+    done->container().append(complete);
+    done->container().append(plain);
+
+    red->set_notes("Some notes");
+    auto task = Task::create("Task");
+    auto done_task = Task::create("Done task", true);
+    blue->container().append(task);
+    blue->container().append(done_task);
+    auto other_task = Task::create("Other task");
+    overdue->container().append(other_task);
+
+    CardFilterIndex index;
+    index.track(board, TODAY);
+    VisibilityLog log{index};
+    REQUIRE(index.n_cards() == 6);
+    CHECK(index.n_visible() == 6);
+
+    SECTION("Single conditions") {
+        CHECK(index.count(single({CardAttribute::COLOR, RED_COLOR})) == 1);
+        CHECK(index.count(single({CardAttribute::COLOR, NO_COLOR})) == 4);
+        CHECK(index.count(single({CardAttribute::OVERDUE})) == 1);
+        CHECK(index.count(single({CardAttribute::DUE_SOON})) == 1);
+        CHECK(index.count(single({CardAttribute::COMPLETE})) == 1);
+        CHECK(index.count(single({CardAttribute::NOTES})) == 1);
+        CHECK(index.count(single({CardAttribute::TASKS, NO_COLOR,
+                                  TaskProgress::IN_PROGRESS})) == 1);
+        CHECK(index.count(single({CardAttribute::TASKS, NO_COLOR,
+                                  TaskProgress::NOT_STARTED})) == 1);
+        CHECK(index.count(single({CardAttribute::TASKS, NO_COLOR,
+                                  TaskProgress::NO_TASKS})) == 4);
+    }
+
+    SECTION("Clauses are combined with AND, conditions with OR") {
+        const CardFilter red_or_blue{
+            {{{CardAttribute::COLOR, RED_COLOR},
+              {CardAttribute::COLOR, BLUE_COLOR}}}};
+        CHECK(index.count(red_or_blue) == 2);
+
+        const CardFilter colored_with_notes{
+            {{{CardAttribute::COLOR, RED_COLOR},
+              {CardAttribute::COLOR, BLUE_COLOR}},
+             {{CardAttribute::NOTES}}}};
+        CHECK(index.count(colored_with_notes) == 1);
+        CHECK(index.matches(*red, colored_with_notes));
+        CHECK_FALSE(index.matches(*blue, colored_with_notes));
+    }
+
+    SECTION("Only cards whose visibility flips are reported") {
+        index.set_filter(single({CardAttribute::OVERDUE}));
+        CHECK(log.n_changes == 5);
+        CHECK(index.n_visible() == 1);
+        CHECK(index.visible(*overdue));
+        CHECK_FALSE(index.visible(*red));
+
+        index.set_filter(CardFilter{{{{CardAttribute::OVERDUE},
+                                      {CardAttribute::DUE_SOON}}}});
+        CHECK(log.n_changes == 6);
+        CHECK(log.last[due_soon.get()]);
+
+        index.set_filter(CardFilter{});
+        CHECK(log.n_changes == 10);
+        CHECK(index.n_visible() == 6);
+    }
+
+    SECTION("Attribute changes are followed") {
+        index.set_filter(single({CardAttribute::COLOR, RED_COLOR}));
+        log.n_changes = 0;
+
+        plain->set_color(RED_COLOR);
+        CHECK(log.last[plain.get()]);
+        red->set_color(GREEN_COLOR);
+        CHECK_FALSE(log.last[red.get()]);
+        CHECK(log.n_changes == 2);
+
+        index.set_filter(single({CardAttribute::TASKS, NO_COLOR,
+                                 TaskProgress::DONE}));
+        CHECK_FALSE(index.visible(*blue));
+        task->set_done(true);
+        CHECK(index.visible(*blue));
+        auto new_task = Task::create("New task");
+        blue->container().append(new_task);
+        CHECK_FALSE(index.visible(*blue));
+
+        index.set_filter(single({CardAttribute::COMPLETE}));
+        overdue->set_complete(true);
+        CHECK(index.visible(*overdue));
+        overdue->set_due_date(Date{});
+        CHECK_FALSE(index.visible(*overdue));
+    }
+
+    SECTION("Moving to another day reclassifies due dates") {
+        index.set_filter(single({CardAttribute::OVERDUE}));
+        index.set_today(days_from_today(3));
+        CHECK(index.visible(*due_soon));
+        CHECK(index.count(single({CardAttribute::OVERDUE})) == 2);
+        CHECK(index.count(single({CardAttribute::DUE_SOON})) == 0);
+    }
+
+    SECTION("Added and removed cards are tracked") {
+        index.set_filter(single({CardAttribute::COLOR, BLUE_COLOR}));
+
+        // New cards are shown until the filter is applied again
+        auto new_card = Card::create("New card");
+        done->container().append(new_card);
+        CHECK(index.n_cards() == 7);
+        CHECK(index.visible(*new_card));
+        index.set_filter(index.get_filter());
+        CHECK_FALSE(index.visible(*new_card));
+
+        todo->container().remove(blue);
+        CHECK(index.count(single({CardAttribute::COLOR, BLUE_COLOR})) == 0);
+        blue->set_color(RED_COLOR);
+        CHECK(index.n_cards() == 6);
+
+        board->container().remove(done);
+        CHECK(index.n_cards() == 3);
+        CHECK(index.count(single({CardAttribute::COMPLETE})) == 0);
+    }
+
+    SECTION("Cards moved across cardlists keep their state") {
+        index.set_filter(single({CardAttribute::NOTES}));
+        todo->container().signal_remove().block();
+        todo->container().remove(red);
+        todo->container().signal_remove().unblock();
+        done->container().append(red);
+
+        CHECK(index.n_cards() == 6);
+        CHECK(index.visible(*red));
+        red->set_notes("");
+        CHECK_FALSE(index.visible(*red));
+    }
+}
+
+TEST_CASE("Filtering 10,000 cards", "[.][benchmark]") {
+    constexpr size_t N_LISTS = 20, N_CARDS = 500;
+    const Color colors[] = {RED_COLOR,   ORANGE_COLOR, YELLOW_COLOR,
+                            GREEN_COLOR, BLUE_COLOR,   NO_COLOR};
+
+    auto board = Board::create("Board", "rgb(0,0,0)");
+    for (size_t l = 0; l < N_LISTS; l++) {
+        auto cardlist = CardList::create("List");
+        for (size_t c = 0; c < N_CARDS; c++) {
+            const size_t i = l * N_CARDS + c;
+            auto card = Card::create(
+                "Card", days_from_today(static_cast<int>(i % 20) - 10),
+                i % 7 == 0, colors[i % 6]);
+            if (i % 3 == 0) {
+                card->set_notes("Notes");
+            }
+            for (size_t t = 0; t < i % 4; t++) {
+                auto task = Task::create("Task", t % 2 == 0);
+                card->container().append(task);
+            }
+            cardlist->container().append(card);
+        }
+        board->container().append(cardlist);
+    }
+
+    auto start = cr::steady_clock::now();
+    CardFilterIndex index;
+    index.track(board, TODAY);
+    std::cout << std::format(
+        "Tracking {} cards: {}us\n", index.n_cards(),
+        cr::duration_cast<cr::microseconds>(cr::steady_clock::now() - start)
+            .count());
+
+    size_t n_changes = 0;
+    sigc::scoped_connection cnn = index.signal_visibility().connect(
+        [&n_changes](std::shared_ptr<Card>, bool) { n_changes++; });
+
+    const std::vector<CardFilter> filters = {
+        single({CardAttribute::COLOR, RED_COLOR}),
+        CardFilter{{{{CardAttribute::COLOR, RED_COLOR},
+                     {CardAttribute::COLOR, BLUE_COLOR}},
+                    {{CardAttribute::OVERDUE}, {CardAttribute::DUE_SOON}}}},
+        CardFilter{{{{CardAttribute::NOTES}},
+                    {{CardAttribute::TASKS, NO_COLOR,
+                      TaskProgress::IN_PROGRESS}}}},
+        CardFilter{}};
+
+    start = cr::steady_clock::now();
+    for (const CardFilter& filter : filters) {
+        index.set_filter(filter);
+    }
+    std::cout << std::format(
+        "Applying {} filters: {}us, {} visibility changes\n", filters.size(),
+        cr::duration_cast<cr::microseconds>(cr::steady_clock::now() - start)
+            .count(),
+        n_changes);
+    CHECK(index.n_visible() == N_LISTS * N_CARDS);
+}
@@ -67,6 +67,23 @@ TEST_CASE("ItemContainer: Positional Insertion", "[ItemContainer]") {
         CHECK(container.modified());
     }
 
+    SECTION("Insert at an index") {
+        container.insert(item3, 1);  // Expected: [item1, item3, item2]
+        auto data = container.get_data();
+
+        REQUIRE(container.size() == 3);
+        CHECK(data[1] == item3);
+        CHECK(container.modified());
+    }
+
+    SECTION("Insert past the end appends") {
+        container.insert(item3, 10);
+        auto data = container.get_data();
+
+        REQUIRE(container.size() == 3);
+        CHECK(data[2] == item3);
+    }
+
     SECTION("Insert before/after a non-present sibling") {
         auto foreign_item = Card::create("I am foreign");
         ssize_t bf_size = container.size();
@@ -101,6 +118,20 @@ TEST_CASE("ItemContainer: Signal Emissions", "[ItemContainer]") {
         CHECK(append_fired);
     }
 
+    SECTION("Insert signal carries the insertion index") {
+        auto item2 = Card::create("New Card");
+        auto item3 = Card::create("New Card");
+        ssize_t inserted_at = -1;
+        container.signal_insert().connect(
+            [&](auto, ssize_t index) { inserted_at = index; });
+
+        container.append(item);
+        container.append(item2);
+
+        container.insert_after(item3, item);
+        CHECK(inserted_at == 1);
+    }
+
     SECTION("Remove signal fires") {
         container.append(item);
         container.remove(item);
@@ -140,4 +171,131 @@ TEST_CASE("ItemContainer: Reordering", "[ItemContainer]") {
         auto data = container.get_data();
         CHECK(data[0] == item2);
     }
-}
\ No newline at end of file
+}
+TEST_CASE("ItemContainer: Moving", "[ItemContainer]") {
+    MockContainer from, to;
+    auto item1 = Card::create("New Card 1");
+    auto item2 = Card::create("New Card 2");
+    auto item3 = Card::create("New Card 3");
+    auto item4 = Card::create("New Card 4");
+
+    from.append(item1);
+    from.append(item2);
+    from.append(item3);  // Current: [item1, item2, item3]
+    to.append(item4);    // Current: [item4]
+    from.modify(false);
+    to.modify(false);
+
+    struct Move {
+        Card* card;
+        MockContainer *from, *to;
+        ssize_t from_index, to_index;
+    };
+    std::vector<Move> from_moves, to_moves;
+    size_t n_other_signals = 0;
+    for (auto [container, moves] :
+         {std::pair{&from, &from_moves}, std::pair{&to, &to_moves}}) {
+        container->signal_move().connect(
+            [moves](std::shared_ptr<Card> card, MockContainer* from,
+                    ssize_t from_index, MockContainer* to, ssize_t to_index) {
+                moves->push_back({card.get(), from, to, from_index, to_index});
+            });
+        container->signal_append().connect(
+            [&n_other_signals](std::shared_ptr<Card>) { n_other_signals++; });
+        container->signal_remove().connect(
+            [&n_other_signals](std::shared_ptr<Card>) { n_other_signals++; });
+        container->signal_insert().connect(
+            [&n_other_signals](std::shared_ptr<Card>, ssize_t) {
+                n_other_signals++;
+            });
+    }
+
+    SECTION("Moving to another container keeps the item") {
+        Card* moved = item2.get();
+        REQUIRE(MockContainer::move(item2, from, to, 0));
+
+        CHECK(from.get_data() == std::vector{item1, item3});
+        CHECK(to.get_data() == std::vector{item2, item4});
+        CHECK(to.get_data()[0].get() == moved);
+        CHECK(from.modified());
+        CHECK(to.modified());
+
+        // Each container reports the move once, and nothing else
+        REQUIRE(from_moves.size() == 1);
+        REQUIRE(to_moves.size() == 1);
+        CHECK(n_other_signals == 0);
+        CHECK(to_moves[0].card == moved);
+        CHECK(to_moves[0].from == &from);
+        CHECK(to_moves[0].to == &to);
+        CHECK(to_moves[0].from_index == 1);
+        CHECK(to_moves[0].to_index == 0);
+    }
+
+    SECTION("Positions past the end append the item") {
+        REQUIRE(MockContainer::move(item1, from, to, 10));
+        CHECK(to.get_data() == std::vector{item4, item1});
+        REQUIRE(MockContainer::move(item3, from, to, -1));
+        CHECK(to.get_data() == std::vector{item4, item1, item3});
+        CHECK(to_moves.back().to_index == 2);
+    }
+
+    SECTION("Moving within a container") {
+        REQUIRE(MockContainer::move(item1, from, from, 2));
+        CHECK(from.get_data() == std::vector{item2, item3, item1});
+        REQUIRE(MockContainer::move(item1, from, from, 0));
+        CHECK(from.get_data() == std::vector{item1, item2, item3});
+        CHECK(from_moves.size() == 2);
+        CHECK(from_moves[0].from_index == 0);
+        CHECK(from_moves[0].to_index == 2);
+        CHECK(to_moves.empty());
+        CHECK_FALSE(to.modified());
+
+        // Moving an item to where it already is does nothing
+        from.modify(false);
+        REQUIRE(MockContainer::move(item2, from, from, 1));
+        CHECK(from_moves.size() == 2);
+        CHECK_FALSE(from.modified());
+    }
+
+    SECTION("Items that are not in the source are not moved") {
+        CHECK_FALSE(MockContainer::move(item4, from, to, 0));
+        CHECK(from.size() == 3);
+        CHECK(to.size() == 1);
+        CHECK(from_moves.empty());
+        CHECK_FALSE(from.modified());
+    }
+
+    SECTION("Moving next to a sibling") {
+        REQUIRE(MockContainer::move(item1, from, from, item3,
+                                    ReorderingType::AFTER));
+        CHECK(from.get_data() == std::vector{item2, item3, item1});
+        REQUIRE(MockContainer::move(item1, from, from, item2,
+                                    ReorderingType::BEFORE));
+        CHECK(from.get_data() == std::vector{item1, item2, item3});
+        CHECK(from_moves.size() == 2);
+        CHECK(from_moves[0].to_index == 2);
+        CHECK(from_moves[1].to_index == 0);
+
+        REQUIRE(MockContainer::move(item2, from, to, item4,
+                                    ReorderingType::BEFORE));
+        CHECK(to.get_data() == std::vector{item2, item4});
+        REQUIRE(MockContainer::move(item3, from, to, item4,
+                                    ReorderingType::AFTER));
+        CHECK(to.get_data() == std::vector{item2, item4, item3});
+        CHECK(n_other_signals == 0);
+    }
+
+    SECTION("Missing siblings move nothing") {
+        auto stranger = Card::create("Stranger");
+        CHECK_FALSE(MockContainer::move(item1, from, to, stranger,
+                                        ReorderingType::AFTER));
+        CHECK_FALSE(MockContainer::move(item1, from, from, item4,
+                                        ReorderingType::BEFORE));
+        CHECK_FALSE(MockContainer::move(item1, from, from, item1,
+                                        ReorderingType::AFTER));
+        CHECK(from.get_data() == std::vector{item1, item2, item3});
+        CHECK(to.get_data() == std::vector{item4});
+        CHECK(from_moves.empty());
+        CHECK(to_moves.empty());
+    }
+}
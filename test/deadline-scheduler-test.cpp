@@ -0,0 +1,92 @@
+#define CATCH_CONFIG_MAIN
+
+#include <core/deadline-scheduler.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace std::chrono;
+
+TEST_CASE("Deadline boundaries", "[next_boundary]") {
+    const Date today = 2024y / March / 10;
+
+    SECTION("Upcoming deadline flips the day after") {
+        auto boundary = DeadlineScheduler<int>::next_boundary(
+            2024y / March / 12, false, today);
+        REQUIRE(boundary);
+        CHECK(year_month_day{*boundary} == 2024y / March / 13);
+    }
+
+    SECTION("Deadline due today flips tomorrow") {
+        auto boundary =
+            DeadlineScheduler<int>::next_boundary(today, false, today);
+        REQUIRE(boundary);
+        CHECK(year_month_day{*boundary} == 2024y / March / 11);
+    }
+
+    SECTION("Past deadline never flips again") {
+        CHECK_FALSE(DeadlineScheduler<int>::next_boundary(2024y / March / 9,
+                                                          false, today));
+    }
+
+    SECTION("Complete cards and unset deadlines never flip") {
+        CHECK_FALSE(DeadlineScheduler<int>::next_boundary(2024y / March / 12,
+                                                          true, today));
+        CHECK_FALSE(
+            DeadlineScheduler<int>::next_boundary(Date{}, false, today));
+    }
+}
+
+TEST_CASE("Scheduling deadlines", "[DeadlineScheduler]") {
+    const Date today = 2024y / March / 10;
+    DeadlineScheduler<int> scheduler;
+
+    SECTION("Items are taken in boundary order") {
+        scheduler.schedule(1, 2024y / March / 20, false, today);
+        scheduler.schedule(2, 2024y / March / 11, false, today);
+        scheduler.schedule(3, 2024y / March / 15, false, today);
+
+        REQUIRE(scheduler.next());
+        CHECK(year_month_day{*scheduler.next()} == 2024y / March / 12);
+
+        CHECK(scheduler.take_due(2024y / March / 11).empty());
+        CHECK(scheduler.take_due(2024y / March / 16) == std::vector<int>{2, 3});
+        CHECK(scheduler.size() == 1);
+        CHECK(scheduler.take_due(2024y / April / 1) == std::vector<int>{1});
+        CHECK(scheduler.empty());
+        CHECK_FALSE(scheduler.next());
+    }
+
+    SECTION("Rescheduling replaces the previous boundary") {
+        scheduler.schedule(1, 2024y / March / 11, false, today);
+        scheduler.schedule(1, 2024y / March / 20, false, today);
+
+        CHECK(scheduler.size() == 1);
+        CHECK(scheduler.take_due(2024y / March / 15).empty());
+        CHECK(scheduler.take_due(2024y / March / 21) == std::vector<int>{1});
+    }
+
+    SECTION("Items that can no longer change are unscheduled") {
+        scheduler.schedule(1, 2024y / March / 11, false, today);
+        CHECK_FALSE(scheduler.schedule(1, 2024y / March / 11, true, today));
+        CHECK_FALSE(scheduler.contains(1));
+        CHECK(scheduler.take_due(2024y / March / 15).empty());
+    }
+
+    SECTION("Unscheduled items are never taken") {
+        scheduler.schedule(1, 2024y / March / 11, false, today);
+        scheduler.schedule(2, 2024y / March / 11, false, today);
+        scheduler.unschedule(1);
+
+        CHECK(scheduler.take_due(2024y / March / 12) == std::vector<int>{2});
+    }
+
+    SECTION("Heavy rescheduling keeps a single live entry per item") {
+        for (int i = 0; i < 10000; i++) {
+            scheduler.schedule(i % 10, 2024y / March / 11, false, today);
+        }
+
+        CHECK(scheduler.size() == 10);
+        CHECK(scheduler.take_due(2024y / March / 12).size() == 10);
+        CHECK(scheduler.empty());
+    }
+}
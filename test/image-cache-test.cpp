@@ -0,0 +1,201 @@
+#define CATCH_CONFIG_MAIN
+
+#include <core/image-cache.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+#include "test-dir.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+void write_file(const fs::path& path, size_t size) {
+    std::ofstream file{path, std::ios::binary};
+    file << std::string(size, 'x');
+}
+
+/**
+ * @brief Builds the entry for the key, as a caller would after a miss
+ */
+void build(ImageCache& cache, const std::string& key, size_t size) {
+    write_file(cache.path(key), size);
+    cache.insert(key);
+}
+}  // namespace
+
+TEST_CASE("Keys follow the source image", "[ImageCache]") {
+    const fs::path dir = test_dir("image-cache", "keys");
+    const fs::path source = dir / "source.png";
+    write_file(source, 10);
+
+    const std::string key = ImageCache::make_key(source.string(), "thumb");
+    CHECK_FALSE(key.empty());
+    CHECK(key == ImageCache::make_key(source.string(), "thumb"));
+    CHECK(key != ImageCache::make_key(source.string(), "bg-medium"));
+
+    SECTION("Missing sources have no key") {
+        CHECK(ImageCache::make_key((dir / "missing.png").string(), "thumb")
+                  .empty());
+    }
+
+    SECTION("Modified sources get a new key") {
+        write_file(source, 20);
+        CHECK(key != ImageCache::make_key(source.string(), "thumb"));
+    }
+
+    SECTION("Touched sources get a new key") {
+        fs::last_write_time(source, fs::last_write_time(source) +
+                                        std::chrono::seconds{5});
+        CHECK(key != ImageCache::make_key(source.string(), "thumb"));
+    }
+
+    SECTION("Caches remember the keys they made") {
+        ImageCache cache{(dir / "cache").string(), 1000};
+        CHECK(cache.key(source.string(), "thumb") == key);
+        CHECK(cache.key(source.string(), "bg-medium") ==
+              ImageCache::make_key(source.string(), "bg-medium"));
+
+        // The source is not looked at again right away
+        write_file(source, 20);
+        CHECK(cache.key(source.string(), "thumb") == key);
+        CHECK(cache.key((dir / "missing.png").string(), "thumb").empty());
+    }
+}
+
+TEST_CASE("Looking up and inserting entries", "[ImageCache]") {
+    const fs::path dir = test_dir("image-cache", "lookup");
+    const fs::path source = dir / "source.png";
+    write_file(source, 10);
+    ImageCache cache{(dir / "cache").string(), 1000};
+
+    const std::string key = ImageCache::make_key(source.string(), "thumb");
+    CHECK_FALSE(cache.lookup(key));
+    CHECK(cache.stats().misses == 1);
+
+    build(cache, key, 100);
+    REQUIRE(cache.lookup(key));
+    CHECK(*cache.lookup(key) == cache.path(key));
+
+    ImageCacheStats stats = cache.stats();
+    CHECK(stats.n_entries == 1);
+    CHECK(stats.size == 100);
+    CHECK(stats.hits == 2);
+    CHECK(stats.misses == 1);
+
+    SECTION("Inserting an entry twice does not count it twice") {
+        build(cache, key, 120);
+        CHECK(cache.stats().n_entries == 1);
+        CHECK(cache.stats().size == 120);
+        CHECK(cache.stats().misses == 1);
+    }
+
+    SECTION("A new version of the source replaces the old entry") {
+        write_file(source, 20);
+        const std::string new_key =
+            ImageCache::make_key(source.string(), "thumb");
+        build(cache, new_key, 100);
+
+        CHECK_FALSE(cache.lookup(key));
+        CHECK_FALSE(fs::exists(cache.path(key)));
+        CHECK(cache.lookup(new_key));
+        CHECK(cache.stats().n_entries == 1);
+        CHECK(cache.stats().invalidations == 1);
+    }
+
+    SECTION("Other variants of the source are kept") {
+        const std::string bg_key =
+            ImageCache::make_key(source.string(), "bg-medium");
+        build(cache, bg_key, 100);
+
+        CHECK(cache.lookup(key));
+        CHECK(cache.lookup(bg_key));
+        CHECK(cache.stats().invalidations == 0);
+    }
+}
+
+TEST_CASE("Least recently used entries are evicted", "[ImageCache]") {
+    const fs::path dir = test_dir("image-cache", "eviction");
+    ImageCache cache{(dir / "cache").string(), 300};
+
+    build(cache, "a", 100);
+    build(cache, "b", 100);
+    build(cache, "c", 100);
+    CHECK(cache.stats().evictions == 0);
+
+    // "a" is now more recent than "b"
+    CHECK(cache.lookup("a"));
+    build(cache, "d", 100);
+
+    CHECK_FALSE(cache.lookup("b"));
+    CHECK_FALSE(fs::exists(cache.path("b")));
+    CHECK(cache.lookup("a"));
+    CHECK(cache.lookup("c"));
+    CHECK(cache.lookup("d"));
+    CHECK(cache.stats().evictions == 1);
+    CHECK(cache.stats().size == 300);
+
+    SECTION("Shrinking the cap evicts right away") {
+        cache.set_max_size(150);
+        CHECK(cache.stats().n_entries == 1);
+        CHECK(cache.lookup("d"));
+    }
+
+    SECTION("Referenced entries are not evicted") {
+        ImageCache::Ref a = cache.lookup("a");
+        REQUIRE(a);
+        CHECK(*a == cache.path("a"));
+
+        // "a" is the least recently used entry now
+        CHECK(cache.lookup("c"));
+        CHECK(cache.lookup("d"));
+        build(cache, "e", 100);
+        CHECK(cache.lookup("a"));
+        CHECK_FALSE(cache.lookup("c"));
+
+        a.reset();
+        cache.set_max_size(100);
+        CHECK(cache.stats().n_entries == 1);
+    }
+
+    SECTION("Entries larger than the cap are kept until the next insertion") {
+        build(cache, "e", 1000);
+        CHECK(cache.stats().n_entries == 1);
+        CHECK(cache.lookup("e"));
+
+        build(cache, "f", 10);
+        CHECK_FALSE(cache.lookup("e"));
+        CHECK(cache.lookup("f"));
+    }
+}
+
+TEST_CASE("The index is loaded from the cache directory", "[ImageCache]") {
+    const fs::path dir = test_dir("image-cache", "reload");
+    const fs::path cache_dir = dir / "cache";
+    const auto now = fs::file_time_type::clock::now();
+    {
+        ImageCache cache{cache_dir.string(), 1000};
+        build(cache, "old", 100);
+        build(cache, "new", 100);
+    }
+    fs::last_write_time(cache_dir / "old", now - std::chrono::hours{1});
+    fs::last_write_time(cache_dir / "new", now);
+    write_file(cache_dir / "new.tmp-1234", 100);
+
+    SECTION("Entries are found without being rebuilt") {
+        ImageCache cache{cache_dir.string(), 1000};
+        CHECK(cache.stats().n_entries == 2);
+        CHECK(cache.stats().size == 200);
+        CHECK(cache.lookup("old"));
+        CHECK(cache.lookup("new"));
+    }
+
+    SECTION("Recency is restored from the write times") {
+        ImageCache cache{cache_dir.string(), 150};
+        CHECK_FALSE(cache.lookup("old"));
+        CHECK(cache.lookup("new"));
+        CHECK(cache.stats().evictions == 1);
+    }
+}
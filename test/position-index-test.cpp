@@ -0,0 +1,146 @@
+#define CATCH_CONFIG_MAIN
+
+#include <core/position-index.h>
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+
+TEST_CASE("Indexing items", "[PositionIndex]") {
+    PositionIndex<int> index;
+
+    SECTION("Empty index") {
+        CHECK(index.empty());
+        CHECK(index.index_of(1) == -1);
+        CHECK_FALSE(index.erase(1));
+        CHECK(index.items().empty());
+    }
+
+    SECTION("Appending and inserting items") {
+        index.append(1);
+        index.append(3);
+        index.insert(2, 1);
+        index.insert(0, 0);
+        index.insert(4, 100);
+
+        CHECK(index.size() == 5);
+        CHECK(index.items() == std::vector<int>{0, 1, 2, 3, 4});
+        for (int i = 0; i < 5; i++) {
+            CHECK(index.index_of(i) == i);
+            CHECK(index.at(i) == i);
+        }
+    }
+
+    SECTION("Items are only indexed once") {
+        CHECK(index.append(1));
+        CHECK_FALSE(index.append(1));
+        CHECK_FALSE(index.insert(1, 0));
+        CHECK(index.size() == 1);
+    }
+
+    SECTION("Inserting after a sibling") {
+        index.append(1);
+        index.append(3);
+        CHECK(index.insert_after(2, 1));
+        CHECK_FALSE(index.insert_after(4, 5));
+        CHECK(index.items() == std::vector<int>{1, 2, 3});
+    }
+
+    SECTION("Erasing items") {
+        for (int i = 0; i < 5; i++) {
+            index.append(i);
+        }
+
+        CHECK(index.erase(2));
+        CHECK_FALSE(index.contains(2));
+        CHECK(index.index_of(3) == 2);
+        CHECK(index.items() == std::vector<int>{0, 1, 3, 4});
+
+        index.clear();
+        CHECK(index.empty());
+        CHECK(index.index_of(0) == -1);
+    }
+}
+
+TEST_CASE("Moving items", "[PositionIndex]") {
+    PositionIndex<int> index;
+    for (int i = 0; i < 5; i++) {
+        index.append(i);
+    }
+
+    SECTION("Moving an item down") {
+        CHECK(index.move_after(0, 3));
+        CHECK(index.items() == std::vector<int>{1, 2, 3, 0, 4});
+    }
+
+    SECTION("Moving an item up") {
+        CHECK(index.move_before(4, 1));
+        CHECK(index.items() == std::vector<int>{0, 4, 1, 2, 3});
+    }
+
+    SECTION("Moving to the ends") {
+        CHECK(index.move_before(3, 0));
+        CHECK(index.move_after(1, 4));
+        CHECK(index.items() == std::vector<int>{3, 0, 2, 4, 1});
+    }
+
+    SECTION("Invalid moves leave the order untouched") {
+        CHECK_FALSE(index.move_after(2, 2));
+        CHECK_FALSE(index.move_after(2, 7));
+        CHECK_FALSE(index.move_before(7, 2));
+        CHECK(index.items() == std::vector<int>{0, 1, 2, 3, 4});
+    }
+}
+
+TEST_CASE("Index follows a sequence through random edits", "[PositionIndex]") {
+    PositionIndex<int> index;
+    std::vector<int> sequence;
+    std::mt19937 rng{42};
+    int next_item = 0;
+
+    auto random_item = [&]() {
+        return sequence[std::uniform_int_distribution<size_t>{
+            0, sequence.size() - 1}(rng)];
+    };
+
+    for (int step = 0; step < 5000; step++) {
+        const int op = std::uniform_int_distribution<int>{0, 3}(rng);
+        if (sequence.size() < 2 || op == 0) {
+            const size_t i = std::uniform_int_distribution<size_t>{
+                0, sequence.size()}(rng);
+            index.insert(next_item, i);
+            sequence.insert(sequence.begin() + i, next_item++);
+        } else if (op == 1) {
+            const int item = random_item();
+            index.erase(item);
+            std::erase(sequence, item);
+        } else {
+            const int item = random_item();
+            const int sibling = random_item();
+            if (item == sibling) {
+                continue;
+            }
+
+            std::erase(sequence, item);
+            auto sibling_it = std::find(sequence.begin(), sequence.end(),
+                                        sibling);
+            if (op == 2) {
+                index.move_after(item, sibling);
+                sequence.insert(sibling_it + 1, item);
+            } else {
+                index.move_before(item, sibling);
+                sequence.insert(sibling_it, item);
+            }
+        }
+
+        if (step % 100 == 0) {
+            REQUIRE(index.items() == sequence);
+        }
+    }
+
+    REQUIRE(index.items() == sequence);
+    for (size_t i = 0; i < sequence.size(); i++) {
+        REQUIRE(index.index_of(sequence[i]) == ssize_t(i));
+        REQUIRE(index.at(i) == sequence[i]);
+    }
+}
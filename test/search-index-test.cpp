@@ -0,0 +1,283 @@
+#define CATCH_CONFIG_MAIN
+
+#include <core/board-manager.h>
+#include <core/file-stamp.h>
+#include <core/search-index.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#include "test-dir.h"
+
+namespace fs = std::filesystem;
+namespace cr = std::chrono;
+
+namespace {
+/**
+ * @brief Builds a board with a list holding a card with notes and a task
+ */
+std::shared_ptr<Board> make_board(const std::string& name,
+                                  const std::string& card_name,
+                                  const std::string& notes,
+                                  const std::string& task_name) {
+    auto board = Board::create(name, "rgb(0,0,140)");
+    auto cardlist = CardList::create("To do");
+    auto card = Card::create(card_name);
+    auto task = Task::create(task_name);
+    card->set_notes(notes);
+    card->container().append(task);
+    cardlist->container().append(card);
+    board->container().append(cardlist);
+    return board;
+}
+
+void wait_search_ready(const BoardManager& manager) {
+    while (!manager.search_ready()) {
+        std::this_thread::sleep_for(cr::milliseconds{1});
+    }
+}
+}  // namespace
+
+TEST_CASE("Texts are split into lowercase words", "[SearchIndex]") {
+    CHECK(SearchIndex::tokenize("Buy MILK, eggs & bread!") ==
+          std::vector<std::string>{"buy", "milk", "eggs", "bread"});
+    CHECK(SearchIndex::tokenize("v2.0-beta") ==
+          std::vector<std::string>{"v2", "0", "beta"});
+    CHECK(SearchIndex::tokenize("Café") == std::vector<std::string>{"café"});
+    CHECK(SearchIndex::tokenize(" \t\n").empty());
+}
+
+TEST_CASE("Items are found by the words they contain", "[SearchIndex]") {
+    const std::string dir = test_dir("search-index", "queries");
+    SearchIndex index;
+    index.update(dir + "groceries.xml",
+                 *make_board("Groceries", "Weekly shopping",
+                             "Remember the discount coupons", "Buy milk"));
+    index.update(dir + "work.xml",
+                 *make_board("Work", "Release notes",
+                             "Mention the shopping cart fix", "Tag release"));
+    CHECK(index.n_boards() == 2);
+
+    SECTION("Prefix queries") {
+        auto hits = index.search("shop");
+        REQUIRE(hits.size() == 2);
+        CHECK(hits[0].kind == SearchItemKind::CARD);
+        CHECK(hits[0].text == "Weekly shopping");
+        CHECK(hits[0].board_name == "Groceries");
+        CHECK(hits[0].filename == dir + "groceries.xml");
+        CHECK(hits[1].kind == SearchItemKind::NOTES);
+        CHECK(hits[1].board_name == "Work");
+
+        CHECK(index.search("hopping").empty());
+        CHECK(index.search("MILK").front().kind == SearchItemKind::TASK);
+        CHECK(index.search("gro").front().kind == SearchItemKind::BOARD);
+        CHECK(index.search("to do").size() == 2);
+    }
+
+    SECTION("Substring queries") {
+        CHECK(index.search("hopping", SearchMode::SUBSTRING).size() == 2);
+        CHECK(index.search("count", SearchMode::SUBSTRING).size() == 1);
+        CHECK(index.search("il", SearchMode::SUBSTRING).size() == 1);
+        CHECK(index.search("xyz", SearchMode::SUBSTRING).empty());
+    }
+
+    SECTION("Every query word has to match") {
+        auto hits = index.search("shopping cart");
+        REQUIRE(hits.size() == 1);
+        CHECK(hits[0].text == "Mention the shopping cart fix");
+        CHECK(index.search("shopping milk").empty());
+    }
+
+    SECTION("Hits are capped") {
+        CHECK(index.search("t", SearchMode::PREFIX, 3).size() == 3);
+    }
+
+    SECTION("Updating a board replaces its texts") {
+        index.update(dir + "groceries.xml",
+                     *make_board("Groceries", "Pharmacy", "", "Buy aspirin"));
+        CHECK(index.search("milk").empty());
+        CHECK(index.search("aspirin").size() == 1);
+        CHECK(index.search("shopping").size() == 1);
+        CHECK(index.n_boards() == 2);
+    }
+
+    SECTION("Removed boards are forgotten") {
+        index.remove(dir + "work.xml");
+        CHECK(index.search("release").empty());
+        CHECK_FALSE(index.contains(dir + "work.xml"));
+        CHECK_FALSE(fs::exists(SearchIndex::search_filename(dir + "work.xml")));
+
+        index.remove(dir + "groceries.xml");
+        CHECK(index.n_words() == 0);
+    }
+}
+
+TEST_CASE("Indexed texts are stored next to the board", "[SearchIndex]") {
+    const std::string dir = test_dir("search-index", "storage");
+    const std::string filename = dir + "board.xml";
+    std::ofstream{filename} << "<board/>";
+    fs::last_write_time(filename, fs::file_time_type::clock::now() -
+                                      cr::minutes{1});
+
+    SearchIndex index;
+    index.update(filename, *make_board("Multi\tline\\board", "Card",
+                                       "First line\nSecond line", "Task"));
+
+    SECTION("Stored texts are loaded back") {
+        SearchIndex loaded;
+        REQUIRE(loaded.load(filename));
+        auto hits = loaded.search("second");
+        REQUIRE(hits.size() == 1);
+        CHECK(hits[0].text == "First line\nSecond line");
+        CHECK(hits[0].board_name == "Multi\tline\\board");
+        CHECK(loaded.n_words() == index.n_words());
+    }
+
+    SECTION("Texts older than the board are not loaded") {
+        fs::last_write_time(filename, fs::file_time_type::clock::now() +
+                                          cr::minutes{1});
+        SearchIndex loaded;
+        CHECK_FALSE(loaded.load(filename));
+        CHECK_FALSE(loaded.contains(filename));
+    }
+
+    SECTION("Boards rewritten within the same clock tick are noticed") {
+        const auto written = fs::last_write_time(filename);
+        CHECK(index.up_to_date(filename, file_stamp(filename)));
+        std::ofstream{filename} << "<board name=\"Renamed\"/>";
+        fs::last_write_time(filename, written);
+
+        CHECK_FALSE(index.up_to_date(filename, file_stamp(filename)));
+        SearchIndex loaded;
+        CHECK_FALSE(loaded.load(filename));
+    }
+}
+
+TEST_CASE("The board manager keeps the index up to date", "[BoardManager]") {
+    const std::string dir = test_dir("search-index", "manager");
+    std::string filename;
+    {
+        BoardManager manager{dir};
+        wait_search_ready(manager);
+        filename = manager.local_add("Holidays", "rgb(0,0,140)");
+        wait_search_ready(manager);
+        CHECK(manager.search("holi").size() == 1);
+
+        auto board = manager.local_open(filename);
+        REQUIRE(board);
+        auto cardlist = CardList::create("Packing");
+        board->container().append(cardlist);
+        manager.local_save(board);
+        wait_search_ready(manager);
+        CHECK(manager.search("pack").size() == 1);
+    }
+
+    SECTION("Boards are found again without being read") {
+        BoardManager manager{dir};
+        wait_search_ready(manager);
+        CHECK(manager.search("packing").size() == 1);
+        CHECK(manager.local_boards().empty());
+    }
+
+    SECTION("Boards modified elsewhere are indexed again") {
+        std::ofstream{filename}
+            << "<board name=\"Trip\" background=\"rgb(0,0,140)\">"
+            << "<list name=\"Tickets\"/></board>";
+        fs::last_write_time(filename, fs::file_time_type::clock::now() +
+                                          cr::minutes{1});
+
+        BoardManager manager{dir};
+        wait_search_ready(manager);
+        CHECK(manager.search("packing").empty());
+        CHECK(manager.search("tickets").size() == 1);
+    }
+
+    SECTION("Boards deleted elsewhere are dropped") {
+        fs::remove(filename);
+        BoardManager manager{dir};
+        wait_search_ready(manager);
+        CHECK(manager.search("packing").empty());
+        CHECK_FALSE(fs::exists(SearchIndex::search_filename(filename)));
+    }
+
+    SECTION("Boards reported as changed are indexed again") {
+        BoardManager manager{dir};
+        wait_search_ready(manager);
+        size_t n_indexed = 0;
+        manager.signal_indexed().connect([&n_indexed]() { n_indexed++; });
+
+        std::ofstream{filename}
+            << "<board name=\"Trip\" background=\"rgb(0,0,140)\">"
+            << "<list name=\"Tickets\"/></board>";
+        fs::last_write_time(filename, fs::file_time_type::clock::now() +
+                                          cr::minutes{1});
+        manager.local_changed(filename);
+        wait_search_ready(manager);
+        CHECK(manager.search("packing").empty());
+        CHECK(manager.search("tickets").size() == 1);
+
+        fs::remove(filename);
+        manager.local_changed(filename);
+        wait_search_ready(manager);
+        CHECK(manager.search("tickets").empty());
+        CHECK(n_indexed >= 1);
+    }
+}
+
+TEST_CASE("Searching 5,000 boards", "[.][benchmark]") {
+    constexpr size_t N_BOARDS = 5000;
+    const std::string dir = test_dir("search-index", "benchmark");
+    const std::vector<std::string> words = {
+        "design", "review", "deploy", "invoice", "meeting", "refactor",
+        "budget", "sprint", "backlog", "customer", "release", "testing"};
+
+    SearchIndex index;
+    auto start = cr::steady_clock::now();
+    for (size_t i = 0; i < N_BOARDS; i++) {
+        auto board = Board::create(std::format("Board {}", i), "rgb(0,0,0)");
+        for (size_t l = 0; l < 3; l++) {
+            auto cardlist = CardList::create(words[(i + l) % words.size()]);
+            for (size_t c = 0; c < 5; c++) {
+                auto card = Card::create(std::format(
+                    "{} {} {}", words[(i + c) % words.size()],
+                    words[(i * 7 + c) % words.size()], i * 15 + l * 5 + c));
+                card->set_notes(std::format("Notes about {} for item{}",
+                                            words[(i + l + c) % words.size()],
+                                            i));
+                auto task = Task::create(words[(i * 3 + c) % words.size()]);
+                card->container().append(task);
+                cardlist->container().append(card);
+            }
+            board->container().append(cardlist);
+        }
+        index.update(std::format("{}{}.xml", dir, i), *board);
+    }
+    std::cout << std::format(
+        "Indexing {} boards ({} words): {}ms\n", N_BOARDS, index.n_words(),
+        cr::duration_cast<cr::milliseconds>(cr::steady_clock::now() - start)
+            .count());
+
+    const auto time_query = [&index](const std::string& query,
+                                     SearchMode mode) {
+        const auto query_start = cr::steady_clock::now();
+        const size_t n_hits = index.search(query, mode).size();
+        std::cout << std::format(
+            "\"{}\" ({}): {} hits in {}us\n", query,
+            mode == SearchMode::PREFIX ? "prefix" : "substring", n_hits,
+            cr::duration_cast<cr::microseconds>(cr::steady_clock::now() -
+                                                query_start)
+                .count());
+        return n_hits;
+    };
+    CHECK(time_query("inv", SearchMode::PREFIX) > 0);
+    CHECK(time_query("item4999", SearchMode::PREFIX) > 0);
+    CHECK(time_query("design budget", SearchMode::PREFIX) > 0);
+    CHECK(time_query("actor", SearchMode::SUBSTRING) > 0);
+    CHECK(time_query("em499", SearchMode::SUBSTRING) > 0);
+
+    fs::remove_all(dir);
+}
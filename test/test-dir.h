@@ -0,0 +1,22 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+/**
+ * @brief Returns a fresh, empty directory for a test, ending with a separator.
+ * Every suite has its own directory under the system's temporary one, so
+ * suites running in parallel never share files
+ *
+ * @param suite name of the test suite, e.g. "search-index"
+ * @param name name of the test within its suite
+ */
+inline std::string test_dir(const std::string& suite,
+                            const std::string& name) {
+    namespace fs = std::filesystem;
+    const fs::path dir =
+        fs::temp_directory_path() / ("progress-" + suite + "-test") / name;
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    return dir.string() + "/";
+}